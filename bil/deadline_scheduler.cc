@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bil/deadline_scheduler.hh"
+
+#include <limits>
+
+#include "simplessd/sim/trace.hh"
+
+namespace BIL {
+
+DeadlineScheduler::DeadlineScheduler(Engine &e, DriverInterface *i,
+                                     ConfigReader &c, bool m)
+    : Scheduler(e, i),
+      merge(m),
+      lastDirection(DIR_READ),
+      batchCount(0),
+      starved(0),
+      bioCount(0),
+      requestCount(0),
+      frontMerges(0),
+      backMerges(0),
+      requestMerges(0),
+      expiredCount(0),
+      dispatchedBIOs(0),
+      sumDispatchLatency(0),
+      maxDispatchLatency(0) {
+  queueDepth = c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER_QUEUE_DEPTH);
+  expire[DIR_READ] = c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER_READ_EXPIRE);
+  expire[DIR_WRITE] = c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER_WRITE_EXPIRE);
+  fifoBatch = c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER_FIFO_BATCH);
+  writesStarved = c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER_WRITES_STARVED);
+  maxMergeSize = c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER_MAX_MERGE_SIZE);
+
+  nextOffset[DIR_READ] = std::numeric_limits<uint64_t>::max();
+  nextOffset[DIR_WRITE] = std::numeric_limits<uint64_t>::max();
+
+  callback = [this](uint64_t id) { completion(id); };
+}
+
+DeadlineScheduler::~DeadlineScheduler() {
+  for (uint8_t dir = 0; dir < DIR_NUM; dir++) {
+    for (auto &iter : fifoQueue[dir]) {
+      delete iter;
+    }
+  }
+
+  for (auto &iter : flushQueue) {
+    delete iter;
+  }
+
+  for (auto &iter : dispatched) {
+    delete iter.second;
+  }
+}
+
+void DeadlineScheduler::init() {
+  dispatched.reserve(queueDepth);
+}
+
+DeadlineScheduler::DIRECTION DeadlineScheduler::getDirection(BIO_TYPE type) {
+  // Same as Linux, discard goes to write direction
+  return type == BIO_READ ? DIR_READ : DIR_WRITE;
+}
+
+bool DeadlineScheduler::mergeable(Request *req, BIO_TYPE type,
+                                  uint64_t length) {
+  return req->type == type && req->length + length <= maxMergeSize;
+}
+
+void DeadlineScheduler::insertRequest(Request *req) {
+  DIRECTION dir = getDirection(req->type);
+
+  req->sortIter = sortQueue[dir].emplace(req->offset, req);
+  req->fifoIter = fifoQueue[dir].insert(fifoQueue[dir].end(), req);
+
+  if (merge && req->type != BIO_TRIM) {
+    endIndex[dir].emplace(req->offset + req->length, req);
+  }
+}
+
+void DeadlineScheduler::removeRequest(Request *req) {
+  DIRECTION dir = getDirection(req->type);
+  auto iter = endIndex[dir].find(req->offset + req->length);
+
+  if (iter != endIndex[dir].end() && iter->second == req) {
+    endIndex[dir].erase(iter);
+  }
+
+  sortQueue[dir].erase(req->sortIter);
+  fifoQueue[dir].erase(req->fifoIter);
+}
+
+bool DeadlineScheduler::tryMerge(BIO &bio, DIRECTION dir) {
+  uint64_t tick = engine.getCurrentTick();
+
+  // Back merge - find request ends where this BIO begins
+  auto end = endIndex[dir].find(bio.offset);
+
+  if (end != endIndex[dir].end() &&
+      mergeable(end->second, bio.type, bio.length)) {
+    Request *req = end->second;
+
+    endIndex[dir].erase(end);
+
+    req->length += bio.length;
+    req->members.emplace_back(bio.id, tick);
+
+    endIndex[dir].emplace(req->offset + req->length, req);
+    backMerges++;
+
+    // Request may fill the gap to next request
+    auto next = sortQueue[dir].find(req->offset + req->length);
+
+    if (next != sortQueue[dir].end() && next->second != req &&
+        mergeable(req, next->second->type, next->second->length)) {
+      mergeRequest(req, next->second);
+    }
+
+    return true;
+  }
+
+  // Front merge - find request begins where this BIO ends
+  auto begin = sortQueue[dir].find(bio.offset + bio.length);
+
+  if (begin != sortQueue[dir].end() &&
+      mergeable(begin->second, bio.type, bio.length)) {
+    Request *req = begin->second;
+
+    sortQueue[dir].erase(begin);
+
+    req->offset = bio.offset;
+    req->length += bio.length;
+    req->members.emplace_back(bio.id, tick);
+
+    req->sortIter = sortQueue[dir].emplace(req->offset, req);
+    frontMerges++;
+
+    // Previous request may fill the gap to this request
+    auto prev = endIndex[dir].find(req->offset);
+
+    if (prev != endIndex[dir].end() && prev->second != req &&
+        mergeable(prev->second, req->type, req->length)) {
+      mergeRequest(prev->second, req);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+void DeadlineScheduler::mergeRequest(Request *front, Request *back) {
+  DIRECTION dir = getDirection(front->type);
+
+  // Merged request inherits earlier deadline and FIFO position
+  if (back->expireAt < front->expireAt) {
+    front->expireAt = back->expireAt;
+    fifoQueue[dir].splice(back->fifoIter, fifoQueue[dir], front->fifoIter);
+  }
+
+  removeRequest(back);
+
+  auto iter = endIndex[dir].find(front->offset + front->length);
+
+  if (iter != endIndex[dir].end() && iter->second == front) {
+    endIndex[dir].erase(iter);
+  }
+
+  front->length += back->length;
+  front->members.insert(front->members.end(), back->members.begin(),
+                        back->members.end());
+
+  endIndex[dir].emplace(front->offset + front->length, front);
+  requestMerges++;
+
+  delete back;
+}
+
+DeadlineScheduler::Request *DeadlineScheduler::selectRequest() {
+  Request *req = nullptr;
+  DIRECTION dir = lastDirection;
+
+  if (!flushQueue.empty()) {
+    req = flushQueue.front();
+    flushQueue.pop_front();
+
+    return req;
+  }
+
+  bool reads = !fifoQueue[DIR_READ].empty();
+  bool writes = !fifoQueue[DIR_WRITE].empty();
+
+  if (!reads && !writes) {
+    return nullptr;
+  }
+
+  // Continue current batch in sorted order
+  if (batchCount < fifoBatch) {
+    auto iter = sortQueue[dir].lower_bound(nextOffset[dir]);
+
+    if (iter != sortQueue[dir].end()) {
+      req = iter->second;
+    }
+  }
+
+  // Start new batch
+  if (!req) {
+    if (reads && !(writes && starved++ >= writesStarved)) {
+      dir = DIR_READ;
+    }
+    else {
+      dir = DIR_WRITE;
+      starved = 0;
+    }
+
+    Request *head = fifoQueue[dir].front();
+    auto iter = sortQueue[dir].lower_bound(nextOffset[dir]);
+
+    if (head->expireAt <= engine.getCurrentTick()) {
+      req = head;
+      expiredCount++;
+    }
+    else if (iter == sortQueue[dir].end()) {
+      req = head;
+    }
+    else {
+      req = iter->second;
+    }
+
+    batchCount = 0;
+  }
+
+  lastDirection = dir;
+  batchCount++;
+
+  nextOffset[dir] = req->offset + req->length;
+  nextOffset[dir == DIR_READ ? DIR_WRITE : DIR_READ] =
+      std::numeric_limits<uint64_t>::max();
+
+  removeRequest(req);
+
+  return req;
+}
+
+void DeadlineScheduler::dispatch() {
+  while (dispatched.size() < queueDepth) {
+    Request *req = selectRequest();
+
+    if (!req) {
+      break;
+    }
+
+    uint64_t tick = engine.getCurrentTick();
+    BIO bio;
+
+    for (auto &iter : req->members) {
+      uint64_t latency = tick - iter.submittedAt;
+
+      sumDispatchLatency += latency;
+
+      if (maxDispatchLatency < latency) {
+        maxDispatchLatency = latency;
+      }
+    }
+
+    requestCount++;
+    dispatchedBIOs += req->members.size();
+
+    bio.id = req->members.front().id;
+    bio.type = req->type;
+    bio.offset = req->offset;
+    bio.length = req->length;
+    bio.submittedAt = tick;
+    bio.callback = callback;
+
+    dispatched.emplace(bio.id, req);
+
+    pInterface->submitIO(bio);
+  }
+}
+
+void DeadlineScheduler::completion(uint64_t id) {
+  auto iter = dispatched.find(id);
+
+  if (iter == dispatched.end()) {
+    SimpleSSD::panic("Completion of unknown request %" PRIu64, id);
+  }
+
+  Request *req = iter->second;
+
+  dispatched.erase(iter);
+
+  for (auto &member : req->members) {
+    req->callback(member.id);
+  }
+
+  delete req;
+
+  dispatch();
+}
+
+void DeadlineScheduler::submitIO(BIO &bio) {
+  Request *req = nullptr;
+  uint64_t tick = engine.getCurrentTick();
+
+  bioCount++;
+
+  if (bio.type == BIO_FLUSH) {
+    req = new Request();
+    req->type = bio.type;
+    req->offset = bio.offset;
+    req->length = bio.length;
+    req->expireAt = tick;
+    req->callback = bio.callback;
+    req->members.emplace_back(bio.id, tick);
+
+    flushQueue.push_back(req);
+  }
+  else {
+    DIRECTION dir = getDirection(bio.type);
+
+    if (!(merge && bio.type != BIO_TRIM && tryMerge(bio, dir))) {
+      req = new Request();
+      req->type = bio.type;
+      req->offset = bio.offset;
+      req->length = bio.length;
+      req->expireAt = tick + expire[dir];
+      req->callback = bio.callback;
+      req->members.emplace_back(bio.id, tick);
+
+      insertRequest(req);
+    }
+  }
+
+  dispatch();
+}
+
+void DeadlineScheduler::printStats(std::ostream &out) {
+  out << "*** Statistics of I/O Scheduler ***" << std::endl;
+  out << "Block I/O: " << std::to_string(bioCount)
+      << ", Dispatched requests: " << std::to_string(requestCount)
+      << ", Expired: " << std::to_string(expiredCount) << std::endl;
+
+  if (merge) {
+    double ratio = 0.0;
+
+    if (dispatchedBIOs > 0) {
+      ratio = (double)(dispatchedBIOs - requestCount) / dispatchedBIOs;
+    }
+
+    out << "Merge: front=" << std::to_string(frontMerges)
+        << ", back=" << std::to_string(backMerges)
+        << ", request=" << std::to_string(requestMerges)
+        << ", ratio=" << std::to_string(ratio * 100.0) << "%" << std::endl;
+  }
+
+  if (dispatchedBIOs > 0) {
+    out << "Dispatch latency (ps): avg="
+        << std::to_string((double)sumDispatchLatency / dispatchedBIOs)
+        << ", max=" << std::to_string(maxDispatchLatency) << std::endl;
+  }
+
+  out << "*** End of statistics ***" << std::endl;
+}
+
+}  // namespace BIL
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __BIL_DEADLINE_SCHEDULER__
+#define __BIL_DEADLINE_SCHEDULER__
+
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "bil/scheduler.hh"
+
+namespace BIL {
+
+// Deadline I/O scheduler, modeled after Linux (mq-)deadline
+// Requests are kept in per-direction queues sorted by offset and in
+// per-direction FIFOs with expiration time. Up to queueDepth requests are
+// dispatched to the device at once. When merging is enabled, adjacent
+// requests of same type are coalesced into one device request.
+class DeadlineScheduler : public Scheduler {
+ private:
+  enum DIRECTION : uint8_t {
+    DIR_READ,
+    DIR_WRITE,
+    DIR_NUM,
+  };
+
+  typedef struct _Member {
+    uint64_t id;
+    uint64_t submittedAt;
+
+    _Member(uint64_t i, uint64_t t) : id(i), submittedAt(t) {}
+  } Member;
+
+  typedef struct _Request {
+    BIO_TYPE type;
+    uint64_t offset;
+    uint64_t length;
+    uint64_t expireAt;
+
+    std::function<void(uint64_t)> callback;
+    std::vector<Member> members;
+
+    std::multimap<uint64_t, _Request *>::iterator sortIter;
+    std::list<_Request *>::iterator fifoIter;
+  } Request;
+
+  const bool merge;
+  uint64_t queueDepth;
+  uint64_t expire[DIR_NUM];
+  uint64_t fifoBatch;
+  uint64_t writesStarved;
+  uint64_t maxMergeSize;
+
+  // Per-direction queues
+  std::multimap<uint64_t, Request *> sortQueue[DIR_NUM];
+  std::list<Request *> fifoQueue[DIR_NUM];
+  std::unordered_map<uint64_t, Request *> endIndex[DIR_NUM];
+
+  // Flush requests bypass sorting
+  std::list<Request *> flushQueue;
+
+  // Dispatched requests, indexed by ID of first member
+  std::unordered_map<uint64_t, Request *> dispatched;
+
+  DIRECTION lastDirection;
+  uint64_t nextOffset[DIR_NUM];
+  uint64_t batchCount;
+  uint64_t starved;
+
+  std::function<void(uint64_t)> callback;
+
+  // Statistics
+  uint64_t bioCount;
+  uint64_t requestCount;
+  uint64_t frontMerges;
+  uint64_t backMerges;
+  uint64_t requestMerges;
+  uint64_t expiredCount;
+  uint64_t dispatchedBIOs;
+  uint64_t sumDispatchLatency;
+  uint64_t maxDispatchLatency;
+
+  DIRECTION getDirection(BIO_TYPE);
+  bool mergeable(Request *, BIO_TYPE, uint64_t);
+
+  void insertRequest(Request *);
+  void removeRequest(Request *);
+  bool tryMerge(BIO &, DIRECTION);
+  void mergeRequest(Request *, Request *);
+
+  Request *selectRequest();
+  void dispatch();
+  void completion(uint64_t);
+
+ public:
+  DeadlineScheduler(Engine &, DriverInterface *, ConfigReader &, bool);
+  ~DeadlineScheduler();
+
+  void init() override;
+  void submitIO(BIO &) override;
+
+  void printStats(std::ostream &) override;
+};
+
+}  // namespace BIL
+
+#endif
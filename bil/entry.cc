@@ -21,17 +21,28 @@
 
 #include <cmath>
 
+#include "bil/deadline_scheduler.hh"
 #include "bil/interface.hh"
+#include "bil/latency_log.hh"
 #include "bil/noop_scheduler.hh"
 #include "simplessd/sim/trace.hh"
 
 namespace BIL {
 
+const char *typeName[BIO_NUM] = {"read", "write", "flush", "trim"};
+
+const uint32_t percentileCount = 5;
+const double percentileList[percentileCount] = {50.0, 90.0, 99.0, 99.9,
+                                                99.99};
+const char *percentileName[percentileCount] = {"p50", "p90", "p99", "p99.9",
+                                               "p99.99"};
+
 BlockIOEntry::BlockIOEntry(ConfigReader &c, Engine &e, DriverInterface *i,
-                           std::ostream *o)
+                           std::ostream *o, std::ostream *h)
     : conf(c),
       engine(e),
-      pLatencyFile(o),
+      pLatencyLog(nullptr),
+      pHistogramFile(h),
       pScheduler(nullptr),
       pDriver(i),
       lastProgress(0),
@@ -40,12 +51,20 @@ BlockIOEntry::BlockIOEntry(ConfigReader &c, Engine &e, DriverInterface *i,
       minLatency(std::numeric_limits<uint64_t>::max()),
       maxLatency(0),
       sumLatency(0),
-      squareSumLatency(0),
+      squareSumLatency(0.0),
       callback([this](uint64_t id) { completion(id); }) {
   switch (c.readUint(CONFIG_GLOBAL, GLOBAL_SCHEDULER)) {
     case SCHEDULER_NOOP:
       pScheduler = new NoopScheduler(e, i);
 
+      break;
+    case SCHEDULER_DEADLINE:
+      pScheduler = new DeadlineScheduler(e, i, c, false);
+
+      break;
+    case SCHEDULER_MQ_DEADLINE:
+      pScheduler = new DeadlineScheduler(e, i, c, true);
+
       break;
     default:
       SimpleSSD::panic("Invalid I/O scheduler specified");
@@ -54,55 +73,122 @@ BlockIOEntry::BlockIOEntry(ConfigReader &c, Engine &e, DriverInterface *i,
   }
 
   pScheduler->init();
+
+  if (o) {
+    pLatencyLog = new LatencyLog(
+        *o, (LATENCY_LOG_FORMAT)c.readUint(CONFIG_GLOBAL,
+                                           GLOBAL_LATENCY_LOG_FORMAT));
+  }
+
+  ioSlot.resize(1024);
+  ioMask = ioSlot.size() - 1;
 }
 
 BlockIOEntry::~BlockIOEntry() {
+  delete pLatencyLog;
   delete pScheduler;
 }
 
+void BlockIOEntry::growSlot() {
+  std::vector<BIO> old;
+  bool collision = true;
+
+  old.swap(ioSlot);
+
+  // Double until all in-flight BIOs fall in different slots
+  for (uint64_t size = old.size() * 2; collision; size *= 2) {
+    ioSlot.clear();
+    ioSlot.resize(size);
+    ioMask = size - 1;
+    collision = false;
+
+    for (auto &iter : old) {
+      if (!iter.callback) {
+        continue;
+      }
+
+      BIO &slot = ioSlot[iter.id & ioMask];
+
+      if (slot.callback) {
+        collision = true;
+
+        break;
+      }
+
+      slot = iter;
+    }
+  }
+}
+
 void BlockIOEntry::submitIO(BIO &bio) {
-  BIO copy(bio);
+  BIO request;
 
   io_count++;
   bio.submittedAt = engine.getCurrentTick();
 
-  ioQueue.push_back(bio);
-  copy.callback = callback;
+  if (bio.type >= BIO_NUM) {
+    SimpleSSD::panic("I/O %" PRIu64 " has invalid type %u", bio.id,
+                     (uint32_t)bio.type);
+  }
+
+  if (!bio.callback) {
+    SimpleSSD::panic("I/O %" PRIu64 " has no completion callback", bio.id);
+  }
 
-  pScheduler->submitIO(copy);
+  while (ioSlot[bio.id & ioMask].callback) {
+    if (ioSlot[bio.id & ioMask].id == bio.id) {
+      SimpleSSD::panic("I/O %" PRIu64 " is already in flight", bio.id);
+    }
+
+    growSlot();
+  }
+
+  ioSlot[bio.id & ioMask] = bio;
+
+  // Lower layers only see our completion callback, which fits in the small
+  // buffer of std::function
+  request.id = bio.id;
+  request.type = bio.type;
+  request.offset = bio.offset;
+  request.length = bio.length;
+  request.submittedAt = bio.submittedAt;
+  request.callback = callback;
+
+  pScheduler->submitIO(request);
 }
 
 void BlockIOEntry::completion(uint64_t id) {
   uint64_t tick = engine.getCurrentTick();
+  BIO &bio = ioSlot[id & ioMask];
 
-  for (auto iter = ioQueue.begin(); iter != ioQueue.end(); iter++) {
-    if (iter->id == id) {
-      tick = tick - iter->submittedAt;
+  if (!bio.callback || bio.id != id) {
+    SimpleSSD::panic("Completion of unknown I/O %" PRIu64, id);
+  }
 
-      {
-        std::lock_guard<std::mutex> guard(m);
+  tick = tick - bio.submittedAt;
 
-        io_progress++;
+  {
+    std::lock_guard<std::mutex> guard(m);
 
-        progress.latency += tick;
-        progress.iops++;
-        progress.bandwidth += iter->length;
-      }
+    io_progress++;
 
-      if (pLatencyFile) {
-        *pLatencyFile << std::to_string(iter->id) << ", "
-                      << std::to_string(iter->offset) << ", "
-                      << std::to_string(iter->length) << ", "
-                      << std::to_string(tick) << std::endl;
-      }
+    progress.latency += tick;
+    progress.iops++;
+    progress.bandwidth += bio.length;
+  }
+
+  if (pLatencyLog) {
+    pLatencyLog->write(bio, tick);
+  }
 
-      iter->callback(id);
+  periodHistogram[bio.type].record(tick);
 
-      ioQueue.erase(iter);
+  // Release slot before calling back, as callback may submit new I/O
+  auto func = std::move(bio.callback);
 
-      break;
-    }
-  }
+  bio.callback = nullptr;
+
+  func(id);
 
   if (minLatency > tick) {
     minLatency = tick;
@@ -112,44 +198,132 @@ void BlockIOEntry::completion(uint64_t id) {
   }
 
   sumLatency += tick;
-  squareSumLatency += tick * tick;
+  squareSumLatency += (double)tick * tick;
+}
+
+void BlockIOEntry::flushHistogram() {
+  for (uint8_t type = 0; type < BIO_NUM; type++) {
+    totalHistogram[type].merge(periodHistogram[type]);
+    periodHistogram[type].reset();
+  }
+}
+
+void BlockIOEntry::initStats(std::vector<SimpleSSD::Stats> &list) {
+  SimpleSSD::Stats temp;
+
+  for (uint8_t type = 0; type < BIO_NUM; type++) {
+    std::string prefix = std::string("bil.") + typeName[type] + ".";
+
+    temp.name = prefix + "count";
+    temp.desc = std::string("Number of ") + typeName[type] +
+                " I/O completed in period";
+    list.push_back(temp);
+
+    temp.name = prefix + "latency.avg";
+    temp.desc = std::string("Average ") + typeName[type] + " latency (ps)";
+    list.push_back(temp);
+
+    for (uint32_t i = 0; i < percentileCount; i++) {
+      temp.name = prefix + "latency." + percentileName[i];
+      temp.desc = std::string(percentileName[i]) + " " + typeName[type] +
+                  " latency (ps)";
+      list.push_back(temp);
+    }
+
+    temp.name = prefix + "latency.max";
+    temp.desc = std::string("Maximum ") + typeName[type] + " latency (ps)";
+    list.push_back(temp);
+  }
+}
+
+void BlockIOEntry::getStats(std::vector<double> &values) {
+  for (uint8_t type = 0; type < BIO_NUM; type++) {
+    Histogram &hist = periodHistogram[type];
+
+    values.push_back(hist.getCount());
+    values.push_back(hist.getMean());
+
+    for (uint32_t i = 0; i < percentileCount; i++) {
+      values.push_back(hist.getPercentile(percentileList[i]));
+    }
+
+    values.push_back(hist.getMax());
+  }
+
+  flushHistogram();
 }
 
 void BlockIOEntry::printStats(std::ostream &out) {
   double avgLatency = (double)sumLatency / io_count;
-  double stdevLatency = sqrt((double)squareSumLatency / io_count - avgLatency);
+  double variance = squareSumLatency / io_count - avgLatency * avgLatency;
+  double stdevLatency = variance > 0.0 ? sqrt(variance) : 0.0;
   double digit = log10(avgLatency);
-
-  out << "*** Statistics of Block I/O Entry ***" << std::endl;
+  double divisor;
+  const char *unit;
 
   if (digit < 6.0) {
-    out << "Latency (ps): min=" << std::to_string(minLatency)
-        << ", max=" << std::to_string(maxLatency)
-        << ", avg=" << std::to_string(avgLatency)
-        << ", stdev=" << std::to_string(stdevLatency) << std::endl;
+    divisor = 1.0;
+    unit = "ps";
   }
   else if (digit < 9.0) {
-    out << "Latency (ns): min=" << std::to_string(minLatency / 1000.0)
-        << ", max=" << std::to_string(maxLatency / 1000.0)
-        << ", avg=" << std::to_string(avgLatency / 1000.0)
-        << ", stdev=" << std::to_string(stdevLatency / 31.62277660168)
-        << std::endl;
+    divisor = 1000.0;
+    unit = "ns";
   }
   else if (digit < 12.0) {
-    out << "Latency (us): min=" << std::to_string(minLatency / 1000000.0)
-        << ", max=" << std::to_string(maxLatency / 1000000.0)
-        << ", avg=" << std::to_string(avgLatency / 1000000.0)
-        << ", stdev=" << std::to_string(stdevLatency / 1000.0) << std::endl;
+    divisor = 1000000.0;
+    unit = "us";
   }
   else {
-    out << "Latency (ms): min=" << std::to_string(minLatency / 1000000000.0)
-        << ", max=" << std::to_string(maxLatency / 1000000000.0)
-        << ", avg=" << std::to_string(avgLatency / 1000000000.0)
-        << ", stdev=" << std::to_string(stdevLatency / 31622.77660168379)
-        << std::endl;
+    divisor = 1000000000.0;
+    unit = "ms";
+  }
+
+  flushHistogram();
+
+  out << "*** Statistics of Block I/O Entry ***" << std::endl;
+
+  out << "Latency (" << unit << "): min=" << std::to_string(minLatency / divisor)
+      << ", max=" << std::to_string(maxLatency / divisor)
+      << ", avg=" << std::to_string(avgLatency / divisor)
+      << ", stdev=" << std::to_string(stdevLatency / divisor) << std::endl;
+
+  for (uint8_t type = 0; type < BIO_NUM; type++) {
+    Histogram &hist = totalHistogram[type];
+
+    if (hist.getCount() == 0) {
+      continue;
+    }
+
+    out << " " << typeName[type] << " (" << unit
+        << "): count=" << std::to_string(hist.getCount());
+
+    for (uint32_t i = 0; i < percentileCount; i++) {
+      out << ", " << percentileName[i] << "="
+          << std::to_string(hist.getPercentile(percentileList[i]) / divisor);
+    }
+
+    out << ", max=" << std::to_string(hist.getMax() / divisor) << std::endl;
   }
 
   out << "*** End of statistics ***" << std::endl;
+
+  if (pHistogramFile) {
+    std::vector<std::string> names;
+    std::vector<const Histogram *> list;
+
+    for (uint8_t type = 0; type < BIO_NUM; type++) {
+      names.push_back(typeName[type]);
+      list.push_back(&totalHistogram[type]);
+    }
+
+    if (!saveHistograms(*pHistogramFile, names, list)) {
+      SimpleSSD::warn("Failed to write latency histogram");
+    }
+
+    pHistogramFile->flush();
+  }
+
+  pScheduler->printStats(out);
 }
 
 void BlockIOEntry::getProgress(Progress &data) {
@@ -25,15 +25,18 @@
 #include <cinttypes>
 #include <fstream>
 #include <functional>
-#include <list>
+#include <vector>
 
 #include "sim/cfg_reader.hh"
 #include "sim/engine.hh"
+#include "simplessd/sim/statistics.hh"
+#include "util/histogram.hh"
 
 namespace BIL {
 
 class Scheduler;
 class DriverInterface;
+class LatencyLog;
 
 enum BIO_TYPE : uint8_t {
   BIO_READ,
@@ -70,9 +73,18 @@ class BlockIOEntry {
  private:
   ConfigReader &conf;
   Engine &engine;
-  std::list<BIO> ioQueue;
 
-  std::ostream *pLatencyFile;
+  // In-flight I/O ring, indexed by (BIO ID & ioMask)
+  // I/O generators assign BIO IDs in order, so in-flight BIOs fall in
+  // different slots unless queue is deeper than ring. Slot is free when its
+  // callback is empty.
+  std::vector<BIO> ioSlot;
+  uint64_t ioMask;
+
+  void growSlot();
+
+  LatencyLog *pLatencyLog;
+  std::ostream *pHistogramFile;
 
   Scheduler *pScheduler;
   DriverInterface *pDriver;
@@ -87,17 +99,29 @@ class BlockIOEntry {
   uint64_t minLatency;
   uint64_t maxLatency;
   uint64_t sumLatency;
-  uint64_t squareSumLatency;
+  double squareSumLatency;
+
+  // Latency histograms per BIO type
+  // Completions are recorded in period histogram, which is merged into total
+  // histogram at every periodic log printout
+  Histogram periodHistogram[BIO_NUM];
+  Histogram totalHistogram[BIO_NUM];
+
+  void flushHistogram();
 
   std::function<void(uint64_t)> callback;
   void completion(uint64_t);
 
  public:
-  BlockIOEntry(ConfigReader &, Engine &, DriverInterface *, std::ostream *);
+  BlockIOEntry(ConfigReader &, Engine &, DriverInterface *, std::ostream *,
+               std::ostream *);
   ~BlockIOEntry();
 
   void submitIO(BIO &);
 
+  void initStats(std::vector<SimpleSSD::Stats> &);
+  void getStats(std::vector<double> &);
+
   void printStats(std::ostream &);
   void getProgress(Progress &);
 };
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bil/latency_log.hh"
+
+#include <cstring>
+#include <string>
+
+#include "simplessd/sim/trace.hh"
+
+namespace BIL {
+
+LatencyLog::LatencyLog(std::ostream &o, LATENCY_LOG_FORMAT f)
+    : out(o), format(f) {
+  buffer.reserve(LATENCY_LOG_BATCH);
+
+  if (format == LATENCY_LOG_BINARY) {
+    LatencyLogHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LATENCY_LOG_MAGIC, sizeof(header.magic));
+    header.version = LATENCY_LOG_VERSION;
+    header.recordSize = sizeof(LatencyLogRecord);
+
+    out.write((const char *)&header, sizeof(header));
+  }
+}
+
+LatencyLog::~LatencyLog() {
+  flush();
+}
+
+void LatencyLog::flush() {
+  if (buffer.size() == 0) {
+    return;
+  }
+
+  if (format == LATENCY_LOG_BINARY) {
+    out.write((const char *)buffer.data(),
+              buffer.size() * sizeof(LatencyLogRecord));
+  }
+  else {
+    std::string text;
+
+    // Same format as before: id, offset, length, latency
+    text.reserve(buffer.size() * 48);
+
+    for (auto &iter : buffer) {
+      text += std::to_string(iter.id);
+      text += ", ";
+      text += std::to_string(iter.offset);
+      text += ", ";
+      text += std::to_string(iter.length);
+      text += ", ";
+      text += std::to_string(iter.latency);
+      text += '\n';
+    }
+
+    out.write(text.data(), text.length());
+  }
+
+  out.flush();
+
+  if (!out.good()) {
+    SimpleSSD::warn("Failed to write latency log");
+  }
+
+  buffer.clear();
+}
+
+}  // namespace BIL
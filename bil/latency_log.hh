@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __BIL_LATENCY_LOG__
+#define __BIL_LATENCY_LOG__
+
+#include <cinttypes>
+#include <ostream>
+#include <vector>
+
+#include "bil/entry.hh"
+
+#define LATENCY_LOG_MAGIC "SSDLATLG"
+#define LATENCY_LOG_VERSION 1
+
+// Number of records buffered before write
+#define LATENCY_LOG_BATCH 65536
+
+namespace BIL {
+
+// Binary latency log file layout
+// Header is followed by fixed-size records in completion order
+typedef struct _LatencyLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+} LatencyLogHeader;
+
+typedef struct _LatencyLogRecord {
+  uint64_t id;
+  uint64_t offset;
+  uint64_t length;
+  uint64_t submittedAt;
+  uint64_t latency;
+  uint8_t type;
+  uint8_t reserved[7];
+} LatencyLogRecord;
+
+class LatencyLog {
+ private:
+  std::ostream &out;
+  LATENCY_LOG_FORMAT format;
+
+  std::vector<LatencyLogRecord> buffer;
+
+ public:
+  LatencyLog(std::ostream &, LATENCY_LOG_FORMAT);
+  ~LatencyLog();
+
+  inline void write(BIO &bio, uint64_t latency) {
+    LatencyLogRecord record;
+
+    record.id = bio.id;
+    record.offset = bio.offset;
+    record.length = bio.length;
+    record.submittedAt = bio.submittedAt;
+    record.latency = latency;
+    record.type = (uint8_t)bio.type;
+
+    buffer.push_back(record);
+
+    if (buffer.size() == LATENCY_LOG_BATCH) {
+      flush();
+    }
+  }
+
+  void flush();
+};
+
+}  // namespace BIL
+
+#endif
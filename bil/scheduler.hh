@@ -37,6 +37,8 @@ class Scheduler {
 
   virtual void init() = 0;
   virtual void submitIO(BIO &) = 0;
+
+  virtual void printStats(std::ostream &) {}
 };
 
 }  // namespace BIL
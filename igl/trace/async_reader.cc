@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "igl/trace/async_reader.hh"
+
+#include <chrono>
+
+#include "simplessd/sim/trace.hh"
+#include "simplessd/util/algorithm.hh"
+
+namespace IGL {
+
+AsyncTraceReader::AsyncTraceReader(TraceReader *p, uint64_t depth)
+    : TraceReader(),
+      pReader(p),
+      pContext(SimpleSSD::getContext()),
+      head(0),
+      tail(0),
+      done(false),
+      stop(false),
+      consumerStall(0),
+      producerStall(0) {
+  if (SimpleSSD::popcount(depth) != 1) {
+    SimpleSSD::panic("Read-ahead depth should be power of 2");
+  }
+
+  ring.resize(depth);
+  mask = depth - 1;
+
+  producer = std::thread([this]() { produce(); });
+}
+
+AsyncTraceReader::~AsyncTraceReader() {
+  join();
+
+  delete pReader;
+}
+
+void AsyncTraceReader::produce() {
+  uint64_t current = tail.load(std::memory_order_relaxed);
+
+  SimpleSSD::setContext(pContext);
+
+  while (!stop.load(std::memory_order_relaxed)) {
+    // Wait for free slot
+    if (current - head.load(std::memory_order_acquire) == ring.size()) {
+      producerStall.fetch_add(1, std::memory_order_relaxed);
+
+      while (current - head.load(std::memory_order_acquire) == ring.size()) {
+        if (stop.load(std::memory_order_relaxed)) {
+          return;
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+
+    if (!pReader->read(ring[current & mask])) {
+      break;
+    }
+
+    tail.store(++current, std::memory_order_release);
+  }
+
+  done.store(true, std::memory_order_release);
+}
+
+void AsyncTraceReader::join() {
+  if (producer.joinable()) {
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+    done.store(true, std::memory_order_release);
+  }
+}
+
+bool AsyncTraceReader::read(TraceRecord &record) {
+  uint64_t current = head.load(std::memory_order_relaxed);
+
+  if (current == tail.load(std::memory_order_acquire)) {
+    // Producer is behind simulation
+    consumerStall++;
+
+    while (current == tail.load(std::memory_order_acquire)) {
+      if (done.load(std::memory_order_acquire)) {
+        // Check again, producer may push last record before done is set
+        if (current == tail.load(std::memory_order_acquire)) {
+          return false;
+        }
+
+        break;
+      }
+
+      std::this_thread::yield();
+    }
+  }
+
+  record = ring[current & mask];
+
+  head.store(current + 1, std::memory_order_release);
+
+  return true;
+}
+
+uint32_t AsyncTraceReader::getLBASize() {
+  return pReader->getLBASize();
+}
+
+float AsyncTraceReader::getProgress() {
+  return pReader->getProgress();
+}
+
+void AsyncTraceReader::printStats(std::ostream &out) {
+  // Underlying reader is not thread-safe
+  join();
+
+  pReader->printStats(out);
+
+  out << "Read-ahead depth: " << ring.size()
+      << " (Buffered: " << tail.load() - head.load()
+      << ", Consumer stall: " << consumerStall
+      << ", Producer stall: " << producerStall.load() << ")" << std::endl;
+}
+
+}  // namespace IGL
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __IGL_ASYNC_READER__
+#define __IGL_ASYNC_READER__
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "igl/trace/trace_reader.hh"
+#include "simplessd/sim/context.hh"
+
+namespace IGL {
+
+/**
+ * Read-ahead wrapper of TraceReader
+ *
+ * Producer thread reads and decodes records from underlying reader into
+ * single-producer/single-consumer ring, so trace file I/O and parsing overlap
+ * with simulation. Simulation thread only pops decoded records.
+ */
+class AsyncTraceReader : public TraceReader {
+ private:
+  TraceReader *pReader;
+
+  // Context of creating simulation, bound to producer thread so panic and
+  // warn from underlying reader reach simulation log
+  SimpleSSD::SimulationContext *pContext;
+
+  std::vector<TraceRecord> ring;
+  uint64_t mask;
+
+  // head is written by consumer, tail is written by producer
+  // Keep them in different cache lines
+  std::atomic<uint64_t> head;
+  uint8_t padding[56];
+  std::atomic<uint64_t> tail;
+  std::atomic<bool> done;
+  std::atomic<bool> stop;
+
+  std::thread producer;
+
+  // Statistics
+  uint64_t consumerStall;
+  std::atomic<uint64_t> producerStall;
+
+  void produce();
+  void join();
+
+ public:
+  AsyncTraceReader(TraceReader *, uint64_t);
+  ~AsyncTraceReader();
+
+  bool read(TraceRecord &) override;
+  uint32_t getLBASize() override;
+  float getProgress() override;
+  void printStats(std::ostream &) override;
+};
+
+}  // namespace IGL
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "igl/trace/binary_reader.hh"
+
+#include <cstring>
+#include <fstream>
+
+#include "simplessd/sim/trace.hh"
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace IGL {
+
+BinaryTraceReader::BinaryTraceReader(std::string filename)
+    : TraceReader(),
+      fd(-1),
+      pMapped(nullptr),
+      mappedSize(0),
+      pRecords(nullptr),
+      count(0),
+      lbaSize(0),
+      index(0) {
+#ifdef _MSC_VER
+  SimpleSSD::panic("Pre-compiled trace is not supported on this platform");
+#else
+  struct stat st;
+
+  fd = open(filename.c_str(), O_RDONLY);
+
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    SimpleSSD::panic("Failed to open trace file %s!", filename.c_str());
+  }
+
+  mappedSize = (uint64_t)st.st_size;
+
+  if (mappedSize < sizeof(BinaryTraceHeader)) {
+    SimpleSSD::panic("Pre-compiled trace file is too small");
+  }
+
+  pMapped = (uint8_t *)mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  if (pMapped == MAP_FAILED) {
+    SimpleSSD::panic("Failed to map trace file %s!", filename.c_str());
+  }
+
+  // Records are consumed strictly in order
+  madvise(pMapped, mappedSize, MADV_SEQUENTIAL);
+#endif
+
+  auto header = (const BinaryTraceHeader *)pMapped;
+
+  if (header->version != BINARY_TRACE_VERSION ||
+      header->recordSize != sizeof(BinaryTraceRecord)) {
+    SimpleSSD::panic("Unsupported pre-compiled trace version");
+  }
+
+  count = header->count;
+  lbaSize = header->lbaSize;
+  pRecords = (const BinaryTraceRecord *)(pMapped + sizeof(BinaryTraceHeader));
+
+  if (sizeof(BinaryTraceHeader) + count * sizeof(BinaryTraceRecord) >
+      mappedSize) {
+    SimpleSSD::panic("Pre-compiled trace file is truncated");
+  }
+}
+
+BinaryTraceReader::~BinaryTraceReader() {
+#ifndef _MSC_VER
+  if (pMapped) {
+    munmap(pMapped, mappedSize);
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+#endif
+}
+
+bool BinaryTraceReader::isBinaryTrace(std::string filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(BinaryTraceHeader::magic)];
+
+  if (!file.read(magic, sizeof(magic))) {
+    return false;
+  }
+
+  return memcmp(magic, BINARY_TRACE_MAGIC, sizeof(magic)) == 0;
+}
+
+bool BinaryTraceReader::read(TraceRecord &record) {
+  uint64_t idx = index.load(std::memory_order_relaxed);
+
+  if (idx >= count) {
+    return false;
+  }
+
+  auto &entry = pRecords[idx];
+
+  record.tick = entry.tick;
+  record.offset = entry.offset;
+  record.length = entry.length;
+  record.type = (BIL::BIO_TYPE)entry.type;
+
+  index.store(idx + 1, std::memory_order_relaxed);
+
+  return true;
+}
+
+uint32_t BinaryTraceReader::getLBASize() {
+  return lbaSize;
+}
+
+float BinaryTraceReader::getProgress() {
+  if (count == 0) {
+    return 1.f;
+  }
+
+  return (float)index.load(std::memory_order_relaxed) / count;
+}
+
+}  // namespace IGL
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __IGL_BINARY_READER__
+#define __IGL_BINARY_READER__
+
+#include <atomic>
+#include <string>
+
+#include "igl/trace/trace_reader.hh"
+
+namespace IGL {
+
+#define BINARY_TRACE_MAGIC "SSDTRACE"
+#define BINARY_TRACE_VERSION 1
+
+// On-disk layout of pre-compiled trace (created by trace-compile)
+// All fields are stored in host byte order
+typedef struct _BinaryTraceHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t count;
+  uint32_t lbaSize;
+  uint8_t reserved[36];
+} BinaryTraceHeader;
+
+typedef struct _BinaryTraceRecord {
+  uint64_t tick;
+  uint64_t offset;
+  uint64_t length;
+  uint8_t type;
+  uint8_t reserved[7];
+} BinaryTraceRecord;
+
+class BinaryTraceReader : public TraceReader {
+ private:
+  int fd;
+  uint8_t *pMapped;
+  uint64_t mappedSize;
+
+  const BinaryTraceRecord *pRecords;
+  uint64_t count;
+  uint32_t lbaSize;
+
+  std::atomic<uint64_t> index;
+
+ public:
+  BinaryTraceReader(std::string);
+  ~BinaryTraceReader();
+
+  static bool isBinaryTrace(std::string);
+
+  bool read(TraceRecord &) override;
+  uint32_t getLBASize() override;
+  float getProgress() override;
+};
+
+}  // namespace IGL
+
+#endif
@@ -0,0 +1,627 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "igl/trace/text_reader.hh"
+
+#include <cstring>
+#include <limits>
+
+#include "simplessd/sim/trace.hh"
+#include "simplessd/util/algorithm.hh"
+
+// Initial size of line buffer, grows when a line does not fit
+#define READ_BUFFER_SIZE 1048576
+
+// Time one of every PARSE_SAMPLE_PERIOD reads for parser throughput
+#define PARSE_SAMPLE_PERIOD 64
+
+namespace IGL {
+
+// Helper functions for built-in parsers
+// These work on [ptr, end) without allocation and return false on mismatch
+
+static inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+static inline bool isWord(char c) {
+  return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         c == '_';
+}
+
+static inline bool isSpace(char c) {
+  return c == ' ' || c == '\t';
+}
+
+static inline bool parseUint(const char *&ptr, const char *end,
+                             uint64_t &value) {
+  const char *begin = ptr;
+
+  value = 0;
+
+  while (ptr < end && isDigit(*ptr)) {
+    value = value * 10 + (uint64_t)(*ptr - '0');
+    ptr++;
+  }
+
+  return ptr != begin;
+}
+
+static inline bool skipUint(const char *&ptr, const char *end) {
+  const char *begin = ptr;
+
+  while (ptr < end && isDigit(*ptr)) {
+    ptr++;
+  }
+
+  return ptr != begin;
+}
+
+static inline bool parseWord(const char *&ptr, const char *end,
+                             const char *&word) {
+  word = ptr;
+
+  while (ptr < end && isWord(*ptr)) {
+    ptr++;
+  }
+
+  return ptr != word;
+}
+
+static inline bool expectChar(const char *&ptr, const char *end, char c) {
+  if (ptr < end && *ptr == c) {
+    ptr++;
+
+    return true;
+  }
+
+  return false;
+}
+
+static inline bool skipSpaces(const char *&ptr, const char *end) {
+  const char *begin = ptr;
+
+  while (ptr < end && isSpace(*ptr)) {
+    ptr++;
+  }
+
+  return ptr != begin;
+}
+
+static inline bool skipField(const char *&ptr, const char *end, char delim) {
+  const char *found = (const char *)memchr(ptr, delim, end - ptr);
+
+  if (found) {
+    ptr = found + 1;
+
+    return true;
+  }
+
+  return false;
+}
+
+static inline bool skipToken(const char *&ptr, const char *end) {
+  const char *begin = ptr;
+
+  while (ptr < end && !isSpace(*ptr)) {
+    ptr++;
+  }
+
+  return ptr != begin;
+}
+
+TextTraceReader::TextTraceReader(ConfigReader &c)
+    : TraceReader(),
+      pInput(nullptr),
+      head(0),
+      tail(0),
+      eof(false),
+      parser(nullptr),
+      useLBAOffset(false),
+      useLBALength(false),
+      lbaSize(0),
+      baseTime(std::numeric_limits<uint64_t>::max()),
+      parseTime(0.),
+      lineCount(0),
+      recordCount(0),
+      readCount(0),
+      sampledLines(0) {
+  // Open file (decompressed if needed)
+  pInput = TraceInput::open(
+      c.readString(CONFIG_TRACE, TRACE_FILE),
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_DECOMPRESS_THREADS));
+
+  buffer.resize(READ_BUFFER_SIZE);
+
+  format = (TRACE_FORMAT)c.readUint(CONFIG_TRACE, TRACE_LINE_FORMAT);
+
+  switch (format) {
+    case FORMAT_SIMPLESSD:
+      parser = &TextTraceReader::parseSimpleSSD;
+      lbaSize = (uint32_t)c.readUint(CONFIG_TRACE, TRACE_LBA_SIZE);
+
+      if (SimpleSSD::popcount(lbaSize) != 1) {
+        SimpleSSD::panic("LBA size should be power of 2");
+      }
+
+      return;
+    case FORMAT_BLKPARSE:
+      parser = &TextTraceReader::parseBlkparse;
+      lbaSize = 512;  // Sector of blkparse is always 512 bytes
+
+      return;
+    case FORMAT_ALIBABA:
+      parser = &TextTraceReader::parseAlibaba;
+
+      return;
+    case FORMAT_MSR:
+      parser = &TextTraceReader::parseMSR;
+
+      return;
+    case FORMAT_FIO_IOLOG:
+      parser = &TextTraceReader::parseIolog;
+
+      return;
+    default:
+      parser = &TextTraceReader::parseRegex;
+
+      break;
+  }
+
+  // Create regex
+  try {
+    regex = std::regex(c.readString(CONFIG_TRACE, TRACE_LINE_REGEX));
+  }
+  catch (std::regex_error &e) {
+    SimpleSSD::panic("Invalid regular expression!");
+  }
+
+  // Fill flags
+  groupID[ID_OPERATION] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_OPERATION);
+  groupID[ID_BYTE_OFFSET] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_BYTE_OFFSET);
+  groupID[ID_BYTE_LENGTH] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_BYTE_LENGTH);
+  groupID[ID_LBA_OFFSET] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_LBA_OFFSET);
+  groupID[ID_LBA_LENGTH] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_LBA_LENGTH);
+  groupID[ID_TIME_SEC] = (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_SEC);
+  groupID[ID_TIME_MS] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_MILI_SEC);
+  groupID[ID_TIME_US] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_MICRO_SEC);
+  groupID[ID_TIME_NS] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_NANO_SEC);
+  groupID[ID_TIME_PS] =
+      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_PICO_SEC);
+  useHex = c.readBoolean(CONFIG_TRACE, TRACE_USE_HEX);
+
+  if (groupID[ID_OPERATION] == 0) {
+    SimpleSSD::panic("Operation group ID cannot be 0");
+  }
+
+  if (groupID[ID_LBA_OFFSET] > 0) {
+    useLBAOffset = true;
+  }
+  if (groupID[ID_LBA_LENGTH] > 0) {
+    useLBALength = true;
+  }
+
+  if (useLBALength || useLBAOffset) {
+    lbaSize = (uint32_t)c.readUint(CONFIG_TRACE, TRACE_LBA_SIZE);
+
+    if (SimpleSSD::popcount(lbaSize) != 1) {
+      SimpleSSD::panic("LBA size should be power of 2");
+    }
+  }
+
+  if (!useLBAOffset && groupID[ID_BYTE_OFFSET] == 0) {
+    SimpleSSD::panic("Both LBA Offset and Byte Offset group ID cannot be 0");
+  }
+  if (!useLBALength && groupID[ID_BYTE_LENGTH] == 0) {
+    SimpleSSD::panic("Both LBA Length and Byte Length group ID cannot be 0");
+  }
+
+  timeValids[0] = groupID[ID_TIME_SEC] > 0 ? true : false;
+  timeValids[1] = groupID[ID_TIME_MS] > 0 ? true : false;
+  timeValids[2] = groupID[ID_TIME_US] > 0 ? true : false;
+  timeValids[3] = groupID[ID_TIME_NS] > 0 ? true : false;
+  timeValids[4] = groupID[ID_TIME_PS] > 0 ? true : false;
+
+  if (!(timeValids[0] || timeValids[1] || timeValids[2] || timeValids[3] ||
+        timeValids[4])) {
+    if (c.readUint(CONFIG_TRACE, TRACE_TIMING_MODE) == MODE_STRICT) {
+      SimpleSSD::panic("No valid time field specified");
+    }
+  }
+}
+
+TextTraceReader::~TextTraceReader() {
+  delete pInput;
+}
+
+bool TextTraceReader::nextLine(const char *&begin, const char *&end) {
+  while (true) {
+    char *ptr = buffer.data() + head;
+    uint64_t remain = tail - head;
+    char *found = (char *)memchr(ptr, '\n', remain);
+
+    if (found) {
+      begin = ptr;
+      end = found;
+      head += found - ptr + 1;
+
+      return true;
+    }
+
+    if (eof) {
+      if (remain == 0) {
+        return false;
+      }
+
+      // Last line without newline
+      begin = ptr;
+      end = ptr + remain;
+      head = tail;
+
+      return true;
+    }
+
+    // Move partial line to front and fill buffer
+    memmove(buffer.data(), ptr, remain);
+    head = 0;
+    tail = remain;
+
+    if (tail == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+
+    uint64_t read = pInput->read(buffer.data() + tail, buffer.size() - tail);
+
+    tail += read;
+
+    if (read == 0) {
+      eof = true;
+    }
+  }
+}
+
+uint64_t TextTraceReader::mergeTime(std::cmatch &match) {
+  uint64_t tick = 0;
+  bool valid = true;
+
+  if (timeValids[0] && match.size() > groupID[ID_TIME_SEC]) {
+    tick += strtoul(match[groupID[ID_TIME_SEC]].str().c_str(), nullptr, 10) *
+            1000000000000ULL;
+  }
+  else if (timeValids[0]) {
+    valid = false;
+  }
+
+  if (timeValids[1] && match.size() > groupID[ID_TIME_MS]) {
+    tick += strtoul(match[groupID[ID_TIME_MS]].str().c_str(), nullptr, 10) *
+            1000000000ULL;
+  }
+  else if (timeValids[1]) {
+    valid = false;
+  }
+
+  if (timeValids[2] && match.size() > groupID[ID_TIME_US]) {
+    tick += strtoul(match[groupID[ID_TIME_US]].str().c_str(), nullptr, 10) *
+            1000000ULL;
+  }
+  else if (timeValids[2]) {
+    valid = false;
+  }
+
+  if (timeValids[3] && match.size() > groupID[ID_TIME_NS]) {
+    tick += strtoul(match[groupID[ID_TIME_NS]].str().c_str(), nullptr, 10) *
+            1000ULL;
+  }
+  else if (timeValids[3]) {
+    valid = false;
+  }
+
+  if (timeValids[4] && match.size() > groupID[ID_TIME_PS]) {
+    tick += strtoul(match[groupID[ID_TIME_PS]].str().c_str(), nullptr, 10);
+  }
+  else if (timeValids[4]) {
+    valid = false;
+  }
+
+  if (!valid) {
+    SimpleSSD::panic("Time parse failed");
+  }
+
+  return tick;
+}
+
+BIL::BIO_TYPE TextTraceReader::getType(const char *type) {
+  switch (type[0]) {
+    case 'r':
+    case 'R':
+      return BIL::BIO_READ;
+    case 'w':
+    case 'W':
+      return BIL::BIO_WRITE;
+    case 'f':
+    case 'F':
+      return BIL::BIO_FLUSH;
+    case 't':
+    case 'T':
+    case 'd':
+    case 'D':
+      return BIL::BIO_TRIM;
+  }
+
+  return BIL::BIO_NUM;
+}
+
+bool TextTraceReader::parseRegex(const char *begin, const char *end,
+                                 TraceRecord &record) {
+  if (!std::regex_match(begin, end, match, regex)) {
+    return false;
+  }
+
+  // Get time
+  record.tick = mergeTime(match);
+
+  // Fill record
+  if (useLBAOffset) {
+    record.offset = strtoul(match[groupID[ID_LBA_OFFSET]].str().c_str(),
+                            nullptr, useHex ? 16 : 10) *
+                    lbaSize;
+  }
+  else {
+    record.offset = strtoul(match[groupID[ID_BYTE_OFFSET]].str().c_str(),
+                            nullptr, useHex ? 16 : 10);
+  }
+
+  if (useLBALength) {
+    record.length = strtoul(match[groupID[ID_LBA_LENGTH]].str().c_str(),
+                            nullptr, useHex ? 16 : 10) *
+                    lbaSize;
+  }
+  else {
+    record.length = strtoul(match[groupID[ID_BYTE_LENGTH]].str().c_str(),
+                            nullptr, useHex ? 16 : 10);
+  }
+
+  if (match[groupID[ID_OPERATION]].length() > 0) {
+    record.type = getType(match[groupID[ID_OPERATION]].first);
+  }
+  else {
+    record.type = BIL::BIO_NUM;
+  }
+
+  return true;
+}
+
+// <Time (ns)> <Any> <LBA offset> <LBA length> <Operation>
+// Same as Regex = "(\d+) \d+ (\d+) (\d+) (\w+)" in config/common.cfg
+bool TextTraceReader::parseSimpleSSD(const char *ptr, const char *end,
+                                     TraceRecord &record) {
+  const char *op;
+  uint64_t time;
+
+  if (!parseUint(ptr, end, time) || !expectChar(ptr, end, ' ') ||
+      !skipUint(ptr, end) || !expectChar(ptr, end, ' ') ||
+      !parseUint(ptr, end, record.offset) || !expectChar(ptr, end, ' ') ||
+      !parseUint(ptr, end, record.length) || !expectChar(ptr, end, ' ') ||
+      !parseWord(ptr, end, op) || ptr != end) {
+    return false;
+  }
+
+  record.tick = time * 1000ULL;
+  record.offset *= lbaSize;
+  record.length *= lbaSize;
+  record.type = getType(op);
+
+  return true;
+}
+
+// Default output of blkparse, only D (issued) actions are used
+// <Major>,<Minor> <CPU> <Seq> <Sec>.<Nsec> <PID> D <RWBS> <Sector> + <Count>
+bool TextTraceReader::parseBlkparse(const char *ptr, const char *end,
+                                    TraceRecord &record) {
+  const char *op;
+  uint64_t sec;
+  uint64_t nsec;
+
+  skipSpaces(ptr, end);
+
+  if (!skipUint(ptr, end) || !expectChar(ptr, end, ',') ||
+      !skipUint(ptr, end) || !skipSpaces(ptr, end) || !skipUint(ptr, end) ||
+      !skipSpaces(ptr, end) || !skipUint(ptr, end) || !skipSpaces(ptr, end) ||
+      !parseUint(ptr, end, sec) || !expectChar(ptr, end, '.') ||
+      !parseUint(ptr, end, nsec) || !skipSpaces(ptr, end) ||
+      !skipUint(ptr, end) || !skipSpaces(ptr, end) ||
+      !expectChar(ptr, end, 'D') || !skipSpaces(ptr, end) ||
+      !parseWord(ptr, end, op) || !skipSpaces(ptr, end) ||
+      !parseUint(ptr, end, record.offset) || !expectChar(ptr, end, ' ') ||
+      !expectChar(ptr, end, '+') || !expectChar(ptr, end, ' ') ||
+      !parseUint(ptr, end, record.length)) {
+    return false;
+  }
+
+  record.tick = sec * 1000000000000ULL + nsec * 1000ULL;
+  record.offset *= lbaSize;
+  record.length *= lbaSize;
+  record.type = getType(op);
+
+  return true;
+}
+
+// Alibaba block trace (2020)
+// <Device ID>,<Opcode>,<Byte offset>,<Byte length>,<Timestamp (us)>
+// Timestamp is UNIX time, which overflows in ps. Make it relative to first
+// record (Strict timing mode only uses relative time).
+bool TextTraceReader::parseAlibaba(const char *ptr, const char *end,
+                                   TraceRecord &record) {
+  const char *op;
+  uint64_t time;
+
+  if (!skipUint(ptr, end) || !expectChar(ptr, end, ',') ||
+      !parseWord(ptr, end, op) || !expectChar(ptr, end, ',') ||
+      !parseUint(ptr, end, record.offset) || !expectChar(ptr, end, ',') ||
+      !parseUint(ptr, end, record.length) || !expectChar(ptr, end, ',') ||
+      !parseUint(ptr, end, time)) {
+    return false;
+  }
+
+  if (baseTime == std::numeric_limits<uint64_t>::max()) {
+    baseTime = time;
+  }
+
+  record.tick = (time - baseTime) * 1000000ULL;
+  record.type = getType(op);
+
+  return true;
+}
+
+// MSR Cambridge trace
+// <Timestamp (100ns)>,<Hostname>,<Disk>,<Type>,<Byte offset>,<Byte length>,
+// <Response time>
+// Timestamp is Windows filetime, relative to first record as above.
+bool TextTraceReader::parseMSR(const char *ptr, const char *end,
+                               TraceRecord &record) {
+  const char *op;
+  uint64_t time;
+
+  if (!parseUint(ptr, end, time) || !expectChar(ptr, end, ',') ||
+      !skipField(ptr, end, ',') || !skipUint(ptr, end) ||
+      !expectChar(ptr, end, ',') || !parseWord(ptr, end, op) ||
+      !expectChar(ptr, end, ',') || !parseUint(ptr, end, record.offset) ||
+      !expectChar(ptr, end, ',') || !parseUint(ptr, end, record.length)) {
+    return false;
+  }
+
+  if (baseTime == std::numeric_limits<uint64_t>::max()) {
+    baseTime = time;
+  }
+
+  record.tick = (time - baseTime) * 100000ULL;
+  record.type = getType(op);
+
+  return true;
+}
+
+// fio iolog version 2 and 3
+// v2: <Filename> <Action> <Byte offset> <Byte length>
+// v3: <Timestamp (ms)> <Filename> <Action> <Byte offset> <Byte length>
+// Lines with file actions (add, open, close) are ignored
+bool TextTraceReader::parseIolog(const char *ptr, const char *end,
+                                 TraceRecord &record) {
+  const char *begin = ptr;
+  const char *op;
+  const char *opEnd;
+  uint64_t time;
+
+  // Version 3 begins with timestamp
+  if (!parseUint(ptr, end, time) || !skipSpaces(ptr, end)) {
+    time = 0;
+    ptr = begin;
+  }
+
+  if (!skipToken(ptr, end) || !skipSpaces(ptr, end) ||
+      !parseWord(ptr, end, op)) {
+    return false;
+  }
+
+  opEnd = ptr;
+
+  if (!skipSpaces(ptr, end) || !parseUint(ptr, end, record.offset) ||
+      !skipSpaces(ptr, end) || !parseUint(ptr, end, record.length)) {
+    return false;
+  }
+
+  if ((opEnd - op == 4 && memcmp(op, "sync", 4) == 0) ||
+      (opEnd - op == 8 && memcmp(op, "datasync", 8) == 0)) {
+    record.type = BIL::BIO_FLUSH;
+  }
+  else {
+    record.type = getType(op);
+  }
+
+  record.tick = time * 1000000000ULL;
+
+  return true;
+}
+
+bool TextTraceReader::read(TraceRecord &record) {
+  const char *begin;
+  const char *end;
+  bool found = false;
+  bool sample = ++readCount % PARSE_SAMPLE_PERIOD == 0;
+  uint64_t lines = lineCount;
+
+  // Reading clock costs as much as parsing a line, so only sample
+  if (sample) {
+    watch.start();
+  }
+
+  while (nextLine(begin, end)) {
+    lineCount++;
+
+    // Built-in parsers accept CRLF line ending
+    if (format != FORMAT_REGEX && end > begin && *(end - 1) == '\r') {
+      end--;
+    }
+
+    if ((this->*parser)(begin, end, record)) {
+      recordCount++;
+      found = true;
+
+      break;
+    }
+  }
+
+  if (sample) {
+    watch.stop();
+    parseTime += watch.getDuration();
+    sampledLines += lineCount - lines;
+  }
+
+  return found;
+}
+
+uint32_t TextTraceReader::getLBASize() {
+  return lbaSize;
+}
+
+float TextTraceReader::getProgress() {
+  uint64_t size = pInput->getSize();
+
+  if (size == 0) {
+    return 1.f;
+  }
+
+  // Compressed bytes consumed if file is compressed
+  return (float)pInput->getPosition() / size;
+}
+
+void TextTraceReader::printStats(std::ostream &out) {
+  out << "Trace lines: " << lineCount << " (Matched: " << recordCount << ", "
+      << std::to_string(parseTime > 0. ? sampledLines / parseTime : 0.)
+      << " lines/s)" << std::endl;
+}
+
+}  // namespace IGL
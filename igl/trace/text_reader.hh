@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __IGL_TEXT_READER__
+#define __IGL_TEXT_READER__
+
+#include <regex>
+#include <vector>
+
+#include "igl/trace/trace_input.hh"
+#include "igl/trace/trace_reader.hh"
+#include "sim/cfg_reader.hh"
+#include "util/stopwatch.hh"
+
+namespace IGL {
+
+class TextTraceReader : public TraceReader {
+ private:
+  enum {
+    ID_OPERATION,
+    ID_BYTE_OFFSET,
+    ID_BYTE_LENGTH,
+    ID_LBA_OFFSET,
+    ID_LBA_LENGTH,
+    ID_TIME_SEC,
+    ID_TIME_MS,
+    ID_TIME_US,
+    ID_TIME_NS,
+    ID_TIME_PS,
+    ID_NUM
+  };
+
+  typedef bool (TextTraceReader::*ParseFunction)(const char *, const char *,
+                                                 TraceRecord &);
+
+  TraceInput *pInput;
+  std::regex regex;
+
+  // Line buffer
+  std::vector<char> buffer;
+  uint64_t head;
+  uint64_t tail;
+  bool eof;
+
+  TRACE_FORMAT format;
+  ParseFunction parser;
+
+  bool useLBAOffset;
+  bool useLBALength;
+  uint32_t lbaSize;
+  uint32_t groupID[ID_NUM];
+  bool timeValids[5];
+  bool useHex;
+
+  std::cmatch match;
+  uint64_t baseTime;  // Only used in FORMAT_ALIBABA and FORMAT_MSR
+
+  // Statistics
+  Stopwatch watch;
+  double parseTime;
+  uint64_t lineCount;
+  uint64_t recordCount;
+  uint64_t readCount;
+  uint64_t sampledLines;
+
+  bool nextLine(const char *&, const char *&);
+
+  uint64_t mergeTime(std::cmatch &);
+  BIL::BIO_TYPE getType(const char *);
+
+  bool parseRegex(const char *, const char *, TraceRecord &);
+  bool parseSimpleSSD(const char *, const char *, TraceRecord &);
+  bool parseBlkparse(const char *, const char *, TraceRecord &);
+  bool parseAlibaba(const char *, const char *, TraceRecord &);
+  bool parseMSR(const char *, const char *, TraceRecord &);
+  bool parseIolog(const char *, const char *, TraceRecord &);
+
+ public:
+  TextTraceReader(ConfigReader &);
+  ~TextTraceReader();
+
+  bool read(TraceRecord &) override;
+  uint32_t getLBASize() override;
+  float getProgress() override;
+  void printStats(std::ostream &) override;
+};
+
+}  // namespace IGL
+
+#endif
@@ -40,6 +40,9 @@ const char NAME_GROUP_NANO_SEC[] = "Nanosecond";
 const char NAME_GROUP_PICO_SEC[] = "Picosecond";
 const char NAME_LBA_SIZE[] = "LBASize";
 const char NAME_USE_HEX[] = "UseHexadecimal";
+const char NAME_FORMAT[] = "TraceFormat";
+const char NAME_READ_AHEAD_DEPTH[] = "ReadAheadDepth";
+const char NAME_DECOMPRESS_THREADS[] = "DecompressThreads";
 
 TraceConfig::TraceConfig() {
   mode = MODE_SYNC;
@@ -57,6 +60,9 @@ TraceConfig::TraceConfig() {
   groupPicoSecond = 0;
   lbaSize = 512;
   useHexadecimal = false;
+  format = FORMAT_REGEX;
+  readAheadDepth = 0;
+  decompressThreads = 0;
 }
 
 bool TraceConfig::setConfig(const char *name, const char *value) {
@@ -113,6 +119,15 @@ bool TraceConfig::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_USE_HEX)) {
     useHexadecimal = convertBool(value);
   }
+  else if (MATCH_NAME(NAME_FORMAT)) {
+    format = (TRACE_FORMAT)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_READ_AHEAD_DEPTH)) {
+    readAheadDepth = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DECOMPRESS_THREADS)) {
+    decompressThreads = strtoul(value, nullptr, 10);
+  }
   else {
     ret = false;
   }
@@ -141,17 +156,20 @@ void TraceConfig::update() {
   }
 
   // Remove trailing spaces
-  while (regex.back() == ' ') {
+  while (!regex.empty() && regex.back() == ' ') {
     regex.pop_back();
   }
 
-  if (regex.back() == '"') {
+  if (!regex.empty() && regex.back() == '"') {
     regex.pop_back();
   }
 
   if (mode >= MODE_NUM) {
     SimpleSSD::panic("Invalid timing mode specified");
   }
+  if (format >= FORMAT_NUM) {
+    SimpleSSD::panic("Invalid trace format specified");
+  }
 }
 
 uint64_t TraceConfig::readUint(uint32_t idx) {
@@ -200,6 +218,15 @@ uint64_t TraceConfig::readUint(uint32_t idx) {
     case TRACE_LBA_SIZE:
       ret = lbaSize;
       break;
+    case TRACE_LINE_FORMAT:
+      ret = format;
+      break;
+    case TRACE_READ_AHEAD_DEPTH:
+      ret = readAheadDepth;
+      break;
+    case TRACE_DECOMPRESS_THREADS:
+      ret = decompressThreads;
+      break;
   }
 
   return ret;
@@ -44,6 +44,9 @@ typedef enum {
   TRACE_GROUP_PICO_SEC,
   TRACE_LBA_SIZE,
   TRACE_USE_HEX,
+  TRACE_LINE_FORMAT,
+  TRACE_READ_AHEAD_DEPTH,
+  TRACE_DECOMPRESS_THREADS,
 } TRACE_CONFIG;
 
 typedef enum {
@@ -53,6 +56,16 @@ typedef enum {
   MODE_NUM,
 } TIMING_MODE;
 
+typedef enum {
+  FORMAT_REGEX,
+  FORMAT_SIMPLESSD,
+  FORMAT_BLKPARSE,
+  FORMAT_ALIBABA,
+  FORMAT_MSR,
+  FORMAT_FIO_IOLOG,
+  FORMAT_NUM,
+} TRACE_FORMAT;
+
 class TraceConfig : public SimpleSSD::BaseConfig {
  private:
   std::string file;
@@ -72,6 +85,9 @@ class TraceConfig : public SimpleSSD::BaseConfig {
   uint32_t groupPicoSecond;
   uint32_t lbaSize;
   bool useHexadecimal;
+  TRACE_FORMAT format;
+  uint64_t readAheadDepth;
+  uint32_t decompressThreads;
 
  public:
   TraceConfig();
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "igl/trace/trace_input.hh"
+
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "simplessd/sim/trace.hh"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_LZMA
+#include <lzma.h>
+#endif
+
+// Size of compressed input buffer
+#define INPUT_BUFFER_SIZE 1048576
+
+namespace IGL {
+
+const uint8_t MAGIC_GZIP[] = {0x1F, 0x8B};
+const uint8_t MAGIC_ZSTD[] = {0x28, 0xB5, 0x2F, 0xFD};
+const uint8_t MAGIC_XZ[] = {0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00};
+
+class FileInput : public TraceInput {
+ protected:
+  std::ifstream file;
+
+  // Read from file and update position
+  uint64_t readFile(char *buffer, uint64_t length) {
+    file.read(buffer, length);
+
+    uint64_t read = (uint64_t)file.gcount();
+
+    position.fetch_add(read, std::memory_order_relaxed);
+
+    return read;
+  }
+
+ public:
+  FileInput(std::string filename) : TraceInput() {
+    file.open(filename, std::ios::binary);
+
+    if (!file.is_open()) {
+      SimpleSSD::panic("Failed to open trace file %s!", filename.c_str());
+    }
+
+    file.seekg(0, std::ios::end);
+    fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+  }
+
+  uint64_t read(char *buffer, uint64_t length) override {
+    return readFile(buffer, length);
+  }
+};
+
+// Base of decompressors. Keeps compressed bytes in inBuffer.
+class CompressedInput : public FileInput {
+ protected:
+  std::vector<char> inBuffer;
+  uint64_t inHead;
+  uint64_t inTail;
+
+  // Refill input buffer when it is empty, returns false at end of file
+  bool fillInput() {
+    if (inHead == inTail) {
+      inHead = 0;
+      inTail = readFile(inBuffer.data(), inBuffer.size());
+    }
+
+    return inHead < inTail;
+  }
+
+ public:
+  CompressedInput(std::string filename)
+      : FileInput(filename), inHead(0), inTail(0) {
+    inBuffer.resize(INPUT_BUFFER_SIZE);
+  }
+};
+
+#ifdef HAVE_ZLIB
+class GzipInput : public CompressedInput {
+ private:
+  z_stream stream;
+  bool finished;
+
+ public:
+  GzipInput(std::string filename)
+      : CompressedInput(filename), finished(false) {
+    memset(&stream, 0, sizeof(stream));
+
+    // 15 + 32: Maximum window size with gzip/zlib header auto detection
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+      SimpleSSD::panic("Failed to initialize gzip decompressor");
+    }
+  }
+
+  ~GzipInput() { inflateEnd(&stream); }
+
+  uint64_t read(char *buffer, uint64_t length) override {
+    stream.next_out = (Bytef *)buffer;
+    stream.avail_out = (uInt)length;
+
+    while (stream.avail_out > 0 && !finished) {
+      if (!fillInput()) {
+        finished = true;
+
+        break;
+      }
+
+      stream.next_in = (Bytef *)inBuffer.data() + inHead;
+      stream.avail_in = (uInt)(inTail - inHead);
+
+      int ret = inflate(&stream, Z_NO_FLUSH);
+
+      inHead = inTail - stream.avail_in;
+
+      if (ret == Z_STREAM_END) {
+        // Multi-member gzip file (e.g. pigz, cat a.gz b.gz)
+        inflateReset(&stream);
+      }
+      else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        SimpleSSD::panic("Failed to decompress gzip trace file");
+      }
+    }
+
+    return length - stream.avail_out;
+  }
+};
+#endif
+
+#ifdef HAVE_ZSTD
+class ZstdInput : public CompressedInput {
+ private:
+  ZSTD_DStream *stream;
+  ZSTD_inBuffer in;
+
+ public:
+  ZstdInput(std::string filename) : CompressedInput(filename) {
+    stream = ZSTD_createDStream();
+
+    if (stream == nullptr || ZSTD_isError(ZSTD_initDStream(stream))) {
+      SimpleSSD::panic("Failed to initialize zstd decompressor");
+    }
+  }
+
+  ~ZstdInput() { ZSTD_freeDStream(stream); }
+
+  uint64_t read(char *buffer, uint64_t length) override {
+    ZSTD_outBuffer out = {buffer, length, 0};
+
+    while (out.pos < out.size) {
+      if (!fillInput()) {
+        break;
+      }
+
+      in.src = inBuffer.data();
+      in.size = inTail;
+      in.pos = inHead;
+
+      size_t ret = ZSTD_decompressStream(stream, &out, &in);
+
+      inHead = in.pos;
+
+      if (ZSTD_isError(ret)) {
+        SimpleSSD::panic("Failed to decompress zstd trace file: %s",
+                         ZSTD_getErrorName(ret));
+      }
+    }
+
+    return out.pos;
+  }
+};
+#endif
+
+#ifdef HAVE_LZMA
+class XzInput : public CompressedInput {
+ private:
+  lzma_stream stream;
+  bool finished;
+
+ public:
+  XzInput(std::string filename, uint32_t threads)
+      : CompressedInput(filename), stream(LZMA_STREAM_INIT), finished(false) {
+    lzma_ret ret;
+
+#if LZMA_VERSION >= 50040002
+    lzma_mt mt;
+
+    memset(&mt, 0, sizeof(mt));
+
+    // Multi-threaded decoding only works for multi-block files (xz -T)
+    mt.flags = LZMA_CONCATENATED;
+    mt.threads = threads;
+    mt.memlimit_threading = UINT64_MAX;
+    mt.memlimit_stop = UINT64_MAX;
+
+    ret = lzma_stream_decoder_mt(&stream, &mt);
+#else
+    (void)threads;
+
+    ret = lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED);
+#endif
+
+    if (ret != LZMA_OK) {
+      SimpleSSD::panic("Failed to initialize xz decompressor");
+    }
+  }
+
+  ~XzInput() { lzma_end(&stream); }
+
+  uint64_t read(char *buffer, uint64_t length) override {
+    stream.next_out = (uint8_t *)buffer;
+    stream.avail_out = length;
+
+    while (stream.avail_out > 0 && !finished) {
+      lzma_action action = LZMA_RUN;
+
+      if (!fillInput()) {
+        // Let decoder check end of concatenated streams
+        action = LZMA_FINISH;
+      }
+
+      stream.next_in = (const uint8_t *)inBuffer.data() + inHead;
+      stream.avail_in = inTail - inHead;
+
+      lzma_ret ret = lzma_code(&stream, action);
+
+      inHead = inTail - stream.avail_in;
+
+      if (ret == LZMA_STREAM_END) {
+        finished = true;
+      }
+      else if (ret != LZMA_OK) {
+        SimpleSSD::panic("Failed to decompress xz trace file");
+      }
+    }
+
+    return length - stream.avail_out;
+  }
+};
+#endif
+
+TraceInput *TraceInput::open(std::string filename, uint32_t threads) {
+  uint8_t magic[8];
+  uint64_t size = 0;
+
+  {
+    std::ifstream file(filename, std::ios::binary);
+
+    file.read((char *)magic, sizeof(magic));
+    size = (uint64_t)file.gcount();
+  }
+
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+
+  if (size >= sizeof(MAGIC_GZIP) &&
+      memcmp(magic, MAGIC_GZIP, sizeof(MAGIC_GZIP)) == 0) {
+#ifdef HAVE_ZLIB
+    return new GzipInput(filename);
+#else
+    SimpleSSD::panic("Built without gzip support");
+#endif
+  }
+  else if (size >= sizeof(MAGIC_ZSTD) &&
+           memcmp(magic, MAGIC_ZSTD, sizeof(MAGIC_ZSTD)) == 0) {
+#ifdef HAVE_ZSTD
+    return new ZstdInput(filename);
+#else
+    SimpleSSD::panic("Built without zstd support");
+#endif
+  }
+  else if (size >= sizeof(MAGIC_XZ) &&
+           memcmp(magic, MAGIC_XZ, sizeof(MAGIC_XZ)) == 0) {
+#ifdef HAVE_LZMA
+    return new XzInput(filename, threads);
+#else
+    SimpleSSD::panic("Built without xz support");
+#endif
+  }
+
+  (void)threads;
+
+  return new FileInput(filename);
+}
+
+}  // namespace IGL
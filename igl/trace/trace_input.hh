@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __IGL_TRACE_INPUT__
+#define __IGL_TRACE_INPUT__
+
+#include <atomic>
+#include <cinttypes>
+#include <string>
+
+namespace IGL {
+
+/**
+ * Byte stream of trace file
+ *
+ * Compressed file (gzip, zstd, xz) is decompressed while reading.
+ * Position and size are in bytes of file on disk (compressed bytes).
+ */
+class TraceInput {
+ protected:
+  uint64_t fileSize;
+  std::atomic<uint64_t> position;
+
+ public:
+  TraceInput() : fileSize(0), position(0) {}
+  virtual ~TraceInput() {}
+
+  // Returns number of bytes read, 0 at end of file
+  virtual uint64_t read(char *, uint64_t) = 0;
+
+  uint64_t getSize() { return fileSize; }
+  uint64_t getPosition() { return position.load(std::memory_order_relaxed); }
+
+  // Select decompressor by magic number of file
+  static TraceInput *open(std::string, uint32_t);
+};
+
+}  // namespace IGL
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __IGL_TRACE_READER__
+#define __IGL_TRACE_READER__
+
+#include <cinttypes>
+#include <iostream>
+
+#include "bil/entry.hh"
+
+namespace IGL {
+
+typedef struct _TraceRecord {
+  uint64_t tick;  // Time field of trace in ps (not relative to first I/O)
+  uint64_t offset;
+  uint64_t length;
+  BIL::BIO_TYPE type;
+} TraceRecord;
+
+class TraceReader {
+ public:
+  TraceReader() {}
+  virtual ~TraceReader() {}
+
+  // Returns false when there is no more record
+  virtual bool read(TraceRecord &) = 0;
+
+  // LBA size used to convert offset and length, 0 if not used
+  virtual uint32_t getLBASize() { return 0; }
+
+  // Called from progress thread
+  virtual float getProgress() = 0;
+
+  virtual void printStats(std::ostream &) {}
+};
+
+}  // namespace IGL
+
+#endif
@@ -19,43 +19,43 @@
 
 #include "igl/trace/trace_replayer.hh"
 
+#include <limits>
 #include <utility>
 
+#include "igl/trace/async_reader.hh"
+#include "igl/trace/binary_reader.hh"
+#include "igl/trace/text_reader.hh"
 #include "simplessd/sim/trace.hh"
-#include "simplessd/util/algorithm.hh"
 
 namespace IGL {
 
 TraceReplayer::TraceReplayer(Engine &e, BIL::BlockIOEntry &b,
                              std::function<void()> &f, ConfigReader &c)
     : IOGenerator(e, b, f),
-      useLBAOffset(false),
-      useLBALength(false),
+      pReader(nullptr),
       nextIOIsSync(false),
       reserveTermination(false),
       io_submitted(0),
       io_count(0),
       read_count(0),
       write_count(0),
+      skip_count(0),
       io_depth(0) {
-  // Check file
+  // Select trace reader
   auto filename = c.readString(CONFIG_TRACE, TRACE_FILE);
-  file.open(filename);
 
-  if (!file.is_open()) {
-    SimpleSSD::panic("Failed to open trace file %s!", filename.c_str());
+  if (BinaryTraceReader::isBinaryTrace(filename)) {
+    pReader = new BinaryTraceReader(filename);
+  }
+  else {
+    pReader = new TextTraceReader(c);
   }
 
-  file.seekg(0, std::ios::end);
-  fileSize = file.tellg();
-  file.seekg(0, std::ios::beg);
+  // Decode trace in background thread
+  uint64_t depth = c.readUint(CONFIG_TRACE, TRACE_READ_AHEAD_DEPTH);
 
-  // Create regex
-  try {
-    regex = std::regex(c.readString(CONFIG_TRACE, TRACE_LINE_REGEX));
-  }
-  catch (std::regex_error &e) {
-    SimpleSSD::panic("Invalid regular expression!");
+  if (depth > 0) {
+    pReader = new AsyncTraceReader(pReader, depth);
   }
 
   // Fill flags
@@ -64,65 +64,6 @@ TraceReplayer::TraceReplayer(Engine &e, BIL::BlockIOEntry &b,
   completionLatency = c.readUint(CONFIG_GLOBAL, GLOBAL_COMPLETION_LATENCY);
   maxQueueDepth = c.readUint(CONFIG_TRACE, TRACE_QUEUE_DEPTH);
   max_io = c.readUint(CONFIG_TRACE, TRACE_IO_LIMIT);
-  groupID[ID_OPERATION] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_OPERATION);
-  groupID[ID_BYTE_OFFSET] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_BYTE_OFFSET);
-  groupID[ID_BYTE_LENGTH] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_BYTE_LENGTH);
-  groupID[ID_LBA_OFFSET] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_LBA_OFFSET);
-  groupID[ID_LBA_LENGTH] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_LBA_LENGTH);
-  groupID[ID_TIME_SEC] = (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_SEC);
-  groupID[ID_TIME_MS] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_MILI_SEC);
-  groupID[ID_TIME_US] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_MICRO_SEC);
-  groupID[ID_TIME_NS] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_NANO_SEC);
-  groupID[ID_TIME_PS] =
-      (uint32_t)c.readUint(CONFIG_TRACE, TRACE_GROUP_PICO_SEC);
-  useHex = c.readBoolean(CONFIG_TRACE, TRACE_USE_HEX);
-
-  if (groupID[ID_OPERATION] == 0) {
-    SimpleSSD::panic("Operation group ID cannot be 0");
-  }
-
-  if (groupID[ID_LBA_OFFSET] > 0) {
-    useLBAOffset = true;
-  }
-  if (groupID[ID_LBA_LENGTH] > 0) {
-    useLBALength = true;
-  }
-
-  if (useLBALength || useLBAOffset) {
-    lbaSize = (uint32_t)c.readUint(CONFIG_TRACE, TRACE_LBA_SIZE);
-
-    if (SimpleSSD::popcount(lbaSize) != 1) {
-      SimpleSSD::panic("LBA size should be power of 2");
-    }
-  }
-
-  if (!useLBAOffset && groupID[ID_BYTE_OFFSET] == 0) {
-    SimpleSSD::panic("Both LBA Offset and Byte Offset group ID cannot be 0");
-  }
-  if (!useLBALength && groupID[ID_BYTE_LENGTH] == 0) {
-    SimpleSSD::panic("Both LBA Length and Byte Length group ID cannot be 0");
-  }
-
-  timeValids[0] = groupID[ID_TIME_SEC] > 0 ? true : false;
-  timeValids[1] = groupID[ID_TIME_MS] > 0 ? true : false;
-  timeValids[2] = groupID[ID_TIME_US] > 0 ? true : false;
-  timeValids[3] = groupID[ID_TIME_NS] > 0 ? true : false;
-  timeValids[4] = groupID[ID_TIME_PS] > 0 ? true : false;
-
-  if (!(timeValids[0] || timeValids[1] || timeValids[2] || timeValids[3] ||
-        timeValids[4])) {
-    if (mode == MODE_STRICT) {
-      SimpleSSD::panic("No valid time field specified");
-    }
-  }
 
   firstTick = std::numeric_limits<uint64_t>::max();
 
@@ -132,14 +73,16 @@ TraceReplayer::TraceReplayer(Engine &e, BIL::BlockIOEntry &b,
 }
 
 TraceReplayer::~TraceReplayer() {
-  file.close();
+  delete pReader;
 }
 
 void TraceReplayer::init(uint64_t bytesize, uint32_t bs) {
   ssdSize = bytesize;
   blocksize = bs;
 
-  if ((useLBALength || useLBAOffset) && lbaSize < bs) {
+  uint32_t lbaSize = pReader->getLBASize();
+
+  if (lbaSize > 0 && lbaSize < bs) {
     SimpleSSD::warn("LBA size of trace file is smaller than SSD's LBA size");
   }
 }
@@ -162,6 +105,11 @@ void TraceReplayer::printStats(std::ostream &out) {
       << std::endl;
   out << "I/O (counts): " << io_count << " (Read: " << read_count
       << ", Write: " << write_count << ")" << std::endl;
+
+  if (skip_count > 0) {
+    out << "Skipped records (unknown operation): " << skip_count << std::endl;
+  }
+  pReader->printStats(out);
   out << "*** End of statistics ***" << std::endl;
 
   bioEntry.printStats(out);
@@ -169,15 +117,8 @@ void TraceReplayer::printStats(std::ostream &out) {
 
 void TraceReplayer::getProgress(float &val) {
   if (max_io == 0) {
-    // If I/O count is unlimited, use file pointer for fast progress calculation
-    uint64_t ptr;
-
-    {
-      std::lock_guard<std::mutex> guard(m);
-      ptr = file.tellg();
-    }
-
-    val = (float)ptr / fileSize;
+    // If I/O count is unlimited, use position of trace reader
+    val = pReader->getProgress();
   }
   else {
     // Use submitted I/O count in progress calculation
@@ -187,104 +128,17 @@ void TraceReplayer::getProgress(float &val) {
   }
 }
 
-uint64_t TraceReplayer::mergeTime(std::smatch &match) {
-  uint64_t tick = 0;
-  bool valid = true;
-
-  if (timeValids[0] && match.size() > groupID[ID_TIME_SEC]) {
-    tick += strtoul(match[groupID[ID_TIME_SEC]].str().c_str(), nullptr, 10) *
-            1000000000000ULL;
-  }
-  else if (timeValids[0]) {
-    valid = false;
-  }
-
-  if (timeValids[1] && match.size() > groupID[ID_TIME_MS]) {
-    tick += strtoul(match[groupID[ID_TIME_MS]].str().c_str(), nullptr, 10) *
-            1000000000ULL;
-  }
-  else if (timeValids[1]) {
-    valid = false;
-  }
-
-  if (timeValids[2] && match.size() > groupID[ID_TIME_US]) {
-    tick += strtoul(match[groupID[ID_TIME_US]].str().c_str(), nullptr, 10) *
-            1000000ULL;
-  }
-  else if (timeValids[2]) {
-    valid = false;
-  }
-
-  if (timeValids[3] && match.size() > groupID[ID_TIME_NS]) {
-    tick += strtoul(match[groupID[ID_TIME_NS]].str().c_str(), nullptr, 10) *
-            1000ULL;
-  }
-  else if (timeValids[3]) {
-    valid = false;
-  }
-
-  if (timeValids[4] && match.size() > groupID[ID_TIME_PS]) {
-    tick += strtoul(match[groupID[ID_TIME_PS]].str().c_str(), nullptr, 10);
-  }
-  else if (timeValids[4]) {
-    valid = false;
-  }
-
-  if (!valid) {
-    SimpleSSD::panic("Time parse failed");
-  }
-
-  return tick;
-}
-
-BIL::BIO_TYPE TraceReplayer::getType(std::string type) {
-  io_count++;
-
-  switch (type[0]) {
-    case 'r':
-    case 'R':
-      read_count++;
-
-      return BIL::BIO_READ;
-    case 'w':
-    case 'W':
-      write_count++;
-
-      return BIL::BIO_WRITE;
-    case 'f':
-    case 'F':
-      return BIL::BIO_FLUSH;
-    case 't':
-    case 'T':
-    case 'd':
-    case 'D':
-      return BIL::BIO_TRIM;
-  }
-
-  return BIL::BIO_NUM;
-}
-
 void TraceReplayer::handleNextLine() {
-  std::string line;
-  std::smatch match;
+  TraceRecord record;
 
   if (reserveTermination) {
     // Nothing to do
     return;
   }
 
-  // Read line
+  // Read record, skipping ones with unknown operation
   while (true) {
-    bool eof = false;
-
-    {
-      std::lock_guard<std::mutex> guard(m);
-
-      eof = file.eof();
-      std::getline(file, line);
-    }
-
-    if (eof) {
+    if (!pReader->read(record)) {
       reserveTermination = true;
 
       if (io_depth == 0) {
@@ -294,13 +148,18 @@ void TraceReplayer::handleNextLine() {
 
       return;
     }
-    if (std::regex_match(line, match, regex)) {
+
+    if (record.type < BIL::BIO_NUM) {
       break;
     }
+
+    if (skip_count++ == 0) {
+      SimpleSSD::warn("Skip trace records with unknown operation");
+    }
   }
 
   // Get time
-  const uint64_t tick = mergeTime(match);
+  const uint64_t tick = record.tick;
 
   // mjo: Firstly initialize the variable
   if (firstTick == std::numeric_limits<uint64_t>::max()) {
@@ -315,29 +174,20 @@ void TraceReplayer::handleNextLine() {
   BIL::BIO bio;
 
   // Fill BIO
-  if (useLBAOffset) {
-    bio.offset = strtoul(match[groupID[ID_LBA_OFFSET]].str().c_str(), nullptr,
-                         useHex ? 16 : 10) *
-                 lbaSize;
-  }
-  else {
-    bio.offset = strtoul(match[groupID[ID_BYTE_OFFSET]].str().c_str(), nullptr,
-                         useHex ? 16 : 10);
-  }
+  bio.offset = record.offset;
+  bio.length = record.length;
+  bio.type = record.type;
+  bio.callback = completionEvent;
 
-  if (useLBALength) {
-    bio.length = strtoul(match[groupID[ID_LBA_LENGTH]].str().c_str(), nullptr,
-                         useHex ? 16 : 10) *
-                 lbaSize;
+  io_count++;
+
+  if (bio.type == BIL::BIO_READ) {
+    read_count++;
   }
-  else {
-    bio.length = strtoul(match[groupID[ID_BYTE_LENGTH]].str().c_str(), nullptr,
-                         useHex ? 16 : 10);
+  else if (bio.type == BIL::BIO_WRITE) {
+    write_count++;
   }
 
-  // This function increases I/O count
-  bio.type = getType(match[groupID[ID_OPERATION]].str());
-  bio.callback = completionEvent;
   bio.id = io_count;
 
   // Limit check
@@ -22,14 +22,12 @@
 #ifndef __IGL_TRACE_REPLAYER__
 #define __IGL_TRACE_REPLAYER__
 
-#include <fstream>
 #include <list>
-#include <mutex>
-#include <regex>
 #include <thread>
 
 #include "bil/entry.hh"
 #include "igl/io_gen.hh"
+#include "igl/trace/trace_reader.hh"
 #include "sim/cfg_reader.hh"
 #include "sim/engine.hh"
 
@@ -40,39 +38,13 @@ class TraceReplayer : public IOGenerator {
 	 using backup_t = std::pair<SimpleSSD::Event, uint64_t>;
 	 std::unique_ptr<backup_t> pBackup = nullptr;
 
-  enum {
-    ID_OPERATION,
-    ID_BYTE_OFFSET,
-    ID_BYTE_LENGTH,
-    ID_LBA_OFFSET,
-    ID_LBA_LENGTH,
-    ID_TIME_SEC,
-    ID_TIME_MS,
-    ID_TIME_US,
-    ID_TIME_NS,
-    ID_TIME_PS,
-    ID_NUM
-  };
-
-  std::mutex m;
-
-  std::ifstream file;
-  std::regex regex;
-
-  uint64_t fileSize;
+  TraceReader *pReader;
 
   TIMING_MODE mode;
   uint64_t submissionLatency;
   uint64_t completionLatency;
   uint32_t maxQueueDepth;  // Only used in MODE_ASYNC
 
-  bool useLBAOffset;
-  bool useLBALength;
-  uint32_t lbaSize;
-  uint32_t groupID[ID_NUM];
-  bool timeValids[5];
-  bool useHex;
-
   uint64_t ssdSize;
   uint32_t blocksize;
 
@@ -87,11 +59,10 @@ class TraceReplayer : public IOGenerator {
   uint64_t io_count;      // I/O count created and submitted
   uint64_t read_count;
   uint64_t write_count;
+  uint64_t skip_count;    // Records with unknown operation
 
   uint64_t io_depth;
 
-  uint64_t mergeTime(std::smatch &);
-  BIL::BIO_TYPE getType(std::string);
   void handleNextLine();
   void rescheduleSubmit(uint64_t);
 
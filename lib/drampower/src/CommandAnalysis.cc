@@ -187,15 +187,17 @@ void CommandAnalysis::getCommands(std::vector<MemCommand>& list, bool lastupdate
                            activation_cycle[cmd.getBank()] + memSpec.memTimingSpec.RAS);
       list.push_back(MemCommand(MemCommand::PRE, cmd.getBank(), preTime));
     }
+  }
 
-    if (!lastupdate && timestamp > 0) {
-      if(cmd.getTimeInt64() > timestamp)
-      {
-          MemCommand nextWindowCmd = list[i];
-          next_window_cmd_list.push_back(nextWindowCmd);
-          list.erase(find(list.begin(), list.end(), cmd));
-      }
-    }
+  // Move commands after the window to the next window. Erasing inside the
+  // loop above skipped the command following each erased one.
+  if (!lastupdate && timestamp > 0) {
+    auto next = stable_partition(list.begin(), list.end(),
+                                 [timestamp](const MemCommand& cmd) {
+                                   return cmd.getTimeInt64() <= timestamp;
+                                 });
+    next_window_cmd_list.insert(next_window_cmd_list.end(), next, list.end());
+    list.erase(next, list.end());
   }
   sort(list.begin(), list.end(), commandSorter);
 
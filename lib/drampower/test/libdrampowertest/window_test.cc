@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Window energy must only include commands issued up to the window end.
+// Commands after the window end are carried to the next window.
+
+#include <cmath>
+#include <iostream>
+
+#include "libdrampower/LibDRAMPower.h"
+
+using namespace Data;
+
+MemorySpecification makeSpec() {
+  MemorySpecification spec;
+
+  // DDR3-1600 like numbers, same fields SimpleSSD fills
+  spec.memArchSpec.burstLength = 8;
+  spec.memArchSpec.nbrOfBanks = 8;
+  spec.memArchSpec.nbrOfRanks = 1;
+  spec.memArchSpec.dataRate = 2;
+  spec.memArchSpec.width = 16;
+  spec.memArchSpec.dll = true;
+
+  spec.memTimingSpec.RC = 39;
+  spec.memTimingSpec.RCD = 11;
+  spec.memTimingSpec.RL = 11;
+  spec.memTimingSpec.WL = 10;
+  spec.memTimingSpec.RP = 11;
+  spec.memTimingSpec.RFC = 128;
+  spec.memTimingSpec.RAS = 28;
+  spec.memTimingSpec.RTP = 6;
+  spec.memTimingSpec.WR = 12;
+  spec.memTimingSpec.clkPeriod = 1.25;
+  spec.memTimingSpec.clkMhz = 800;
+
+  spec.memPowerSpec.idd0 = 70;
+  spec.memPowerSpec.idd2n = 42;
+  spec.memPowerSpec.idd3n = 45;
+  spec.memPowerSpec.idd4r = 140;
+  spec.memPowerSpec.idd4w = 145;
+  spec.memPowerSpec.idd5 = 215;
+  spec.memPowerSpec.vdd = 1.5;
+
+  return spec;
+}
+
+struct Energy {
+  double act;
+  double read;
+  double pre;
+};
+
+Energy getWindow(libDRAMPower &dram, int64_t end) {
+  Energy ret;
+
+  dram.calcWindowEnergy(end);
+
+  auto &energy = dram.getEnergy();
+
+  ret.act = energy.act_energy;
+  ret.read = energy.read_energy;
+  ret.pre = energy.pre_energy;
+
+  return ret;
+}
+
+bool check(const char *name, double value, double expected) {
+  if (fabs(value - expected) > 1e-9 * fabs(expected)) {
+    std::cerr << name << ": " << value << " (expected " << expected << ")"
+              << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+int main() {
+  MemorySpecification spec = makeSpec();
+  bool pass = true;
+
+  // Energy of one ACT, RD and PRE
+  Energy unit;
+  {
+    libDRAMPower dram(spec, false);
+
+    dram.doCommand(MemCommand::ACT, 0, 10);
+    dram.doCommand(MemCommand::RD, 0, 21);
+    dram.doCommand(MemCommand::PRE, 0, 40);
+
+    unit = getWindow(dram, 60);
+  }
+
+  if (unit.act <= 0. || unit.read <= 0. || unit.pre <= 0.) {
+    std::cerr << "Invalid reference energy" << std::endl;
+
+    return 1;
+  }
+
+  // Second access is issued before first window ends, and two of its
+  // commands are adjacent in the command list
+  {
+    libDRAMPower dram(spec, false);
+    Energy window;
+
+    dram.doCommand(MemCommand::ACT, 0, 10);
+    dram.doCommand(MemCommand::RD, 0, 21);
+    dram.doCommand(MemCommand::PRE, 0, 40);
+    dram.doCommand(MemCommand::ACT, 0, 100);
+    dram.doCommand(MemCommand::RD, 0, 111);
+    dram.doCommand(MemCommand::RD, 0, 122);
+    dram.doCommand(MemCommand::PRE, 0, 150);
+
+    window = getWindow(dram, 60);
+
+    pass &= check("first window ACT", window.act, unit.act);
+    pass &= check("first window RD", window.read, unit.read);
+    pass &= check("first window PRE", window.pre, unit.pre);
+
+    window = getWindow(dram, 200);
+
+    pass &= check("second window ACT", window.act, unit.act);
+    pass &= check("second window RD", window.read, 2 * unit.read);
+    pass &= check("second window PRE", window.pre, unit.pre);
+  }
+
+  if (!pass) {
+    return 1;
+  }
+
+  std::cout << "DRAMPower window test passed" << std::endl;
+
+  return 0;
+}
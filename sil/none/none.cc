@@ -28,6 +28,10 @@ namespace None {
 Driver::Driver(Engine &e, SimpleSSD::ConfigReader &conf)
     : BIL::DriverInterface(e), totalLogicalPages(0), logicalPageSize(0) {
   pHIL = new SimpleSSD::HIL::HIL(conf);
+
+  hilCallback = [this](uint64_t, void *context) {
+    ioCallback((uint64_t)context);
+  };
 }
 
 Driver::~Driver() {
@@ -56,7 +60,9 @@ void Driver::getInfo(uint64_t &bytesize, uint32_t &minbs) {
 
 void Driver::submitIO(BIL::BIO &bio) {
   SimpleSSD::HIL::Request req;
-  auto *pFunc = new std::function<void(uint64_t)>(bio.callback);
+
+  // All BIOs come from one BlockIOEntry and share its completion callback
+  ioCallback = bio.callback;
 
   // Convert to request
   req.reqID = bio.id;
@@ -65,10 +71,7 @@ void Driver::submitIO(BIL::BIO &bio) {
   req.offset = bio.offset % logicalPageSize;
   req.length = bio.length;
   req.context = (void *)bio.id;
-  req.function = [pFunc](uint64_t, void *context) {
-    pFunc->operator()((uint64_t)context);
-    delete pFunc;
-  };
+  req.function = hilCallback;
 
   // Submit
   switch (bio.type) {
@@ -36,6 +36,9 @@ class Driver : public BIL::DriverInterface {
   uint64_t totalLogicalPages;
   uint32_t logicalPageSize;
 
+  std::function<void(uint64_t)> ioCallback;
+  std::function<void(uint64_t, void *)> hilCallback;
+
  public:
   Driver(Engine &, SimpleSSD::ConfigReader &);
   ~Driver();
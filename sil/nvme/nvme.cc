@@ -45,6 +45,9 @@ Driver::Driver(Engine &e, SimpleSSD::ConfigReader &conf)
 
   dmaReadEvent = engine.allocateEvent([this](uint64_t) { dmaReadDone(); });
   dmaWriteEvent = engine.allocateEvent([this](uint64_t) { dmaWriteDone(); });
+  ioHandler = [this](uint16_t status, uint32_t, void *context) {
+    _io(status, context);
+  };
 }
 
 Driver::~Driver() {
@@ -53,6 +56,10 @@ Driver::~Driver() {
   delete adminCQ;
   delete ioSQ;
   delete ioCQ;
+
+  for (auto &iter : freeWrapper) {
+    delete iter;
+  }
 }
 
 void Driver::init(std::function<void()> &func) {
@@ -355,11 +362,6 @@ void Driver::getInfo(uint64_t &bytesize, uint32_t &minbs) {
 void Driver::submitIO(BIL::BIO &bio) {
   uint32_t cmd[16];
   PRP *prp = nullptr;
-  static ResponseHandler callback = [this](uint16_t status, uint32_t,
-                                           void *context) {
-    _io(status, context);
-  };
-
   memset(cmd, 0, 64);
 
   uint64_t slba = bio.offset / LBAsize;
@@ -406,8 +408,21 @@ void Driver::submitIO(BIL::BIO &bio) {
     prp->writeData(0, 16, data);
   }
 
-  submitCommand(1, (uint8_t *)cmd, callback,
-                new IOWrapper(bio.id, prp, bio.callback));
+  IOWrapper *wrapper;
+
+  if (freeWrapper.empty()) {
+    wrapper = new IOWrapper(bio.id, prp, bio.callback);
+  }
+  else {
+    wrapper = freeWrapper.back();
+    freeWrapper.pop_back();
+
+    wrapper->id = bio.id;
+    wrapper->prp = prp;
+    wrapper->bioCallback = bio.callback;
+  }
+
+  submitCommand(1, (uint8_t *)cmd, ioHandler, wrapper);
 }
 
 void Driver::_io(uint16_t status, void *context) {
@@ -418,10 +433,16 @@ void Driver::_io(uint16_t status, void *context) {
     SimpleSSD::warn("I/O error: %04X", status);
   }
 
-  wrapper->bioCallback(wrapper->id);
+  // Release wrapper before calling back, as callback may submit new I/O
+  uint64_t id = wrapper->id;
+  auto func = std::move(wrapper->bioCallback);
+
+  wrapper->bioCallback = nullptr;
+  freeWrapper.push_back(wrapper);
+
+  func(id);
 
   delete prp;
-  delete wrapper;
 }
 
 void Driver::initStats(std::vector<SimpleSSD::Stats> &list) {
@@ -24,6 +24,7 @@
 
 #include <list>
 #include <queue>
+#include <vector>
 
 #include "bil/interface.hh"
 #include "sil/nvme/prp.hh"
@@ -110,6 +111,8 @@ class Driver : public BIL::DriverInterface, SimpleSSD::HIL::NVMe::Interface {
   Queue *ioSQ;
   Queue *ioCQ;
   std::list<CommandEntry> pendingCommandList;
+  ResponseHandler ioHandler;
+  std::vector<IOWrapper *> freeWrapper;  // Completed, reused by next I/O
 
   void dmaReadDone();
   void submitDMARead();
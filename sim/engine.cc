@@ -19,6 +19,8 @@
 
 #include "sim/engine.hh"
 
+#include "sim/heap_event_queue.hh"
+#include "sim/list_event_queue.hh"
 #include "simplessd/sim/trace.hh"
 
 Engine::Engine()
@@ -26,80 +28,31 @@ Engine::Engine()
       simTick(0),
       counter(0),
       forceStop(false),
-      eventHandled(0) {
+      pEventQueue(nullptr),
+      eventHandled(0),
+      maxQueueDepth(0) {
   watch.start();
 }
 
-Engine::~Engine() {}
-
-bool Engine::insertEvent(SimpleSSD::Event eid, uint64_t tick,
-                         uint64_t *pOldTick) {
-  bool found = false;
-  bool flag = false;
-  auto old = eventQueue.begin();
-  auto insert = eventQueue.end();
-
-  for (auto iter = eventQueue.begin(); iter != eventQueue.end(); iter++) {
-    if (iter->first == eid) {
-      found = true;
-      old = iter;
-
-      if (pOldTick) {
-        *pOldTick = iter->second;
-      }
-    }
-
-    if (iter->second > tick && !flag) {
-      insert = iter;
-      flag = true;
-    }
-  }
-
-  if (found && pOldTick) {
-    if (*pOldTick == tick) {
-      // Rescheduling to same tick. Ignore.
-      return false;
-    }
-  }
-
-  // Iterator will not invalidated on insert
-  // Do insert first
-  eventQueue.insert(insert, {eid, tick});
-
-  if (found) {
-    eventQueue.erase(old);
-  }
-
-  return found;
+Engine::~Engine() {
+  delete pEventQueue;
 }
 
-bool Engine::removeEvent(SimpleSSD::Event eid) {
-  bool found = false;
-
-  for (auto iter = eventQueue.begin(); iter != eventQueue.end(); iter++) {
-    if (iter->first == eid) {
-      eventQueue.erase(iter);
-      found = true;
+void Engine::init(ConfigReader &conf) {
+  switch (conf.readUint(CONFIG_GLOBAL, GLOBAL_EVENT_QUEUE)) {
+    case EVENT_QUEUE_LIST:
+      pEventQueue = new ListEventQueue();
 
       break;
-    }
-  }
+    case EVENT_QUEUE_HEAP:
+      pEventQueue = new HeapEventQueue();
 
-  return found;
-}
-
-bool Engine::isEventExist(SimpleSSD::Event eid, uint64_t *pTick) {
-  for (auto &iter : eventQueue) {
-    if (iter.first == eid) {
-      if (pTick) {
-        *pTick = iter.second;
-      }
+      break;
+    default:
+      SimpleSSD::panic("Invalid event queue specified");
 
-      return true;
-    }
+      break;
   }
-
-  return false;
 }
 
 uint64_t Engine::getCurrentTick() {
@@ -139,11 +92,15 @@ void Engine::scheduleEvent(SimpleSSD::Event eid, uint64_t tick) {
 
     uint64_t oldTick;
 
-    if (insertEvent(eid, tick, &oldTick)) {
+    if (pEventQueue->insert(eid, tick, &oldTick)) {
       SimpleSSD::warn("Event %" PRIu64 " rescheduled from %" PRIu64
                       " to %" PRIu64,
                       eid, oldTick, tick);
     }
+
+    if (maxQueueDepth < pEventQueue->size()) {
+      maxQueueDepth = pEventQueue->size();
+    }
   }
   else {
     SimpleSSD::panic("Event %" PRIu64 " does not exists", eid);
@@ -154,7 +111,7 @@ void Engine::descheduleEvent(SimpleSSD::Event eid) {
   auto iter = eventList.find(eid);
 
   if (iter != eventList.end()) {
-    removeEvent(eid);
+    pEventQueue->remove(eid);
   }
   else {
     SimpleSSD::panic("Event %" PRIu64 " does not exists", eid);
@@ -166,7 +123,7 @@ bool Engine::isScheduled(SimpleSSD::Event eid, uint64_t *pTick) {
   auto iter = eventList.find(eid);
 
   if (iter != eventList.end()) {
-    ret = isEventExist(eid, pTick);
+    ret = pEventQueue->exist(eid, pTick);
   }
   else {
     SimpleSSD::panic("Event %" PRIu64 " does not exists", eid);
@@ -179,7 +136,7 @@ void Engine::deallocateEvent(SimpleSSD::Event eid) {
   auto iter = eventList.find(eid);
 
   if (iter != eventList.end()) {
-    removeEvent(eid);
+    pEventQueue->remove(eid);
     eventList.erase(iter);
   }
   else {
@@ -194,25 +151,22 @@ bool Engine::doNextEvent() {
     return false;
   }
 
-  if (eventQueue.size() > 0) {
-    auto &now = eventQueue.front();
+  SimpleSSD::Event eid;
 
+  if (pEventQueue->pop(eid, tickCopy)) {
     {
       std::lock_guard<std::mutex> guard(mTick);
 
-      simTick = now.second;
-      tickCopy = simTick;
+      simTick = tickCopy;
     }
 
-    auto iter = eventList.find(now.first);
-
-    eventQueue.pop_front();
+    auto iter = eventList.find(eid);
 
     if (iter != eventList.end()) {
       iter->second(tickCopy);
     }
     else {
-      SimpleSSD::panic("Event %" PRIu64 " does not exists", now.first);
+      SimpleSSD::panic("Event %" PRIu64 " does not exists", eid);
     }
 
     {
@@ -244,6 +198,7 @@ void Engine::printStats(std::ostream &out) {
   out << "Host time duration (sec): " << std::to_string(duration) << std::endl;
   out << "Event handled: " << eventHandled << " ("
       << std::to_string(eventHandled / duration) << " ops)" << std::endl;
+  out << "Max. event queue depth: " << maxQueueDepth << std::endl;
   out << "*** End of statistics ***" << std::endl;
 }
 
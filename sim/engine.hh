@@ -23,11 +23,12 @@
 #define __SIM_ENGINE__
 
 #include <iostream>
-#include <list>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
 
+#include "sim/cfg_reader.hh"
+#include "sim/event_queue.hh"
 #include "simplessd/sim/simulator.hh"
 #include "util/stopwatch.hh"
 
@@ -38,21 +39,20 @@ class Engine : public SimpleSSD::Simulator {
   SimpleSSD::Event counter;
   bool forceStop;
   std::unordered_map<SimpleSSD::Event, SimpleSSD::EventFunction> eventList;
-  std::list<std::pair<SimpleSSD::Event, uint64_t>> eventQueue;
+  EventQueue *pEventQueue;
 
   Stopwatch watch;
 
   std::mutex m;
   uint64_t eventHandled;
-
-  bool insertEvent(SimpleSSD::Event, uint64_t, uint64_t * = nullptr);
-  bool removeEvent(SimpleSSD::Event);
-  bool isEventExist(SimpleSSD::Event, uint64_t * = nullptr);
+  uint64_t maxQueueDepth;
 
  public:
   Engine();
   ~Engine();
 
+  void init(ConfigReader &);
+
   uint64_t getCurrentTick() override;
 
   SimpleSSD::Event allocateEvent(SimpleSSD::EventFunction) override;
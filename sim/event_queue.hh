@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __SIM_EVENT_QUEUE__
+#define __SIM_EVENT_QUEUE__
+
+#include <cinttypes>
+
+#include "simplessd/sim/simulator.hh"
+
+class EventQueue {
+ public:
+  EventQueue() {}
+  virtual ~EventQueue() {}
+
+  // Insert event at tick. If event is already scheduled, it is moved to the
+  // new tick (behind all events at that tick) and true is returned.
+  // Rescheduling to the same tick keeps current position and returns false.
+  virtual bool insert(SimpleSSD::Event, uint64_t, uint64_t * = nullptr) = 0;
+  virtual bool remove(SimpleSSD::Event) = 0;
+  virtual bool exist(SimpleSSD::Event, uint64_t * = nullptr) = 0;
+
+  // Pop earliest event. Events at same tick are popped in FIFO order
+  virtual bool pop(SimpleSSD::Event &, uint64_t &) = 0;
+  virtual uint64_t size() = 0;
+};
+
+#endif
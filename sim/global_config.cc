@@ -28,18 +28,35 @@ const char NAME_LOG_PERIOD[] = "LogPeriod";
 const char NAME_LOG_FILE[] = "LogFile";
 const char NAME_DEBUG_LOG_FILE[] = "DebugLogFile";
 const char NAME_LATENCY_LOG_FILE[] = "LatencyLogFile";
+const char NAME_LATENCY_LOG_FORMAT[] = "LatencyLogFormat";
+const char NAME_LATENCY_HISTOGRAM_FILE[] = "LatencyHistogramFile";
 const char NAME_PROGRESS_PERIOD[] = "ProgressPeriod";
 const char NAME_INTERFACE[] = "Interface";
 const char NAME_SCHEDULER[] = "Scheduler";
 const char NAME_SUBMISSION_LATENCY[] = "SubmissionLatency";
 const char NAME_COMPLETION_LATENCY[] = "CompletionLatency";
+const char NAME_EVENT_QUEUE[] = "EventQueue";
+const char NAME_SCHEDULER_QUEUE_DEPTH[] = "SchedulerQueueDepth";
+const char NAME_SCHEDULER_READ_EXPIRE[] = "ReadExpire";
+const char NAME_SCHEDULER_WRITE_EXPIRE[] = "WriteExpire";
+const char NAME_SCHEDULER_FIFO_BATCH[] = "FIFOBatch";
+const char NAME_SCHEDULER_WRITES_STARVED[] = "WritesStarved";
+const char NAME_SCHEDULER_MAX_MERGE_SIZE[] = "MaxMergeSize";
 
 Config::Config() {
   mode = MODE_REQUEST_GENERATOR;
   logPeriod = 0;
+  latencyFormat = LATENCY_LOG_TEXT;
   progressPeriod = 0;
   interface = INTERFACE_NVME;
   scheduler = SCHEDULER_NOOP;
+  eventQueue = EVENT_QUEUE_HEAP;
+  schedulerQueueDepth = 32;
+  readExpire = 500000000000;    // 500ms
+  writeExpire = 5000000000000;  // 5s
+  fifoBatch = 16;
+  writesStarved = 2;
+  maxMergeSize = 524288;
 }
 
 bool Config::setConfig(const char *name, const char *value) {
@@ -63,6 +80,12 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_LATENCY_LOG_FILE)) {
     latencyFile = value;
   }
+  else if (MATCH_NAME(NAME_LATENCY_LOG_FORMAT)) {
+    latencyFormat = (LATENCY_LOG_FORMAT)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_LATENCY_HISTOGRAM_FILE)) {
+    histogramFile = value;
+  }
   else if (MATCH_NAME(NAME_PROGRESS_PERIOD)) {
     progressPeriod = strtoul(value, nullptr, 10);
   }
@@ -78,6 +101,27 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_COMPLETION_LATENCY)) {
     completionLatency = convertTime(value);
   }
+  else if (MATCH_NAME(NAME_EVENT_QUEUE)) {
+    eventQueue = (EVENT_QUEUE)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER_QUEUE_DEPTH)) {
+    schedulerQueueDepth = convertInteger(value);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER_READ_EXPIRE)) {
+    readExpire = convertTime(value);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER_WRITE_EXPIRE)) {
+    writeExpire = convertTime(value);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER_FIFO_BATCH)) {
+    fifoBatch = convertInteger(value);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER_WRITES_STARVED)) {
+    writesStarved = convertInteger(value);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER_MAX_MERGE_SIZE)) {
+    maxMergeSize = convertInteger(value);
+  }
   else {
     ret = false;
   }
@@ -92,6 +136,21 @@ void Config::update() {
   if (interface >= INTERFACE_NUM) {
     SimpleSSD::panic("Invalid interface");
   }
+  if (latencyFormat >= LATENCY_LOG_NUM) {
+    SimpleSSD::panic("Invalid latency log format");
+  }
+  if (eventQueue >= EVENT_QUEUE_NUM) {
+    SimpleSSD::panic("Invalid event queue");
+  }
+  if (scheduler >= SCHEDULER_NUM) {
+    SimpleSSD::panic("Invalid I/O scheduler");
+  }
+  if (schedulerQueueDepth == 0) {
+    SimpleSSD::panic("Scheduler queue depth should be larger than 0");
+  }
+  if (fifoBatch == 0) {
+    SimpleSSD::panic("FIFO batch should be larger than 0");
+  }
 }
 
 uint64_t Config::readUint(uint32_t idx) {
@@ -104,6 +163,9 @@ uint64_t Config::readUint(uint32_t idx) {
     case GLOBAL_LOG_PERIOD:
       ret = logPeriod;
       break;
+    case GLOBAL_LATENCY_LOG_FORMAT:
+      ret = latencyFormat;
+      break;
     case GLOBAL_PROGRESS_PERIOD:
       ret = progressPeriod;
       break;
@@ -119,6 +181,27 @@ uint64_t Config::readUint(uint32_t idx) {
     case GLOBAL_COMPLETION_LATENCY:
       ret = completionLatency;
       break;
+    case GLOBAL_EVENT_QUEUE:
+      ret = eventQueue;
+      break;
+    case GLOBAL_SCHEDULER_QUEUE_DEPTH:
+      ret = schedulerQueueDepth;
+      break;
+    case GLOBAL_SCHEDULER_READ_EXPIRE:
+      ret = readExpire;
+      break;
+    case GLOBAL_SCHEDULER_WRITE_EXPIRE:
+      ret = writeExpire;
+      break;
+    case GLOBAL_SCHEDULER_FIFO_BATCH:
+      ret = fifoBatch;
+      break;
+    case GLOBAL_SCHEDULER_WRITES_STARVED:
+      ret = writesStarved;
+      break;
+    case GLOBAL_SCHEDULER_MAX_MERGE_SIZE:
+      ret = maxMergeSize;
+      break;
   }
 
   return ret;
@@ -140,6 +223,9 @@ std::string Config::readString(uint32_t idx) {
     case GLOBAL_LATENCY_LOG_FILE:
       ret = latencyFile;
       break;
+    case GLOBAL_LATENCY_HISTOGRAM_FILE:
+      ret = histogramFile;
+      break;
   }
 
   return ret;
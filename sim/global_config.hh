@@ -31,11 +31,20 @@ typedef enum {
   GLOBAL_LOG_FILE,
   GLOBAL_DEBUG_LOG_FILE,
   GLOBAL_LATENCY_LOG_FILE,
+  GLOBAL_LATENCY_LOG_FORMAT,
+  GLOBAL_LATENCY_HISTOGRAM_FILE,
   GLOBAL_PROGRESS_PERIOD,
   GLOBAL_INTERFACE,
   GLOBAL_SCHEDULER,
   GLOBAL_SUBMISSION_LATENCY,
   GLOBAL_COMPLETION_LATENCY,
+  GLOBAL_EVENT_QUEUE,
+  GLOBAL_SCHEDULER_QUEUE_DEPTH,
+  GLOBAL_SCHEDULER_READ_EXPIRE,
+  GLOBAL_SCHEDULER_WRITE_EXPIRE,
+  GLOBAL_SCHEDULER_FIFO_BATCH,
+  GLOBAL_SCHEDULER_WRITES_STARVED,
+  GLOBAL_SCHEDULER_MAX_MERGE_SIZE,
 } GLOBAL_CONFIG;
 
 typedef enum {
@@ -54,9 +63,23 @@ typedef enum {
 
 typedef enum {
   SCHEDULER_NOOP,
+  SCHEDULER_DEADLINE,
+  SCHEDULER_MQ_DEADLINE,
   SCHEDULER_NUM,
 } SCHEDULER;
 
+typedef enum {
+  LATENCY_LOG_TEXT,
+  LATENCY_LOG_BINARY,
+  LATENCY_LOG_NUM,
+} LATENCY_LOG_FORMAT;
+
+typedef enum {
+  EVENT_QUEUE_LIST,
+  EVENT_QUEUE_HEAP,
+  EVENT_QUEUE_NUM,
+} EVENT_QUEUE;
+
 class Config : public SimpleSSD::BaseConfig {
  private:
   std::string baseConfig;
@@ -65,11 +88,20 @@ class Config : public SimpleSSD::BaseConfig {
   std::string logFile;
   std::string logDebugFile;
   std::string latencyFile;
+  LATENCY_LOG_FORMAT latencyFormat;
+  std::string histogramFile;
   uint64_t progressPeriod;
   INTERFACE interface;
   SCHEDULER scheduler;
   uint64_t submissionLatency;
   uint64_t completionLatency;
+  EVENT_QUEUE eventQueue;
+  uint64_t schedulerQueueDepth;
+  uint64_t readExpire;
+  uint64_t writeExpire;
+  uint64_t fifoBatch;
+  uint64_t writesStarved;
+  uint64_t maxMergeSize;
 
  public:
   Config();
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sim/heap_event_queue.hh"
+
+#include <limits>
+
+static const uint64_t NOT_SCHEDULED = std::numeric_limits<uint64_t>::max();
+
+HeapEventQueue::HeapEventQueue() : EventQueue(), sequence(0) {}
+
+HeapEventQueue::~HeapEventQueue() {}
+
+uint64_t *HeapEventQueue::getSlot(SimpleSSD::Event eid) {
+  // Event IDs are allocated sequentially by Engine, so a flat table is enough
+  if (eid >= slotOf.size()) {
+    slotOf.resize(eid + 1, NOT_SCHEDULED);
+  }
+
+  return &slotOf[eid];
+}
+
+void HeapEventQueue::place(uint64_t idx, Entry &entry) {
+  heap[idx] = entry;
+  slotOf[entry.eid] = idx;
+}
+
+void HeapEventQueue::siftUp(uint64_t idx) {
+  Entry entry = heap[idx];
+
+  while (idx > 0) {
+    uint64_t parent = (idx - 1) / 2;
+
+    if (!less(entry, heap[parent])) {
+      break;
+    }
+
+    place(idx, heap[parent]);
+    idx = parent;
+  }
+
+  place(idx, entry);
+}
+
+void HeapEventQueue::siftDown(uint64_t idx) {
+  Entry entry = heap[idx];
+  uint64_t count = heap.size();
+
+  while (true) {
+    uint64_t child = idx * 2 + 1;
+
+    if (child >= count) {
+      break;
+    }
+
+    if (child + 1 < count && less(heap[child + 1], heap[child])) {
+      child++;
+    }
+
+    if (!less(heap[child], entry)) {
+      break;
+    }
+
+    place(idx, heap[child]);
+    idx = child;
+  }
+
+  place(idx, entry);
+}
+
+void HeapEventQueue::erase(uint64_t idx) {
+  uint64_t last = heap.size() - 1;
+
+  slotOf[heap[idx].eid] = NOT_SCHEDULED;
+
+  if (idx != last) {
+    place(idx, heap[last]);
+    heap.pop_back();
+
+    if (idx > 0 && less(heap[idx], heap[(idx - 1) / 2])) {
+      siftUp(idx);
+    }
+    else {
+      siftDown(idx);
+    }
+  }
+  else {
+    heap.pop_back();
+  }
+}
+
+bool HeapEventQueue::insert(SimpleSSD::Event eid, uint64_t tick,
+                            uint64_t *pOldTick) {
+  uint64_t *pSlot = getSlot(eid);
+
+  if (*pSlot != NOT_SCHEDULED) {
+    Entry &entry = heap[*pSlot];
+    uint64_t oldTick = entry.tick;
+
+    if (pOldTick) {
+      *pOldTick = oldTick;
+
+      if (oldTick == tick) {
+        // Rescheduling to same tick. Ignore.
+        return false;
+      }
+    }
+
+    // Move behind all events at new tick
+    entry.tick = tick;
+    entry.seq = sequence++;
+
+    if (tick < oldTick) {
+      siftUp(*pSlot);
+    }
+    else {
+      siftDown(*pSlot);
+    }
+
+    return true;
+  }
+
+  heap.emplace_back(tick, sequence++, eid);
+  *pSlot = heap.size() - 1;
+
+  siftUp(*pSlot);
+
+  return false;
+}
+
+bool HeapEventQueue::remove(SimpleSSD::Event eid) {
+  if (eid < slotOf.size() && slotOf[eid] != NOT_SCHEDULED) {
+    erase(slotOf[eid]);
+
+    return true;
+  }
+
+  return false;
+}
+
+bool HeapEventQueue::exist(SimpleSSD::Event eid, uint64_t *pTick) {
+  if (eid < slotOf.size() && slotOf[eid] != NOT_SCHEDULED) {
+    if (pTick) {
+      *pTick = heap[slotOf[eid]].tick;
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+bool HeapEventQueue::pop(SimpleSSD::Event &eid, uint64_t &tick) {
+  if (heap.size() > 0) {
+    eid = heap.front().eid;
+    tick = heap.front().tick;
+
+    erase(0);
+
+    return true;
+  }
+
+  return false;
+}
+
+uint64_t HeapEventQueue::size() {
+  return heap.size();
+}
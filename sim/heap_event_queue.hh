@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __SIM_HEAP_EVENT_QUEUE__
+#define __SIM_HEAP_EVENT_QUEUE__
+
+#include <vector>
+
+#include "sim/event_queue.hh"
+
+/**
+ * Indexed binary min-heap ordered by (tick, sequence number)
+ *
+ * Sequence number increases on every insert, so events with same tick are
+ * popped in FIFO order as ListEventQueue does. slotOf maps event ID to its
+ * position in the heap, making lookup O(1) and (re)schedule O(log n).
+ */
+class HeapEventQueue : public EventQueue {
+ private:
+  typedef struct _Entry {
+    uint64_t tick;
+    uint64_t seq;
+    SimpleSSD::Event eid;
+
+    _Entry(uint64_t t, uint64_t s, SimpleSSD::Event e)
+        : tick(t), seq(s), eid(e) {}
+  } Entry;
+
+  std::vector<Entry> heap;
+  std::vector<uint64_t> slotOf;
+  uint64_t sequence;
+
+  inline bool less(const Entry &a, const Entry &b) {
+    return a.tick < b.tick || (a.tick == b.tick && a.seq < b.seq);
+  }
+
+  uint64_t *getSlot(SimpleSSD::Event);
+  void place(uint64_t, Entry &);
+  void siftUp(uint64_t);
+  void siftDown(uint64_t);
+  void erase(uint64_t);
+
+ public:
+  HeapEventQueue();
+  ~HeapEventQueue();
+
+  bool insert(SimpleSSD::Event, uint64_t, uint64_t * = nullptr) override;
+  bool remove(SimpleSSD::Event) override;
+  bool exist(SimpleSSD::Event, uint64_t * = nullptr) override;
+
+  bool pop(SimpleSSD::Event &, uint64_t &) override;
+  uint64_t size() override;
+};
+
+#endif
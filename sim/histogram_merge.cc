@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "util/histogram.hh"
+
+const uint32_t percentileCount = 5;
+const double percentileList[percentileCount] = {50.0, 90.0, 99.0, 99.9,
+                                                99.99};
+
+int main(int argc, char *argv[]) {
+  std::vector<std::string> names;
+  std::vector<Histogram> merged;
+
+  std::cout << "SimpleSSD Latency Histogram Merger" << std::endl;
+
+  // Check argument
+  if (argc < 3) {
+    std::cerr << " Invalid number of argument!" << std::endl;
+    std::cerr << "  Usage: histogram-merge <Output file> <Input file> "
+                 "[<Input file> ...]"
+              << std::endl;
+
+    return 1;
+  }
+
+  for (int i = 2; i < argc; i++) {
+    std::ifstream in(argv[i], std::ios::binary);
+    std::vector<std::string> inNames;
+    std::vector<Histogram> inList;
+
+    if (!in.is_open()) {
+      std::cerr << " Failed to open input file: " << argv[i] << std::endl;
+
+      return 2;
+    }
+
+    if (!loadHistograms(in, inNames, inList)) {
+      std::cerr << " Invalid histogram file: " << argv[i] << std::endl;
+
+      return 2;
+    }
+
+    if (i == 2) {
+      names = inNames;
+      merged = inList;
+
+      continue;
+    }
+
+    if (inNames != names) {
+      std::cerr << " Histogram list mismatch: " << argv[i] << std::endl;
+
+      return 2;
+    }
+
+    for (uint32_t j = 0; j < merged.size(); j++) {
+      merged[j].merge(inList[j]);
+    }
+  }
+
+  std::ofstream out(argv[1], std::ios::binary);
+  std::vector<const Histogram *> list;
+
+  if (!out.is_open()) {
+    std::cerr << " Failed to open output file: " << argv[1] << std::endl;
+
+    return 3;
+  }
+
+  for (auto &iter : merged) {
+    list.push_back(&iter);
+  }
+
+  if (!saveHistograms(out, names, list)) {
+    std::cerr << " Failed to write output file: " << argv[1] << std::endl;
+
+    return 4;
+  }
+
+  std::cout << "Merged " << argc - 2 << " files to " << argv[1] << std::endl;
+
+  for (uint32_t i = 0; i < merged.size(); i++) {
+    Histogram &hist = merged[i];
+
+    if (hist.getCount() == 0) {
+      continue;
+    }
+
+    std::cout << " " << names[i] << " (ps): count=" << hist.getCount()
+              << ", min=" << hist.getMin()
+              << ", avg=" << std::to_string(hist.getMean());
+
+    for (uint32_t j = 0; j < percentileCount; j++) {
+      std::cout << ", p" << percentileList[j] << "="
+                << hist.getPercentile(percentileList[j]);
+    }
+
+    std::cout << ", max=" << hist.getMax() << std::endl;
+  }
+
+  return 0;
+}
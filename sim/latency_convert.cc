@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bil/latency_log.hh"
+
+const char *typeName[BIL::BIO_NUM] = {"read", "write", "flush", "trim"};
+
+int main(int argc, char *argv[]) {
+  std::cout << "SimpleSSD Latency Log Converter" << std::endl;
+
+  // Check argument
+  if (argc != 3) {
+    std::cerr << " Invalid number of argument!" << std::endl;
+    std::cerr << "  Usage: latency-convert <Binary latency log> <Output CSV "
+                 "file>"
+              << std::endl;
+
+    return 1;
+  }
+
+  std::ifstream in(argv[1], std::ios::binary);
+
+  if (!in.is_open()) {
+    std::cerr << " Failed to open input file: " << argv[1] << std::endl;
+
+    return 2;
+  }
+
+  BIL::LatencyLogHeader header;
+
+  in.read((char *)&header, sizeof(header));
+
+  if (!in.good() ||
+      memcmp(header.magic, LATENCY_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != LATENCY_LOG_VERSION ||
+      header.recordSize != sizeof(BIL::LatencyLogRecord)) {
+    std::cerr << " Invalid latency log file: " << argv[1] << std::endl;
+
+    return 2;
+  }
+
+  std::ofstream out(argv[2]);
+
+  if (!out.is_open()) {
+    std::cerr << " Failed to open output file: " << argv[2] << std::endl;
+
+    return 3;
+  }
+
+  std::vector<BIL::LatencyLogRecord> buffer(LATENCY_LOG_BATCH);
+  std::string text;
+  uint64_t count = 0;
+
+  out << "id,offset,length,type,submitted,latency\n";
+
+  while (in.good()) {
+    in.read((char *)buffer.data(),
+            buffer.size() * sizeof(BIL::LatencyLogRecord));
+
+    uint64_t read = in.gcount() / sizeof(BIL::LatencyLogRecord);
+
+    text.clear();
+
+    for (uint64_t i = 0; i < read; i++) {
+      BIL::LatencyLogRecord &record = buffer[i];
+
+      text += std::to_string(record.id);
+      text += ',';
+      text += std::to_string(record.offset);
+      text += ',';
+      text += std::to_string(record.length);
+      text += ',';
+      text += record.type < BIL::BIO_NUM ? typeName[record.type] : "unknown";
+      text += ',';
+      text += std::to_string(record.submittedAt);
+      text += ',';
+      text += std::to_string(record.latency);
+      text += '\n';
+    }
+
+    out.write(text.data(), text.length());
+    count += read;
+  }
+
+  if (!out.good()) {
+    std::cerr << " Failed to write output file: " << argv[2] << std::endl;
+
+    return 4;
+  }
+
+  std::cout << "Converted " << count << " records to " << argv[2] << std::endl;
+
+  return 0;
+}
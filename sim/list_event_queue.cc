@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sim/list_event_queue.hh"
+
+ListEventQueue::ListEventQueue() : EventQueue() {}
+
+ListEventQueue::~ListEventQueue() {}
+
+bool ListEventQueue::insert(SimpleSSD::Event eid, uint64_t tick,
+                            uint64_t *pOldTick) {
+  bool found = false;
+  bool flag = false;
+  auto old = eventQueue.begin();
+  auto insert = eventQueue.end();
+
+  for (auto iter = eventQueue.begin(); iter != eventQueue.end(); iter++) {
+    if (iter->first == eid) {
+      found = true;
+      old = iter;
+
+      if (pOldTick) {
+        *pOldTick = iter->second;
+      }
+    }
+
+    if (iter->second > tick && !flag) {
+      insert = iter;
+      flag = true;
+    }
+  }
+
+  if (found && pOldTick) {
+    if (*pOldTick == tick) {
+      // Rescheduling to same tick. Ignore.
+      return false;
+    }
+  }
+
+  // Iterator will not invalidated on insert
+  // Do insert first
+  eventQueue.insert(insert, {eid, tick});
+
+  if (found) {
+    eventQueue.erase(old);
+  }
+
+  return found;
+}
+
+bool ListEventQueue::remove(SimpleSSD::Event eid) {
+  bool found = false;
+
+  for (auto iter = eventQueue.begin(); iter != eventQueue.end(); iter++) {
+    if (iter->first == eid) {
+      eventQueue.erase(iter);
+      found = true;
+
+      break;
+    }
+  }
+
+  return found;
+}
+
+bool ListEventQueue::exist(SimpleSSD::Event eid, uint64_t *pTick) {
+  for (auto &iter : eventQueue) {
+    if (iter.first == eid) {
+      if (pTick) {
+        *pTick = iter.second;
+      }
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool ListEventQueue::pop(SimpleSSD::Event &eid, uint64_t &tick) {
+  if (eventQueue.size() > 0) {
+    auto &now = eventQueue.front();
+
+    eid = now.first;
+    tick = now.second;
+
+    eventQueue.pop_front();
+
+    return true;
+  }
+
+  return false;
+}
+
+uint64_t ListEventQueue::size() {
+  return eventQueue.size();
+}
@@ -19,16 +19,27 @@
 
 #pragma once
 
-#ifndef __SIM_LOG__
-#define __SIM_LOG__
+#ifndef __SIM_LIST_EVENT_QUEUE__
+#define __SIM_LIST_EVENT_QUEUE__
 
-#include <iostream>
+#include <list>
 
-namespace SimpleSSD {
+#include "sim/event_queue.hh"
 
-void initLogSystem(std::ostream *, std::ostream *);
-void destroyLogSystem();
+class ListEventQueue : public EventQueue {
+ private:
+  std::list<std::pair<SimpleSSD::Event, uint64_t>> eventQueue;
 
-}  // namespace SimpleSSD
+ public:
+  ListEventQueue();
+  ~ListEventQueue();
+
+  bool insert(SimpleSSD::Event, uint64_t, uint64_t * = nullptr) override;
+  bool remove(SimpleSSD::Event) override;
+  bool exist(SimpleSSD::Event, uint64_t * = nullptr) override;
+
+  bool pop(SimpleSSD::Event &, uint64_t &) override;
+  uint64_t size() override;
+};
 
 #endif
@@ -17,56 +17,22 @@
  * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
-#include "bil/entry.hh"
-#include "igl/request/request_generator.hh"
-#include "igl/trace/trace_replayer.hh"
-#include "sil/none/none.hh"
-#include "sil/nvme/nvme.hh"
-#include "sim/engine.hh"
 #include "sim/signal.hh"
-#include "simplessd/util/simplessd.hh"
-#include "util/print.hh"
+#include "sim/simulation.hh"
 
 // Global objects
-Engine engine;
-ConfigReader simConfig;
-BIL::DriverInterface *pInterface = nullptr;
-BIL::BlockIOEntry *pBIOEntry = nullptr;
-IGL::IOGenerator *pIOGen = nullptr;
-std::ostream *pLog = nullptr;
-std::ostream *pDebugLog = nullptr;
-std::ostream *pLatencyFile = nullptr;
+Simulation *pSimulation = nullptr;
 std::thread *pThread = nullptr;
 std::mutex killLock;
-SimpleSSD::Event statEvent;
-std::vector<SimpleSSD::Stats> statList;
-std::ofstream logOut;
-std::ofstream debugLogOut;
-std::ofstream latencyFile;
 
 // Declaration
 void cleanup(int);
-void statistics(uint64_t);
 void threadFunc(int);
 
-void joinPath(std::string &lhs, std::string &rhs) {
-  if (rhs.front() == '/') {
-    // Assume absolute path
-    lhs = rhs;
-  }
-  else if (lhs.back() == '/') {
-    lhs += rhs;
-  }
-  else {
-    lhs += '/';
-    lhs += rhs;
-  }
-}
-
 int main(int argc, char *argv[]) {
   std::cout << "SimpleSSD Standalone v2.0" << std::endl;
 
@@ -83,177 +49,28 @@ int main(int argc, char *argv[]) {
   // Install signal handler
   installSignalHandler(cleanup);
 
-  // Read simulation config file
-  if (!simConfig.init(argv[1])) {
-    std::cerr << " Failed to open simulation configuration file!" << std::endl;
-
-    return 2;
-  }
-
-  // Log setting
-  bool noLogPrintOnScreen = true;
-
-  std::string logPath = simConfig.readString(CONFIG_GLOBAL, GLOBAL_LOG_FILE);
-  std::string debugLogPath =
-      simConfig.readString(CONFIG_GLOBAL, GLOBAL_DEBUG_LOG_FILE);
-  std::string latencyLogPath =
-      simConfig.readString(CONFIG_GLOBAL, GLOBAL_LATENCY_LOG_FILE);
-
-  if (logPath.compare("STDOUT") == 0) {
-    noLogPrintOnScreen = false;
-    pLog = &std::cout;
-  }
-  else if (logPath.compare("STDERR") == 0) {
-    noLogPrintOnScreen = false;
-    pLog = &std::cerr;
-  }
-  else if (logPath.length() != 0) {
-    std::string full(argv[3]);
-
-    joinPath(full, logPath);
-    logOut.open(full);
-
-    if (!logOut.is_open()) {
-      std::cerr << " Failed to open log file: " << full << std::endl;
-
-      return 3;
-    }
-
-    pLog = &logOut;
-  }
-
-  if (debugLogPath.compare("STDOUT") == 0) {
-    noLogPrintOnScreen = false;
-    pDebugLog = &std::cout;
-  }
-  else if (debugLogPath.compare("STDERR") == 0) {
-    noLogPrintOnScreen = false;
-    pDebugLog = &std::cerr;
-  }
-  else if (debugLogPath.length() != 0) {
-    std::string full(argv[3]);
-
-    joinPath(full, debugLogPath);
-    debugLogOut.open(full);
-
-    if (!debugLogOut.is_open()) {
-      std::cerr << " Failed to open log file: " << full << std::endl;
-
-      return 3;
-    }
-
-    pDebugLog = &debugLogOut;
-  }
-
-  if (latencyLogPath.length() != 0) {
-    std::string full(argv[3]);
-
-    joinPath(full, latencyLogPath);
-    latencyFile.open(full);
-
-    if (!latencyFile.is_open()) {
-      std::cerr << " Failed to open log file: " << full << std::endl;
-
-      return 3;
-    }
-
-    pLatencyFile = &latencyFile;
-  }
-
-  // Initialize SimpleSSD
-  auto ssdConfig = initSimpleSSDEngine(&engine, pDebugLog, pDebugLog, argv[2]);
-
-  // Create Driver
-  switch (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_INTERFACE)) {
-    case INTERFACE_NONE:
-      pInterface = new SIL::None::Driver(engine, ssdConfig);
-
-      break;
-    case INTERFACE_NVME:
-      pInterface = new SIL::NVMe::Driver(engine, ssdConfig);
+  // Initialize simulation
+  pSimulation = new Simulation();
 
-      break;
-    default:
-      std::cerr << " Undefined interface specified." << std::endl;
+  int ret = pSimulation->init(argv[1], argv[2], argv[3]);
 
-      return 4;
-  }
-
-  // Create Block I/O Layer
-  pBIOEntry =
-      new BIL::BlockIOEntry(simConfig, engine, pInterface, pLatencyFile);
-
-  std::function<void()> endCallback = []() {
-    // If stat printout is scheduled, delete it
-    if (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) > 0) {
-      engine.descheduleEvent(statEvent);
-    }
-
-    // Stop simulation
-    engine.stopEngine();
-  };
-
-  // Create I/O generator
-  switch (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_SIM_MODE)) {
-    case MODE_REQUEST_GENERATOR:
-      pIOGen =
-          new IGL::RequestGenerator(engine, *pBIOEntry, endCallback, simConfig);
-
-      break;
-    case MODE_TRACE_REPLAYER:
-      pIOGen =
-          new IGL::TraceReplayer(engine, *pBIOEntry, endCallback, simConfig);
-
-      break;
-    default:
-      std::cerr << " Undefined simulation mode specified." << std::endl;
-
-      cleanup(0);
-
-      return 5;
-  }
-
-  std::function<void()> beginCallback = []() {
-    uint64_t bytesize;
-    uint32_t bs;
-
-    pInterface->getInfo(bytesize, bs);
-    pIOGen->init(bytesize, bs);
-    pIOGen->begin();
-  };
-
-  // Insert stat event
-  pInterface->initStats(statList);
-
-  if (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) > 0) {
-    statEvent = engine.allocateEvent([](uint64_t tick) {
-      statistics(tick);
-
-      engine.scheduleEvent(
-          statEvent,
-          tick + simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) *
-                     1000000000ULL);
-    });
-    engine.scheduleEvent(
-        statEvent,
-        simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) * 1000000000ULL);
+  if (ret != 0) {
+    return ret;
   }
 
   // Do Simulation
   std::cout << "********** Begin of simulation **********" << std::endl;
 
-  pInterface->init(beginCallback);
-
-  if (noLogPrintOnScreen) {
-    int period = (int)simConfig.readUint(CONFIG_GLOBAL, GLOBAL_PROGRESS_PERIOD);
+  if (!pSimulation->isLogOnScreen()) {
+    int period = (int)pSimulation->getConfig().readUint(CONFIG_GLOBAL,
+                                                        GLOBAL_PROGRESS_PERIOD);
 
     if (period > 0) {
       pThread = new std::thread(threadFunc, period);
     }
   }
 
-  while (engine.doNextEvent())
-    ;
+  pSimulation->run();
 
   cleanup(0);
 
@@ -261,46 +78,32 @@ int main(int argc, char *argv[]) {
 }
 
 void cleanup(int) {
-  uint64_t tick;
+  uint64_t tick = 0;
 
   killLock.lock();
 
-  tick = engine.getCurrentTick();
+  if (pSimulation) {
+    tick = pSimulation->getTick();
+  }
 
   if (tick == 0) {
     // Exit program
     exit(0);
   }
 
-  // Print last statistics
-  statistics(tick);
-
   // Erase progress
   printf("\33[2K                                                           \r");
 
-  releaseSimpleSSDEngine();
-
-  pIOGen->printStats(std::cout);
-  engine.printStats(std::cout);
+  pSimulation->printLastStats(std::cout);
 
   // Cleanup all here
-  delete pInterface;
-  delete pIOGen;
-
   if (pThread) {
     pThread->join();
 
     delete pThread;
   }
 
-  delete pBIOEntry;  // Used by progress thread
-
-  if (logOut.is_open()) {
-    logOut.close();
-  }
-  if (debugLogOut.is_open()) {
-    debugLogOut.close();
-  }
+  delete pSimulation;  // Used by progress thread
 
   std::cout << "End of simulation @ tick " << tick << std::endl;
 
@@ -308,37 +111,6 @@ void cleanup(int) {
   exit(0);
 }
 
-void statistics(uint64_t tick) {
-  if (pLog == nullptr) {
-    return;
-  }
-
-  std::ostream &out = *pLog;
-  std::vector<double> stat;
-  uint64_t count = 0;
-
-  pInterface->getStats(stat);
-
-  count = statList.size();
-
-  if (count != stat.size()) {
-    std::cerr << " Stat list length mismatch" << std::endl;
-
-    std::terminate();
-  }
-
-  out << "Periodic log printout @ tick " << tick << std::endl;
-
-  for (uint64_t i = 0; i < count; i++) {
-    print(out, statList[i].name, 40);
-    out << "\t";
-    print(out, stat[i], 20);
-    out << "\t" << statList[i].desc << std::endl;
-  }
-
-  out << "End of log @ tick " << tick << std::endl;
-}
-
 void threadFunc(int tick) {
   uint64_t current;
   uint64_t old = 0;
@@ -356,9 +128,7 @@ void threadFunc(int tick) {
       break;
     }
 
-    engine.getStat(current);
-    pIOGen->getProgress(progress);
-    pBIOEntry->getProgress(data);
+    pSimulation->getProgress(current, progress, data);
 
     printf("\33[2K*** Progress: %.2f%% (%lf ops) IOPS: %" PRIu64 " BW: %" PRIu64
            " B/s Avg. Lat: %" PRIu64 " ps\r",
@@ -125,8 +125,9 @@ LONG WINAPI exceptionHandler(LPEXCEPTION_POINTERS pExceptionInfo) {
 #include <unistd.h>
 
 #define FRAMECOUNT 32
+#define STACKSIZE 65536
 
-static uint8_t stack[SIGSTKSZ * 2];
+static uint8_t stack[STACKSIZE];
 
 void print_backtrace();
 
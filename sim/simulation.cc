@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sim/simulation.hh"
+
+#include "igl/request/request_generator.hh"
+#include "igl/trace/trace_replayer.hh"
+#include "sil/none/none.hh"
+#include "sil/nvme/nvme.hh"
+#include "util/print.hh"
+
+void joinPath(std::string &lhs, std::string &rhs) {
+  if (rhs.front() == '/') {
+    // Assume absolute path
+    lhs = rhs;
+  }
+  else if (lhs.back() == '/') {
+    lhs += rhs;
+  }
+  else {
+    lhs += '/';
+    lhs += rhs;
+  }
+}
+
+Simulation::Simulation()
+    : pContext(nullptr),
+      pInterface(nullptr),
+      pBIOEntry(nullptr),
+      pIOGen(nullptr),
+      pLog(nullptr),
+      pDebugLog(nullptr),
+      pLatencyFile(nullptr),
+      pHistogramFile(nullptr),
+      logOnScreen(false) {}
+
+Simulation::~Simulation() {
+  SimpleSSD::setContext(pContext);
+
+  delete pInterface;
+  delete pIOGen;
+  delete pBIOEntry;
+  delete pContext;
+
+  if (logOut.is_open()) {
+    logOut.close();
+  }
+  if (debugLogOut.is_open()) {
+    debugLogOut.close();
+  }
+}
+
+int Simulation::init(std::string simConfigPath, std::string ssdConfigPath,
+                     std::string outputPath) {
+  // Read simulation config file
+  if (!simConfig.init(simConfigPath)) {
+    std::cerr << " Failed to open simulation configuration file!" << std::endl;
+
+    return 2;
+  }
+
+  // Read SimpleSSD config file
+  if (!ssdConfig.init(ssdConfigPath)) {
+    std::cerr << " Failed to open SimpleSSD configuration file!" << std::endl;
+
+    return 2;
+  }
+
+  // Initialize event engine
+  engine.init(simConfig);
+
+  // Log setting
+  std::string logPath = simConfig.readString(CONFIG_GLOBAL, GLOBAL_LOG_FILE);
+  std::string debugLogPath =
+      simConfig.readString(CONFIG_GLOBAL, GLOBAL_DEBUG_LOG_FILE);
+  std::string latencyLogPath =
+      simConfig.readString(CONFIG_GLOBAL, GLOBAL_LATENCY_LOG_FILE);
+  std::string histogramPath =
+      simConfig.readString(CONFIG_GLOBAL, GLOBAL_LATENCY_HISTOGRAM_FILE);
+
+  if (logPath.compare("STDOUT") == 0) {
+    logOnScreen = true;
+    pLog = &std::cout;
+  }
+  else if (logPath.compare("STDERR") == 0) {
+    logOnScreen = true;
+    pLog = &std::cerr;
+  }
+  else if (logPath.length() != 0) {
+    std::string full(outputPath);
+
+    joinPath(full, logPath);
+    logOut.open(full);
+
+    if (!logOut.is_open()) {
+      std::cerr << " Failed to open log file: " << full << std::endl;
+
+      return 3;
+    }
+
+    pLog = &logOut;
+  }
+
+  if (debugLogPath.compare("STDOUT") == 0) {
+    logOnScreen = true;
+    pDebugLog = &std::cout;
+  }
+  else if (debugLogPath.compare("STDERR") == 0) {
+    logOnScreen = true;
+    pDebugLog = &std::cerr;
+  }
+  else if (debugLogPath.length() != 0) {
+    std::string full(outputPath);
+
+    joinPath(full, debugLogPath);
+    debugLogOut.open(full);
+
+    if (!debugLogOut.is_open()) {
+      std::cerr << " Failed to open log file: " << full << std::endl;
+
+      return 3;
+    }
+
+    pDebugLog = &debugLogOut;
+  }
+
+  if (latencyLogPath.length() != 0) {
+    std::string full(outputPath);
+
+    joinPath(full, latencyLogPath);
+    if (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LATENCY_LOG_FORMAT) ==
+        LATENCY_LOG_BINARY) {
+      latencyFile.open(full, std::ios::binary);
+    }
+    else {
+      latencyFile.open(full);
+    }
+
+    if (!latencyFile.is_open()) {
+      std::cerr << " Failed to open log file: " << full << std::endl;
+
+      return 3;
+    }
+
+    pLatencyFile = &latencyFile;
+  }
+
+  if (histogramPath.length() != 0) {
+    std::string full(outputPath);
+
+    joinPath(full, histogramPath);
+    histogramFile.open(full, std::ios::binary);
+
+    if (!histogramFile.is_open()) {
+      std::cerr << " Failed to open log file: " << full << std::endl;
+
+      return 3;
+    }
+
+    pHistogramFile = &histogramFile;
+  }
+
+  // Initialize SimpleSSD
+  pContext = new SimpleSSD::SimulationContext(&engine, pDebugLog, pDebugLog);
+
+  SimpleSSD::setContext(pContext);
+
+  pContext->initCPU(ssdConfig);
+
+  // Create Driver
+  switch (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_INTERFACE)) {
+    case INTERFACE_NONE:
+      pInterface = new SIL::None::Driver(engine, ssdConfig);
+
+      break;
+    case INTERFACE_NVME:
+      pInterface = new SIL::NVMe::Driver(engine, ssdConfig);
+
+      break;
+    default:
+      std::cerr << " Undefined interface specified." << std::endl;
+
+      return 4;
+  }
+
+  // Create Block I/O Layer
+  pBIOEntry = new BIL::BlockIOEntry(simConfig, engine, pInterface,
+                                    pLatencyFile, pHistogramFile);
+
+  endCallback = [this]() {
+    // If stat printout is scheduled, delete it
+    if (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) > 0) {
+      engine.descheduleEvent(statEvent);
+    }
+
+    // Stop simulation
+    engine.stopEngine();
+  };
+
+  // Create I/O generator
+  switch (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_SIM_MODE)) {
+    case MODE_REQUEST_GENERATOR:
+      pIOGen =
+          new IGL::RequestGenerator(engine, *pBIOEntry, endCallback, simConfig);
+
+      break;
+    case MODE_TRACE_REPLAYER:
+      pIOGen =
+          new IGL::TraceReplayer(engine, *pBIOEntry, endCallback, simConfig);
+
+      break;
+    default:
+      std::cerr << " Undefined simulation mode specified." << std::endl;
+
+      return 5;
+  }
+
+  // Insert stat event
+  pInterface->initStats(statList);
+  pBIOEntry->initStats(statList);
+
+  if (simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) > 0) {
+    statEvent = engine.allocateEvent([this](uint64_t tick) {
+      statistics(tick);
+
+      engine.scheduleEvent(
+          statEvent,
+          tick + simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) *
+                     1000000000ULL);
+    });
+    engine.scheduleEvent(
+        statEvent,
+        simConfig.readUint(CONFIG_GLOBAL, GLOBAL_LOG_PERIOD) * 1000000000ULL);
+  }
+
+  return 0;
+}
+
+void Simulation::run() {
+  beginCallback = [this]() {
+    uint64_t bytesize;
+    uint32_t bs;
+
+    pInterface->getInfo(bytesize, bs);
+    pIOGen->init(bytesize, bs);
+    pIOGen->begin();
+  };
+
+  SimpleSSD::setContext(pContext);
+
+  pInterface->init(beginCallback);
+
+  while (engine.doNextEvent())
+    ;
+}
+
+void Simulation::printLastStats(std::ostream &out) {
+  SimpleSSD::setContext(pContext);
+
+  // Print last statistics
+  statistics(engine.getCurrentTick());
+
+  SimpleSSD::printCPULastStat();
+
+  pIOGen->printStats(out);
+  engine.printStats(out);
+}
+
+void Simulation::statistics(uint64_t tick) {
+  std::vector<double> &stat = lastStat;
+  uint64_t count = 0;
+
+  stat.clear();
+
+  pInterface->getStats(stat);
+  pBIOEntry->getStats(stat);
+
+  count = statList.size();
+
+  if (count != stat.size()) {
+    std::cerr << " Stat list length mismatch" << std::endl;
+
+    std::terminate();
+  }
+
+  if (pLog == nullptr) {
+    return;
+  }
+
+  std::ostream &out = *pLog;
+
+  out << "Periodic log printout @ tick " << tick << std::endl;
+
+  for (uint64_t i = 0; i < count; i++) {
+    print(out, statList[i].name, 40);
+    out << "\t";
+    print(out, stat[i], 20);
+    out << "\t" << statList[i].desc << std::endl;
+  }
+
+  out << "End of log @ tick " << tick << std::endl;
+}
+
+uint64_t Simulation::getTick() {
+  return engine.getCurrentTick();
+}
+
+bool Simulation::isLogOnScreen() {
+  return logOnScreen;
+}
+
+ConfigReader &Simulation::getConfig() {
+  return simConfig;
+}
+
+void Simulation::getProgress(uint64_t &events, float &progress,
+                             BIL::Progress &data) {
+  engine.getStat(events);
+  pIOGen->getProgress(progress);
+  pBIOEntry->getProgress(data);
+}
+
+std::vector<SimpleSSD::Stats> &Simulation::getStatList() {
+  return statList;
+}
+
+std::vector<double> &Simulation::getLastStats() {
+  return lastStat;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __SIM_SIMULATION__
+#define __SIM_SIMULATION__
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bil/entry.hh"
+#include "igl/io_gen.hh"
+#include "sim/cfg_reader.hh"
+#include "sim/engine.hh"
+#include "simplessd/util/simplessd.hh"
+
+/**
+ * \brief One standalone SSD simulation
+ *
+ * Owns event engine, SimpleSSD context, driver, block I/O layer, I/O
+ * generator, output files and statistics list of a simulation. Nothing is
+ * shared between instances, so independent simulations can run on separate
+ * threads. All methods bind the SimpleSSD context to the calling thread.
+ */
+class Simulation {
+ private:
+  ConfigReader simConfig;
+  Engine engine;
+
+  SimpleSSD::ConfigReader ssdConfig;
+  SimpleSSD::SimulationContext *pContext;
+
+  BIL::DriverInterface *pInterface;
+  BIL::BlockIOEntry *pBIOEntry;
+  IGL::IOGenerator *pIOGen;
+
+  std::ostream *pLog;
+  std::ostream *pDebugLog;
+  std::ostream *pLatencyFile;
+  std::ostream *pHistogramFile;
+  std::ofstream logOut;
+  std::ofstream debugLogOut;
+  std::ofstream latencyFile;
+  std::ofstream histogramFile;
+  bool logOnScreen;
+
+  SimpleSSD::Event statEvent;
+  std::vector<SimpleSSD::Stats> statList;
+  std::vector<double> lastStat;
+
+  std::function<void()> beginCallback;
+  std::function<void()> endCallback;
+
+ public:
+  Simulation();
+  ~Simulation();
+
+  int init(std::string, std::string, std::string);
+  void run();
+  void printLastStats(std::ostream &);
+
+  void statistics(uint64_t);
+
+  uint64_t getTick();
+  bool isLogOnScreen();
+  ConfigReader &getConfig();
+  void getProgress(uint64_t &, float &, BIL::Progress &);
+  std::vector<SimpleSSD::Stats> &getStatList();
+  std::vector<double> &getLastStats();
+};
+
+void joinPath(std::string &, std::string &);
+
+#endif
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "sim/simulation.hh"
+
+struct Job {
+  std::string simConfig;
+  std::string ssdConfig;
+  std::string outputPath;
+
+  int result;  //!< Return value of Simulation::init, -1 if not started
+  double wallTime;
+  uint64_t tick;
+  uint64_t events;
+  std::vector<SimpleSSD::Stats> statList;
+  std::vector<double> stats;
+
+  Job() : result(-1), wallTime(0.), tick(0), events(0) {}
+};
+
+// Global objects
+std::vector<Job> jobList;
+uint64_t nextJob = 0;
+uint64_t finishedJob = 0;
+uint32_t runningJob = 0;
+std::mutex jobLock;
+std::condition_variable jobCond;
+
+uint64_t jobMemory = 0;     // in KiB, 0 if unlimited
+uint64_t memoryBudget = 0;  // in KiB
+uint64_t baseMemory = 0;    // in KiB
+
+// Declaration
+bool readManifest(const char *);
+uint64_t readProcValue(const char *, const char *);
+bool fitMemory();
+void threadFunc();
+void runJob(Job &);
+void printSummary(std::ostream &);
+
+int main(int argc, char *argv[]) {
+  uint32_t threads = std::thread::hardware_concurrency();
+
+  std::cout << "SimpleSSD Parameter Sweep" << std::endl;
+
+  // Check argument
+  if (argc < 3 || argc > 5) {
+    std::cerr << " Invalid number of argument!" << std::endl;
+    std::cerr << "  Usage: simplessd-sweep <Manifest file> <Summary file> "
+                 "[<Threads> [<Memory per simulation (MiB)>]]"
+              << std::endl;
+    std::cerr << "  Each manifest line: <Simulation configuration file> "
+                 "<SimpleSSD configuration file> <Output directory>"
+              << std::endl;
+
+    return 1;
+  }
+
+  if (!readManifest(argv[1])) {
+    return 2;
+  }
+
+  if (argc > 3) {
+    threads = (uint32_t)strtoul(argv[3], nullptr, 10);
+  }
+  if (argc > 4) {
+    jobMemory = strtoull(argv[4], nullptr, 10) * 1024;
+  }
+
+  if (threads == 0) {
+    threads = 1;
+  }
+
+  // Limit concurrency by available memory
+  if (jobMemory > 0) {
+    memoryBudget = readProcValue("/proc/meminfo", "MemAvailable:");
+    baseMemory = readProcValue("/proc/self/status", "VmRSS:");
+
+    if (memoryBudget == 0) {
+      std::cerr << " Failed to read available memory. Ignore memory limit."
+                << std::endl;
+
+      jobMemory = 0;
+    }
+    else if (memoryBudget / jobMemory < threads) {
+      threads = (uint32_t)std::max<uint64_t>(memoryBudget / jobMemory, 1);
+    }
+  }
+
+  if (threads > jobList.size()) {
+    threads = (uint32_t)jobList.size();
+  }
+
+  std::ofstream summary(argv[2]);
+
+  if (!summary.is_open()) {
+    std::cerr << " Failed to open summary file: " << argv[2] << std::endl;
+
+    return 3;
+  }
+
+  std::cout << "Run " << jobList.size() << " simulations on " << threads
+            << " threads" << std::endl;
+
+  // Idle thread takes the next pending simulation, so long simulations do
+  // not hold back short ones queued behind them
+  std::vector<std::thread> pool;
+
+  for (uint32_t i = 0; i < threads; i++) {
+    pool.emplace_back(threadFunc);
+  }
+
+  for (auto &iter : pool) {
+    iter.join();
+  }
+
+  printSummary(summary);
+
+  std::cout << "Summary written to " << argv[2] << std::endl;
+
+  for (auto &iter : jobList) {
+    if (iter.result != 0) {
+      return 4;
+    }
+  }
+
+  return 0;
+}
+
+bool readManifest(const char *path) {
+  std::ifstream file(path);
+  std::string line;
+  uint64_t lineno = 0;
+
+  if (!file.is_open()) {
+    std::cerr << " Failed to open manifest file: " << path << std::endl;
+
+    return false;
+  }
+
+  while (std::getline(file, line)) {
+    std::istringstream iss(line);
+    std::string extra;
+    Job job;
+
+    lineno++;
+
+    // Skip empty lines and comments
+    if (!(iss >> job.simConfig) || job.simConfig.front() == '#') {
+      continue;
+    }
+
+    if (!(iss >> job.ssdConfig >> job.outputPath) || (iss >> extra)) {
+      std::cerr << " Invalid manifest line " << lineno << ": " << line
+                << std::endl;
+
+      return false;
+    }
+
+    // Fail before any simulation starts, not in the middle of sweep
+    for (auto &config : {job.simConfig, job.ssdConfig}) {
+      std::ifstream check(config);
+
+      if (!check.is_open()) {
+        std::cerr << " Failed to open configuration file at manifest line "
+                  << lineno << ": " << config << std::endl;
+
+        return false;
+      }
+    }
+
+    jobList.push_back(job);
+  }
+
+  if (jobList.size() == 0) {
+    std::cerr << " No simulation in manifest file: " << path << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+uint64_t readProcValue(const char *path, const char *key) {
+  std::ifstream file(path);
+  std::string name;
+  uint64_t value;
+
+  // Linux only, returns value in KiB or 0 if not found
+  while (file >> name >> value) {
+    if (name.compare(key) == 0) {
+      return value;
+    }
+
+    file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+
+  return 0;
+}
+
+bool fitMemory() {
+  if (jobMemory == 0 || runningJob == 0) {
+    return true;
+  }
+
+  uint64_t used = readProcValue("/proc/self/status", "VmRSS:");
+
+  // Running simulations may use more than expected
+  used = used > baseMemory ? used - baseMemory : 0;
+
+  return used + jobMemory <= memoryBudget;
+}
+
+void threadFunc() {
+  while (true) {
+    uint64_t idx;
+
+    {
+      std::unique_lock<std::mutex> guard(jobLock);
+
+      // Hold next simulation while memory is short
+      while (nextJob < jobList.size() && !fitMemory()) {
+        jobCond.wait_for(guard, std::chrono::seconds(1));
+      }
+
+      if (nextJob >= jobList.size()) {
+        break;
+      }
+
+      idx = nextJob++;
+      runningJob++;
+    }
+
+    runJob(jobList[idx]);
+
+    {
+      std::lock_guard<std::mutex> guard(jobLock);
+
+      runningJob--;
+      finishedJob++;
+
+      std::cout << "[" << finishedJob << "/" << jobList.size() << "] "
+                << jobList[idx].outputPath << ": "
+                << (jobList[idx].result == 0 ? "done" : "failed") << " ("
+                << jobList[idx].wallTime << " s)" << std::endl;
+    }
+
+    jobCond.notify_all();
+  }
+}
+
+void runJob(Job &job) {
+  auto begin = std::chrono::steady_clock::now();
+  Simulation *pSimulation = new Simulation();
+
+  job.result =
+      pSimulation->init(job.simConfig, job.ssdConfig, job.outputPath);
+
+  if (job.result == 0) {
+    std::string path(job.outputPath);
+    std::string name("stats.txt");
+    float progress;
+    BIL::Progress data;
+
+    pSimulation->run();
+
+    // What simplessd-standalone prints at the end of simulation
+    joinPath(path, name);
+
+    std::ofstream out(path);
+
+    if (out.is_open()) {
+      pSimulation->printLastStats(out);
+    }
+    else {
+      std::cerr << " Failed to open stat file: " << path << std::endl;
+
+      std::ostringstream discard;
+
+      pSimulation->printLastStats(discard);
+    }
+
+    job.tick = pSimulation->getTick();
+    pSimulation->getProgress(job.events, progress, data);
+    job.statList = pSimulation->getStatList();
+    job.stats = pSimulation->getLastStats();
+  }
+
+  delete pSimulation;
+
+  job.wallTime = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - begin)
+                     .count();
+}
+
+void printSummary(std::ostream &out) {
+  std::vector<std::string> columns;
+
+  // Union of statistics, in order of appearance
+  for (auto &job : jobList) {
+    for (auto &stat : job.statList) {
+      bool found = false;
+
+      for (auto &iter : columns) {
+        if (iter == stat.name) {
+          found = true;
+
+          break;
+        }
+      }
+
+      if (!found) {
+        columns.push_back(stat.name);
+      }
+    }
+  }
+
+  out << "simconfig\tssdconfig\toutput\tresult\twalltime\ttick\tevents";
+
+  for (auto &iter : columns) {
+    out << "\t" << iter;
+  }
+
+  out << std::endl;
+
+  for (auto &job : jobList) {
+    out << job.simConfig << "\t" << job.ssdConfig << "\t" << job.outputPath
+        << "\t" << job.result << "\t" << job.wallTime << "\t" << job.tick
+        << "\t" << job.events;
+
+    for (auto &iter : columns) {
+      out << "\t";
+
+      for (uint64_t i = 0; i < job.statList.size(); i++) {
+        if (job.statList[i].name == iter) {
+          out << job.stats[i];
+
+          break;
+        }
+      }
+    }
+
+    out << std::endl;
+  }
+}
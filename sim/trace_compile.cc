@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "igl/trace/binary_reader.hh"
+#include "igl/trace/text_reader.hh"
+#include "sim/cfg_reader.hh"
+
+// Number of records buffered before write
+#define WRITE_BATCH 65536
+
+int main(int argc, char *argv[]) {
+  ConfigReader simConfig;
+
+  std::cout << "SimpleSSD Trace Compiler" << std::endl;
+
+  // Check argument
+  if (argc != 3) {
+    std::cerr << " Invalid number of argument!" << std::endl;
+    std::cerr << "  Usage: trace-compile <Simulation configuration file> "
+                 "<Output file>"
+              << std::endl;
+
+    return 1;
+  }
+
+  // Read simulation config file
+  if (!simConfig.init(argv[1])) {
+    std::cerr << " Failed to open simulation configuration file!" << std::endl;
+
+    return 2;
+  }
+
+  std::ofstream out(argv[2], std::ios::binary);
+
+  if (!out.is_open()) {
+    std::cerr << " Failed to open output file: " << argv[2] << std::endl;
+
+    return 3;
+  }
+
+  // Parse trace with [trace] Regex and group IDs
+  IGL::TextTraceReader reader(simConfig);
+  IGL::TraceRecord record;
+  IGL::BinaryTraceHeader header;
+  std::vector<IGL::BinaryTraceRecord> buffer;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINARY_TRACE_MAGIC, sizeof(header.magic));
+  header.version = BINARY_TRACE_VERSION;
+  header.recordSize = sizeof(IGL::BinaryTraceRecord);
+  header.lbaSize = reader.getLBASize();
+
+  // Count is filled after all records are written
+  out.write((const char *)&header, sizeof(header));
+
+  buffer.reserve(WRITE_BATCH);
+
+  while (reader.read(record)) {
+    IGL::BinaryTraceRecord entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.tick = record.tick;
+    entry.offset = record.offset;
+    entry.length = record.length;
+    entry.type = (uint8_t)record.type;
+
+    buffer.push_back(entry);
+    header.count++;
+
+    if (buffer.size() == WRITE_BATCH) {
+      out.write((const char *)buffer.data(),
+                buffer.size() * sizeof(IGL::BinaryTraceRecord));
+      buffer.clear();
+    }
+  }
+
+  out.write((const char *)buffer.data(),
+            buffer.size() * sizeof(IGL::BinaryTraceRecord));
+
+  out.seekp(0, std::ios::beg);
+  out.write((const char *)&header, sizeof(header));
+
+  if (!out.good()) {
+    std::cerr << " Failed to write output file: " << argv[2] << std::endl;
+
+    return 4;
+  }
+
+  out.close();
+
+  std::cout << "Compiled " << header.count << " records to " << argv[2]
+            << std::endl;
+  reader.printStats(std::cout);
+
+  return 0;
+}
@@ -31,12 +31,15 @@ const char NAME_CLOCK[] = "ClockSpeed";
 const char NAME_CORE_HIL[] = "HILCoreCount";
 const char NAME_CORE_ICL[] = "ICLCoreCount";
 const char NAME_CORE_FTL[] = "FTLCoreCount";
+const char NAME_POWER_STAT[] = "PowerStat";
+const char NAME_POWER_MODEL_CACHE[] = "PowerModelCache";
 
 Config::Config() {
   clock = 400000000;
   hilCore = 1;
   iclCore = 1;
   ftlCore = 1;
+  powerStat = false;
 }
 
 bool Config::setConfig(const char *name, const char *value) {
@@ -57,6 +60,12 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_CORE_FTL)) {
     ftlCore = (uint32_t)strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_POWER_STAT)) {
+    powerStat = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_POWER_MODEL_CACHE)) {
+    powerModelCache = value;
+  }
   else {
     ret = false;
   }
@@ -95,11 +104,25 @@ std::string Config::readString(uint32_t idx) {
 	switch (idx) {
 		case CPU_COMMON_CONFIG_PATH:
 			return commonConfigPath;
+		case CPU_POWER_MODEL_CACHE:
+			return powerModelCache;
 		default:
 			return "";
 	}
 }
 
+bool Config::readBoolean(uint32_t idx) {
+  bool ret = false;
+
+  switch (idx) {
+    case CPU_POWER_STAT:
+      ret = powerStat;
+      break;
+  }
+
+  return ret;
+}
+
 
 }  // namespace CPU
 
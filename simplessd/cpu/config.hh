@@ -34,6 +34,8 @@ typedef enum {
   CPU_CORE_HIL,
   CPU_CORE_ICL,
   CPU_CORE_FTL,
+  CPU_POWER_STAT,
+  CPU_POWER_MODEL_CACHE,
 } CPU_CONFIG;
 
 class Config : public BaseConfig {
@@ -43,6 +45,8 @@ class Config : public BaseConfig {
   uint32_t hilCore;  //!< Default: 1
   uint32_t iclCore;  //!< Default: 1
   uint32_t ftlCore;  //!< Default: 1
+  bool powerStat;    //!< Default: false
+  std::string powerModelCache;  //!< Default: ""
 
  public:
   Config();
@@ -52,6 +56,7 @@ class Config : public BaseConfig {
 
   uint64_t readUint(uint32_t) override;
   std::string readString(uint32_t idx) override;
+  bool readBoolean(uint32_t) override;
 };
 
 }  // namespace CPU
@@ -19,7 +19,13 @@
 
 #include "cpu/cpu.hh"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <random>
 
 #include "sim/trace.hh"
 
@@ -27,6 +33,23 @@ namespace SimpleSSD {
 
 namespace CPU {
 
+// Activity counters of one core used by power model
+#define POWER_INPUTS 7
+
+// Activity applied to McPAT while building power model
+#define POWER_MODEL_CYCLES 1000000000
+#define POWER_MODEL_INSTS 100000000
+
+// Power models built in this process, by key of getPowerModelKey
+// Simulations running in parallel with same CPU configuration share one
+struct PowerModel {
+  Power staticPower;
+  std::vector<double> energyCoeff;
+};
+
+static std::mutex powerModelLock;
+static std::unordered_map<std::string, PowerModel> powerModelList;
+
 InstStat::_InstStat()
     : branch(0),
       load(0),
@@ -135,9 +158,14 @@ void CPU::Core::addStat(InstStat &inst) {
   stat.instStat += inst;
 }
 
-CPU::CPU(ConfigReader &c) : conf(c), lastResetStat(0) {
+CPU::CPU(ConfigReader &c)
+    : conf(c),
+      lastResetStat(0),
+      powerModelReady(false),
+      powerModelChecked(false) {
   clockSpeed = conf.readUint(CONFIG_CPU, CPU_CLOCK);
   clockPeriod = 1000000000000. / clockSpeed;  // in pico-seconds
+  powerStat = conf.readBoolean(CONFIG_CPU, CPU_POWER_STAT);
 
   hilCore.resize(conf.readUint(CONFIG_CPU, CPU_CORE_HIL));
   iclCore.resize(conf.readUint(CONFIG_CPU, CPU_CORE_ICL));
@@ -300,15 +328,10 @@ CPU::CPU(ConfigReader &c) : conf(c), lastResetStat(0) {
 
 CPU::~CPU() {}
 
-void CPU::calculatePower(Power &power) {
-  // Print stats before die
-  ParseXML param;
-  uint64_t simCycle = (getTick() - lastResetStat) / clockPeriod;
+void CPU::setStaticParam(ParseXML &param) {
   uint32_t totalCore = hilCore.size() + iclCore.size() + ftlCore.size();
   uint32_t coreIdx = 0;
 
-  param.initialize();
-
   // system
   {
     param.sys.number_of_L1Directories = 0;
@@ -337,7 +360,6 @@ void CPU::calculatePower(Power &power) {
     param.sys.virtual_address_width = 48;
     param.sys.physical_address_width = 48;
     param.sys.virtual_memory_page_size = 4096;
-    param.sys.total_cycles = simCycle;
     param.sys.number_of_cores = totalCore;
   }
 
@@ -460,29 +482,20 @@ void CPU::calculatePower(Power &power) {
 
   // Etcetera
   param.sys.mc.req_window_size_per_channel = 32;
+}
 
-  // Apply stat values
-
-  // Core stat
-  coreIdx = 0;
-
-  for (auto &core : hilCore) {
-    CoreStat &stat = core.getStat();
+void CPU::setActivityParam(ParseXML &param, std::vector<CoreStat> &stats,
+                           uint64_t simCycle) {
+  uint32_t totalCore = stats.size();
+  uint32_t coreIdx = 0;
 
-    param.sys.core[coreIdx].total_instructions = stat.instStat.sum();
-    param.sys.core[coreIdx].int_instructions = stat.instStat.arithmetic;
-    param.sys.core[coreIdx].fp_instructions = stat.instStat.floatingPoint;
-    param.sys.core[coreIdx].branch_instructions = stat.instStat.branch;
-    param.sys.core[coreIdx].load_instructions = stat.instStat.load;
-    param.sys.core[coreIdx].store_instructions = stat.instStat.store;
-    param.sys.core[coreIdx].busy_cycles = stat.busy / clockPeriod;
+  param.sys.total_cycles = simCycle;
 
-    coreIdx++;
-  }
+  // Apply stat values
 
-  for (auto &core : iclCore) {
-    CoreStat &stat = core.getStat();
+  // Core stat
 
+  for (auto &stat : stats) {
     param.sys.core[coreIdx].total_instructions = stat.instStat.sum();
     param.sys.core[coreIdx].int_instructions = stat.instStat.arithmetic;
     param.sys.core[coreIdx].fp_instructions = stat.instStat.floatingPoint;
@@ -494,20 +507,6 @@ void CPU::calculatePower(Power &power) {
     coreIdx++;
   }
 
-  for (auto &core : ftlCore) {
-    CoreStat &stat = core.getStat();
-
-    param.sys.core[coreIdx].total_instructions = stat.instStat.sum();
-    param.sys.core[coreIdx].int_instructions = stat.instStat.arithmetic;
-    param.sys.core[coreIdx].fp_instructions = stat.instStat.floatingPoint;
-    param.sys.core[coreIdx].branch_instructions = stat.instStat.branch;
-    param.sys.core[coreIdx].load_instructions = stat.instStat.load;
-    param.sys.core[coreIdx].store_instructions = stat.instStat.store;
-    param.sys.core[coreIdx].busy_cycles = stat.busy / clockPeriod;
-
-    coreIdx++;
-  };
-
   for (coreIdx = 0; coreIdx < totalCore; coreIdx++) {
     param.sys.core[coreIdx].total_cycles = simCycle;
     param.sys.core[coreIdx].idle_cycles =
@@ -632,12 +631,300 @@ void CPU::calculatePower(Power &power) {
     param.sys.L3[0].write_misses = 0;
     param.sys.L3[0].write_backs = 0;
   }
+}
 
+void CPU::evaluatePower(std::vector<CoreStat> &stats, uint64_t simCycle,
+                        Power &power) {
+  // McPAT (CACTI) keeps its technology parameters in global variables
+  static std::mutex mcpatLock;
+  ParseXML param;
+
+  param.initialize();
+
+  setStaticParam(param);
+  setActivityParam(param, stats, simCycle);
+
+  std::lock_guard<std::mutex> guard(mcpatLock);
   McPAT mcpat(&param);
 
   mcpat.getPower(power);
 }
 
+void CPU::getActivity(CoreStat &stat, uint64_t *value) {
+  value[0] = stat.instStat.branch;
+  value[1] = stat.instStat.load;
+  value[2] = stat.instStat.store;
+  value[3] = stat.instStat.arithmetic;
+  value[4] = stat.instStat.floatingPoint;
+  value[5] = stat.instStat.otherInsts;
+  value[6] = stat.busy / clockPeriod;
+}
+
+void CPU::setActivity(CoreStat &stat, uint64_t *value) {
+  stat.instStat.branch = value[0];
+  stat.instStat.load = value[1];
+  stat.instStat.store = value[2];
+  stat.instStat.arithmetic = value[3];
+  stat.instStat.floatingPoint = value[4];
+  stat.instStat.otherInsts = value[5];
+  stat.busy = value[6] * clockPeriod;
+}
+
+std::string CPU::getPowerModelKey() {
+  // Everything setStaticParam depends on
+  return "mcpat-v1 clock " + std::to_string(clockSpeed) + " hil " +
+         std::to_string(hilCore.size()) + " icl " +
+         std::to_string(iclCore.size()) + " ftl " +
+         std::to_string(ftlCore.size());
+}
+
+std::string CPU::getPowerModelPath() {
+  std::string dir = conf.readString(CONFIG_CPU, CPU_POWER_MODEL_CACHE);
+  char hash[32];
+
+  if (dir.length() == 0) {
+    return dir;
+  }
+
+  snprintf(hash, 32, "%016zx",
+           std::hash<std::string>()(getPowerModelKey()));
+
+  return dir + "/mcpat-" + hash + ".txt";
+}
+
+bool CPU::loadPowerModel() {
+  std::string path = getPowerModelPath();
+  std::string key;
+  PowerGroup *group[3] = {&staticPower.core, &staticPower.level2,
+                          &staticPower.level3};
+  uint64_t count;
+
+  if (path.length() == 0) {
+    return false;
+  }
+
+  std::ifstream file(path);
+
+  if (!file.is_open() || !std::getline(file, key) ||
+      key != getPowerModelKey()) {
+    return false;
+  }
+
+  for (auto iter : group) {
+    file >> iter->area >> iter->peakDynamic >> iter->subthresholdLeakage >>
+        iter->gateLeakage;
+  }
+
+  file >> count;
+
+  if (!file.good() ||
+      count != 3 * ((hilCore.size() + iclCore.size() + ftlCore.size()) *
+                        POWER_INPUTS +
+                    2)) {
+    return false;
+  }
+
+  energyCoeff.resize(count);
+
+  for (auto &iter : energyCoeff) {
+    file >> iter;
+  }
+
+  if (file.fail()) {
+    return false;
+  }
+
+  powerModelReady = true;
+
+  debugprint(LOG_CPU, "Power model loaded from %s", path.c_str());
+
+  return true;
+}
+
+void CPU::savePowerModel() {
+  std::string path = getPowerModelPath();
+  PowerGroup *group[3] = {&staticPower.core, &staticPower.level2,
+                          &staticPower.level3};
+
+  if (path.length() == 0) {
+    return;
+  }
+
+  // Write to temporal file and rename, as simulations may run in parallel
+  std::string temp = path + "." + std::to_string(std::random_device()());
+  std::ofstream file(temp);
+
+  if (!file.is_open()) {
+    warn("Failed to write power model to %s", path.c_str());
+
+    return;
+  }
+
+  file.precision(17);
+  file << getPowerModelKey() << std::endl;
+
+  for (auto iter : group) {
+    file << iter->area << " " << iter->peakDynamic << " "
+         << iter->subthresholdLeakage << " " << iter->gateLeakage
+         << std::endl;
+  }
+
+  file << energyCoeff.size() << std::endl;
+
+  for (auto &iter : energyCoeff) {
+    file << iter << std::endl;
+  }
+
+  file.close();
+
+  if (file.fail() || std::rename(temp.c_str(), path.c_str()) != 0) {
+    std::remove(temp.c_str());
+
+    warn("Failed to write power model to %s", path.c_str());
+  }
+}
+
+void CPU::buildPowerModel() {
+  // McPAT computes leakage and peak power from static configuration, and
+  // runtime energy linearly from activity counters. Evaluate McPAT with
+  // each counter separately and keep energy per unit of each counter.
+  uint32_t totalCore = hilCore.size() + iclCore.size() + ftlCore.size();
+  uint32_t inputs = totalCore * POWER_INPUTS;
+  uint32_t stride = inputs + 2;
+  double period = 1. / ((clockSpeed / 1000000) * 1000000.);  // in seconds
+  std::vector<CoreStat> stats(totalCore);
+  uint64_t value[POWER_INPUTS];
+  double base[3];
+  Power power;
+
+  auto getEnergy = [&](double *energy, uint64_t cycles) {
+    evaluatePower(stats, cycles, power);
+
+    energy[0] = power.core.runtimeDynamic * cycles * period;
+    energy[1] = power.level2.runtimeDynamic * cycles * period;
+    energy[2] = power.level3.runtimeDynamic * cycles * period;
+  };
+
+  debugprint(LOG_CPU, "Build power model with %u McPAT evaluations",
+             inputs + 2);
+
+  energyCoeff.resize(3 * stride);
+
+  // No activity
+  {
+    double twice[3];
+
+    getEnergy(twice, 2 * POWER_MODEL_CYCLES);
+    getEnergy(base, POWER_MODEL_CYCLES);
+
+    staticPower = power;
+
+    for (uint32_t i = 0; i < 3; i++) {
+      energyCoeff[i * stride] = 2 * base[i] - twice[i];
+      energyCoeff[i * stride + 1] = (twice[i] - base[i]) / POWER_MODEL_CYCLES;
+    }
+  }
+
+  // One counter at a time
+  for (uint32_t input = 0; input < inputs; input++) {
+    auto &stat = stats.at(input / POWER_INPUTS);
+    uint32_t idx = input % POWER_INPUTS;
+    uint64_t unit = idx == POWER_INPUTS - 1 ? POWER_MODEL_CYCLES / 2
+                                            : POWER_MODEL_INSTS;
+    double energy[3];
+
+    memset(value, 0, sizeof(value));
+    value[idx] = unit;
+    setActivity(stat, value);
+
+    getEnergy(energy, POWER_MODEL_CYCLES);
+
+    for (uint32_t i = 0; i < 3; i++) {
+      energyCoeff[i * stride + 2 + input] = (energy[i] - base[i]) / unit;
+    }
+
+    memset(value, 0, sizeof(value));
+    setActivity(stat, value);
+  }
+
+  powerModelReady = true;
+}
+
+void CPU::calculatePower(Power &power) {
+  uint64_t simCycle = (getTick() - lastResetStat) / clockPeriod;
+  std::vector<CoreStat> stats;
+
+  for (auto &core : hilCore) {
+    stats.push_back(core.getStat());
+  }
+  for (auto &core : iclCore) {
+    stats.push_back(core.getStat());
+  }
+  for (auto &core : ftlCore) {
+    stats.push_back(core.getStat());
+  }
+
+  if (!powerModelChecked) {
+    std::lock_guard<std::mutex> guard(powerModelLock);
+    auto iter = powerModelList.find(getPowerModelKey());
+
+    powerModelChecked = true;
+
+    if (iter != powerModelList.end()) {
+      staticPower = iter->second.staticPower;
+      energyCoeff = iter->second.energyCoeff;
+      powerModelReady = true;
+    }
+    else {
+      // Building model costs several McPAT evaluations, so only do it when
+      // power is reported periodically
+      if (!loadPowerModel() && powerStat) {
+        buildPowerModel();
+        savePowerModel();
+      }
+
+      if (powerModelReady) {
+        PowerModel &model = powerModelList[getPowerModelKey()];
+
+        model.staticPower = staticPower;
+        model.energyCoeff = energyCoeff;
+      }
+    }
+  }
+
+  if (!powerModelReady) {
+    evaluatePower(stats, simCycle, power);
+
+    return;
+  }
+
+  uint32_t stride = stats.size() * POWER_INPUTS + 2;
+  double period = 1. / ((clockSpeed / 1000000) * 1000000.);  // in seconds
+  PowerGroup *group[3] = {&power.core, &power.level2, &power.level3};
+  uint64_t value[POWER_INPUTS];
+
+  power = staticPower;
+
+  if (simCycle == 0) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < 3; i++) {
+    double *coeff = energyCoeff.data() + i * stride;
+    double energy = coeff[0] + coeff[1] * simCycle;
+
+    for (uint32_t core = 0; core < stats.size(); core++) {
+      getActivity(stats.at(core), value);
+
+      for (uint32_t idx = 0; idx < POWER_INPUTS; idx++) {
+        energy += coeff[2 + core * POWER_INPUTS + idx] * value[idx];
+      }
+    }
+
+    group[i]->runtimeDynamic = energy / (simCycle * period);
+  }
+}
+
 uint32_t CPU::leastBusyCPU(std::vector<Core> &list) {
   uint32_t idx = list.size();
   uint64_t busymin = std::numeric_limits<uint64_t>::max();
@@ -899,6 +1186,16 @@ void CPU::getStatList(std::vector<Stats> &list, std::string prefix) {
     list.push_back(temp);
     */
   }
+
+  if (powerStat) {
+    temp.name = prefix + ".power.dynamic";
+    temp.desc = "CPU runtime dynamic power (W)";
+    list.push_back(temp);
+
+    temp.name = prefix + ".power.leakage";
+    temp.desc = "CPU leakage power (W)";
+    list.push_back(temp);
+  }
 }
 
 void CPU::getStatValues(std::vector<double> &values) {
@@ -937,6 +1234,19 @@ void CPU::getStatValues(std::vector<double> &values) {
     //values.push_back(stat.instStat.floatingPoint);
     //values.push_back(stat.instStat.otherInsts);
   }
+
+  if (powerStat) {
+    Power power;
+
+    calculatePower(power);
+
+    values.push_back(power.core.runtimeDynamic + power.level2.runtimeDynamic +
+                     power.level3.runtimeDynamic);
+    values.push_back(
+        power.core.subthresholdLeakage + power.core.gateLeakage +
+        power.level2.subthresholdLeakage + power.level2.gateLeakage +
+        power.level3.subthresholdLeakage + power.level3.gateLeakage);
+  }
 }
 
 void CPU::resetStatValues() {
@@ -115,7 +115,24 @@ class CPU : public StatObject {
   // CPIs
   std::unordered_map<uint16_t, std::unordered_map<uint16_t, InstStat>> cpi;
 
+  // Power
+  bool powerStat;
+  bool powerModelReady;
+  bool powerModelChecked;
+  Power staticPower;                //!< Area, peak dynamic and leakage
+  std::vector<double> energyCoeff;  //!< Runtime energy per activity unit (J)
+
   uint32_t leastBusyCPU(std::vector<Core> &);
+  void getActivity(CoreStat &, uint64_t *);
+  void setActivity(CoreStat &, uint64_t *);
+  void setStaticParam(ParseXML &);
+  void setActivityParam(ParseXML &, std::vector<CoreStat> &, uint64_t);
+  void evaluatePower(std::vector<CoreStat> &, uint64_t, Power &);
+  std::string getPowerModelKey();
+  std::string getPowerModelPath();
+  bool loadPowerModel();
+  void savePowerModel();
+  void buildPowerModel();
   void calculatePower(Power &);
 
  public:
@@ -27,6 +27,8 @@ namespace SimpleSSD {
 namespace DRAM {
 
 const char NAME_DRAM_MODEL[] = "Model";
+const char NAME_DRAM_POWER_MODEL[] = "PowerModel";
+const char NAME_DRAM_POWER_WINDOW[] = "PowerWindow";
 const char NAME_DRAM_STRUCTURE_CHANNEL[] = "Channel";
 const char NAME_DRAM_STRUCTURE_RANK[] = "Rank";
 const char NAME_DRAM_STRUCTURE_BANK[] = "Bank";
@@ -83,6 +85,8 @@ const char NAME_DRAM_POWER_VDD_1[] = "VDD_1";
 
 Config::Config() {
   model = SIMPLE_MODEL;
+  powerModel = POWER_PER_ACCESS;
+  powerWindow = 16384;
 
   /* LPDDR3-1600 4Gbit 1x32 */
   dram.channel = 1;
@@ -150,6 +154,12 @@ bool Config::setConfig(const char *name, const char *value) {
   if (MATCH_NAME(NAME_DRAM_MODEL)) {
     model = (MODEL)strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_DRAM_POWER_MODEL)) {
+    powerModel = (POWER_MODEL)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DRAM_POWER_WINDOW)) {
+    powerWindow = strtoul(value, nullptr, 10);
+  }
   else if (MATCH_NAME(NAME_DRAM_STRUCTURE_CHANNEL)) {
     dram.channel = strtoul(value, nullptr, 10);
   }
@@ -323,6 +333,21 @@ int64_t Config::readInt(uint32_t idx) {
     case DRAM_MODEL:
       ret = model;
       break;
+    case DRAM_POWER_MODEL:
+      ret = powerModel;
+      break;
+  }
+
+  return ret;
+}
+
+uint64_t Config::readUint(uint32_t idx) {
+  uint64_t ret = 0;
+
+  switch (idx) {
+    case DRAM_POWER_WINDOW:
+      ret = powerWindow;
+      break;
   }
 
   return ret;
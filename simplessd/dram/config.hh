@@ -28,12 +28,20 @@ namespace DRAM {
 
 typedef enum {
   DRAM_MODEL,
+  DRAM_POWER_MODEL,
+  DRAM_POWER_WINDOW,
 } DRAM_CONFIG;
 
 typedef enum {
   SIMPLE_MODEL,
 } MODEL;
 
+typedef enum {
+  POWER_PER_ACCESS,  //!< DRAMPower window per access
+  POWER_BATCHED,     //!< DRAMPower window per PowerWindow accesses
+  POWER_ANALYTIC,    //!< Command counters, no DRAMPower trace
+} POWER_MODEL;
+
 class Config : public BaseConfig {
  public:
   typedef struct {
@@ -90,6 +98,8 @@ class Config : public BaseConfig {
 
  private:
   MODEL model;
+  POWER_MODEL powerModel;  //!< Default: POWER_PER_ACCESS
+  uint64_t powerWindow;    //!< Default: 16384
 
   DRAMStructure dram;
   DRAMTiming dramTiming;
@@ -101,6 +111,7 @@ class Config : public BaseConfig {
   bool setConfig(const char *, const char *) override;
 
   int64_t readInt(uint32_t) override;
+  uint64_t readUint(uint32_t) override;
 
   DRAMStructure *getDRAMStructure();
   DRAMTiming *getDRAMTiming();
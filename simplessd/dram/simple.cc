@@ -29,14 +29,44 @@ namespace DRAM {
 
 SimpleDRAM::Stat::Stat() : count(0), size(0) {}
 
+SimpleDRAM::PowerCounter::PowerCounter()
+    : act(0), read(0), write(0), ref(0), activeCycles(0) {}
+
 SimpleDRAM::SimpleDRAM(ConfigReader &p)
-    : AbstractDRAM(p), lastDRAMAccess(0), ignoreScheduling(false) {
+    : AbstractDRAM(p),
+      lastDRAMAccess(0),
+      ignoreScheduling(false),
+      pendingAccess(0),
+      powerCycle(0),
+      windowBeginAt(0),
+      analyticEnergy(0.0),
+      analyticCycles(0) {
   pageFetchLatency = pTiming->tRP + pTiming->tRAS;
   interfaceBandwidth = 2.0 * pStructure->busWidth * pStructure->chip *
                        pStructure->channel / 8.0 / pTiming->tCK;
 
+  powerModel = (POWER_MODEL)conf.readInt(CONFIG_DRAM, DRAM_POWER_MODEL);
+  powerWindow = conf.readUint(CONFIG_DRAM, DRAM_POWER_WINDOW);
+
+  if (powerModel > POWER_ANALYTIC) {
+    panic("Invalid DRAM power model %u", powerModel);
+  }
+  if (powerModel == POWER_BATCHED && powerWindow == 0) {
+    panic("PowerWindow should be larger than 0");
+  }
+
   autoRefresh = allocate([this](uint64_t now) {
-    dramPower->doCommand(Data::MemCommand::REF, 0, now / pTiming->tCK);
+    uint64_t refAt = MAX(now / pTiming->tCK, powerCycle);
+
+    if (powerModel == POWER_ANALYTIC) {
+      counter.ref++;
+      counter.activeCycles += spec.memTimingSpec.RFC - spec.memTimingSpec.RP;
+    }
+    else {
+      dramPower->doCommand(Data::MemCommand::REF, 0, refAt);
+    }
+
+    powerCycle = refAt + spec.memTimingSpec.RFC;
 
     lastDRAMAccess = MAX(lastDRAMAccess, now + pTiming->tRFC);
 
@@ -83,6 +113,122 @@ void SimpleDRAM::updateStats(uint64_t cycle) {
   totalPower = power.average_power;
 }
 
+void SimpleDRAM::updatePower(Data::MemCommand::cmds type, uint64_t pageCount,
+                             uint64_t beginAt) {
+  auto &timing = spec.memTimingSpec;
+
+  // Accesses overlap when scheduling is ignored, but power model has one
+  // bank. Issue commands not before end of previous access, so overlapped
+  // cycles are counted once. Each command takes at least one cycle, as
+  // DRAMPower sorts PRE before others at same cycle.
+  uint64_t actAt = MAX(beginAt, powerCycle);
+  uint64_t cmdAt = MAX(beginAt + timing.RCD * pageCount, actAt + pageCount);
+  uint64_t preAt =
+      MAX(beginAt + timing.RCD * pageCount - timing.RCD + timing.RAS,
+          cmdAt + 1);
+
+  powerCycle = preAt + timing.RP;
+
+  if (powerModel == POWER_ANALYTIC) {
+    counter.act++;
+
+    if (type == Data::MemCommand::RD) {
+      counter.read += pageCount;
+    }
+    else {
+      counter.write += pageCount;
+    }
+
+    // ACT to PRE, same as DRAMPower active cycles
+    counter.activeCycles += preAt - actAt;
+
+    return;
+  }
+
+  dramPower->doCommand(Data::MemCommand::ACT, 0, actAt);
+
+  cmdAt = actAt;
+
+  for (uint64_t i = 0; i < pageCount; i++) {
+    cmdAt = MAX(beginAt + timing.RCD * (i + 1), cmdAt + 1);
+
+    dramPower->doCommand(type, 0, cmdAt);
+  }
+
+  dramPower->doCommand(Data::MemCommand::PRE, 0, preAt);
+
+  if (powerModel == POWER_PER_ACCESS) {
+    updateStats(powerCycle);
+  }
+  else {
+    pendingAccess++;
+
+    if (pendingAccess >= powerWindow) {
+      flushPower();
+    }
+  }
+}
+
+void SimpleDRAM::flushPower() {
+  if (powerModel == POWER_BATCHED) {
+    if (pendingAccess > 0) {
+      // Commands after current tick are kept for next window by DRAMPower
+      updateStats(getTick() / pTiming->tCK);
+
+      pendingAccess = 0;
+    }
+  }
+  else if (powerModel == POWER_ANALYTIC) {
+    if (powerCycle > windowBeginAt) {
+      uint64_t cycles = powerCycle - windowBeginAt;
+      double energy = calcAnalyticEnergy(cycles);
+
+      totalEnergy += energy;
+      analyticEnergy += energy;
+      analyticCycles += cycles;
+      totalPower =
+          analyticEnergy / (analyticCycles * spec.memTimingSpec.clkPeriod);
+
+      windowBeginAt = powerCycle;
+      counter = PowerCounter();
+    }
+  }
+}
+
+double SimpleDRAM::calcAnalyticEnergy(uint64_t cycles) {
+  auto &timing = spec.memTimingSpec;
+  auto &power = spec.memPowerSpec;
+  auto &arch = spec.memArchSpec;
+  double burst = arch.burstLength / arch.dataRate;
+  double active = (double)MIN(counter.activeCycles, cycles);
+  double precharged = (double)cycles - active;
+
+  // Same terms as MemoryPowerModel::power_calc without power-down and
+  // self-refresh, as SimpleDRAM never issues those commands
+  auto domain = [&](double vdd, double idd0, double idd2n, double idd3n,
+                    double idd4r, double idd4w, double idd5) -> double {
+    double charge =
+        counter.act * (timing.RAS * (idd0 - idd3n) +
+                       (timing.RC - timing.RAS) * (idd0 - idd2n)) +
+        counter.read * burst * (idd4r - idd3n) +
+        counter.write * burst * (idd4w - idd3n) +
+        counter.ref * timing.RFC * (idd5 - idd3n) +
+        arch.nbrOfRanks * (active * idd3n + precharged * idd2n);
+
+    return charge * timing.clkPeriod * vdd;
+  };
+
+  double energy = domain(power.vdd, power.idd0, power.idd2n, power.idd3n,
+                         power.idd4r, power.idd4w, power.idd5);
+
+  if (arch.twoVoltageDomains) {
+    energy += domain(power.vdd2, power.idd02, power.idd2n2, power.idd3n2,
+                     power.idd4r2, power.idd4w2, power.idd52);
+  }
+
+  return energy;
+}
+
 void SimpleDRAM::setScheduling(bool enable) {
   ignoreScheduling = !enable;
 }
@@ -102,22 +248,9 @@ void SimpleDRAM::read(void *, uint64_t size, uint64_t &tick) {
   // DRAMPower uses cycle unit
   beginAt /= pTiming->tCK;
 
-  dramPower->doCommand(Data::MemCommand::ACT, 0, beginAt);
-
-  for (uint64_t i = 0; i < pageCount; i++) {
-    dramPower->doCommand(Data::MemCommand::RD, 0,
-                         beginAt + spec.memTimingSpec.RCD);
-
-    beginAt += spec.memTimingSpec.RCD;
-  }
-
-  beginAt -= spec.memTimingSpec.RCD;
-
-  dramPower->doCommand(Data::MemCommand::PRE, 0,
-                       beginAt + spec.memTimingSpec.RAS);
+  updatePower(Data::MemCommand::RD, pageCount, beginAt);
 
   // Stat Update
-  updateStats(beginAt + spec.memTimingSpec.RAS + spec.memTimingSpec.RP);
   readStat.count++;
   readStat.size += size;
 }
@@ -133,22 +266,9 @@ void SimpleDRAM::write(void *, uint64_t size, uint64_t &tick) {
   // DRAMPower uses cycle unit
   beginAt /= pTiming->tCK;
 
-  dramPower->doCommand(Data::MemCommand::ACT, 0, beginAt);
-
-  for (uint64_t i = 0; i < pageCount; i++) {
-    dramPower->doCommand(Data::MemCommand::WR, 0,
-                         beginAt + spec.memTimingSpec.RCD);
-
-    beginAt += spec.memTimingSpec.RCD;
-  }
-
-  beginAt -= spec.memTimingSpec.RCD;
-
-  dramPower->doCommand(Data::MemCommand::PRE, 0,
-                       beginAt + spec.memTimingSpec.RAS);
+  updatePower(Data::MemCommand::WR, pageCount, beginAt);
 
   // Stat Update
-  updateStats(beginAt + spec.memTimingSpec.RAS + spec.memTimingSpec.RP);
   writeStat.count++;
   writeStat.size += size;
 }
@@ -186,6 +306,8 @@ void SimpleDRAM::getStatList(std::vector<Stats> &list, std::string prefix) {
 }
 
 void SimpleDRAM::getStatValues(std::vector<double> &values) {
+  flushPower();
+
   AbstractDRAM::getStatValues(values);
 
   //values.push_back(readStat.count);
@@ -197,6 +319,8 @@ void SimpleDRAM::getStatValues(std::vector<double> &values) {
 }
 
 void SimpleDRAM::resetStatValues() {
+  flushPower();
+
   AbstractDRAM::resetStatValues();
 
   readStat = Stat();
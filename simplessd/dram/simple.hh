@@ -37,6 +37,16 @@ class SimpleDRAM : public AbstractDRAM {
     Stat();
   };
 
+  struct PowerCounter {
+    uint64_t act;
+    uint64_t read;
+    uint64_t write;
+    uint64_t ref;
+    uint64_t activeCycles;
+
+    PowerCounter();
+  };
+
   uint64_t pageFetchLatency;
   double interfaceBandwidth;
 
@@ -48,8 +58,21 @@ class SimpleDRAM : public AbstractDRAM {
   Stat readStat;
   Stat writeStat;
 
+  POWER_MODEL powerModel;
+  uint64_t powerWindow;
+  uint64_t pendingAccess;  //!< Accesses not evaluated by DRAMPower yet
+  uint64_t powerCycle;     //!< End cycle of last access given to power model
+
+  PowerCounter counter;
+  uint64_t windowBeginAt;  //!< Cycle where current analytic window begins
+  double analyticEnergy;   //!< Never reset, as DRAMPower total energy
+  uint64_t analyticCycles;
+
   uint64_t updateDelay(uint64_t, uint64_t &);
   void updateStats(uint64_t);
+  void updatePower(Data::MemCommand::cmds, uint64_t, uint64_t);
+  void flushPower();
+  double calcAnalyticEnergy(uint64_t);
 
  public:
   SimpleDRAM(ConfigReader &p);
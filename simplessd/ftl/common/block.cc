@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <cstring>
 
+#include "ftl/common/victim_index.hh"
+
 namespace SimpleSSD {
 
 namespace FTL {
@@ -36,10 +38,13 @@ Block::Block(uint32_t blockIdx, uint32_t count, uint32_t ioUnit)
       ppLPNs(nullptr),
       lastAccessed(0),
       eraseCount(0),
+      validPageCount(0),
       lastWritten(0),
       maxErrorCount(0),
       refreshedPageCount(0),
-      blockType(COLD){
+      blockType(COLD),
+      state(BLOCK_FREE),
+      pVictimIndex(nullptr) {
   if (ioUnitInPage == 1) {
     pValidBits = new Bitset(pageCount);
     pErasedBits = new Bitset(pageCount);
@@ -79,10 +84,13 @@ Block::Block(uint32_t blockIdx, uint32_t count, uint32_t ioUnit, uint32_t initPE
       ppLPNs(nullptr),
       lastAccessed(0),
       eraseCount(0),
+      validPageCount(0),
       lastWritten(0),
       maxErrorCount(0),
       refreshedPageCount(0),
-      blockType(COLD){
+      blockType(COLD),
+      state(BLOCK_FREE),
+      pVictimIndex(nullptr) {
   if (ioUnitInPage == 1) {
     pValidBits = new Bitset(pageCount);
     pErasedBits = new Bitset(pageCount);
@@ -122,10 +130,13 @@ Block::Block(uint32_t blockIdx, uint32_t count, uint32_t ioUnit, uint32_t initPE
       ppLPNs(nullptr),
       lastAccessed(0),
       eraseCount(0),
+      validPageCount(0),
       lastWritten(0),
       maxErrorCount(0),
       refreshedPageCount(0),
-      blockType(blockType){
+      blockType(blockType),
+      state(BLOCK_FREE),
+      pVictimIndex(nullptr) {
   if (ioUnitInPage == 1) {
     pValidBits = new Bitset(pageCount);
     pErasedBits = new Bitset(pageCount);
@@ -176,11 +187,14 @@ Block::Block(const Block &old)
          ioUnitInPage * sizeof(uint32_t));
 
   eraseCount = old.eraseCount;
+  validPageCount = old.validPageCount;
   
   lastWritten = old.lastWritten;
   maxErrorCount = old.maxErrorCount;
   refreshedPageCount = old.refreshedPageCount;
   blockType = old.blockType;
+  state = old.state;
+  pVictimIndex = old.pVictimIndex;
 }
 
 Block::Block(Block &&old) noexcept
@@ -196,10 +210,13 @@ Block::Block(Block &&old) noexcept
       ppLPNs(std::move(old.ppLPNs)),
       lastAccessed(std::move(old.lastAccessed)),
       eraseCount(std::move(old.eraseCount)),
+      validPageCount(std::move(old.validPageCount)),
       lastWritten(std::move(old.lastWritten)),
       maxErrorCount(std::move(old.maxErrorCount)),
       refreshedPageCount(std::move(old.refreshedPageCount)),
-      blockType(std::move(old.blockType)) {
+      blockType(std::move(old.blockType)),
+      state(std::move(old.state)),
+      pVictimIndex(std::move(old.pVictimIndex)) {
   // TODO Use std::exchange to set old value to null (C++14)
   old.idx = 0;
   old.pageCount = 0;
@@ -211,10 +228,13 @@ Block::Block(Block &&old) noexcept
   old.ppLPNs = nullptr;
   old.lastAccessed = 0;
   old.eraseCount = 0;
+  old.validPageCount = 0;
   old.lastWritten = 0;
   old.maxErrorCount = 0;
   old.refreshedPageCount = 0;
   old.blockType = COLD;
+  old.state = BLOCK_FREE;
+  old.pVictimIndex = nullptr;
 }
 
 Block::~Block() {
@@ -264,10 +284,13 @@ Block &Block::operator=(Block &&rhs) {
     ppLPNs = std::move(rhs.ppLPNs);
     lastAccessed = std::move(rhs.lastAccessed);
     eraseCount = std::move(rhs.eraseCount);
+    validPageCount = std::move(rhs.validPageCount);
     lastWritten = std::move(rhs.lastWritten);
     maxErrorCount = std::move(rhs.maxErrorCount);
     refreshedPageCount = std::move(rhs.refreshedPageCount);
     blockType = std::move(rhs.blockType);
+    state = std::move(rhs.state);
+    pVictimIndex = std::move(rhs.pVictimIndex);
 
     rhs.pNextWritePageIndex = nullptr;
     rhs.pValidBits = nullptr;
@@ -276,10 +299,13 @@ Block &Block::operator=(Block &&rhs) {
     rhs.ppLPNs = nullptr;
     rhs.lastAccessed = 0;
     rhs.eraseCount = 0;
+    rhs.validPageCount = 0;
     rhs.lastWritten = 0;
     rhs.maxErrorCount = 0;
     rhs.refreshedPageCount = 0;
     rhs.blockType = COLD;
+    rhs.state = BLOCK_FREE;
+    rhs.pVictimIndex = nullptr;
   }
 
   return *this;
@@ -320,12 +346,32 @@ void Block::setMaxErrorCount(uint64_t maxError){
 
 void Block::setRefreshedPageCount(uint32_t refreshedPageCount){
   this->refreshedPageCount = refreshedPageCount;
+
+  updateVictimIndex();
 }
 
 void Block::setBlockType(blockPoolType blockType){
   this->blockType = blockType;
 }
 
+void Block::setBlockState(blockState state) {
+  this->state = state;
+}
+
+blockState Block::getBlockState() {
+  return state;
+}
+
+void Block::setVictimIndex(VictimIndex *index) {
+  pVictimIndex = index;
+}
+
+void Block::updateVictimIndex() {
+  if (pVictimIndex && state == BLOCK_FULL) {
+    pVictimIndex->update(idx, validPageCount, refreshedPageCount);
+  }
+}
+
 
 uint64_t Block::getMaxErrorCount(){
   return maxErrorCount;
@@ -353,19 +399,7 @@ uint32_t Block::getValidPageCount() {
 }
 
 uint32_t Block::getValidPageCountRaw() {
-  uint32_t ret = 0;
-
-  if (ioUnitInPage == 1) {
-    // Same as getValidPageCount()
-    ret = pValidBits->count();
-  }
-  else {
-    for (auto &iter : validBits) {
-      ret += iter.count();
-    }
-  }
-
-  return ret;
+  return validPageCount;
 }
 
 uint32_t Block::getDirtyPageCount() {
@@ -480,6 +514,13 @@ bool Block::write(uint32_t pageIndex, uint64_t lpn, uint32_t idx,
     }
 
     pNextWritePageIndex[idx] = pageIndex + 1;
+    validPageCount++;
+
+    if (pageIndex + 1 == pageCount) {
+      state = BLOCK_FULL;
+    }
+
+    updateVictimIndex();
   }
   else {
     panic("Write to non erased page");
@@ -505,14 +546,23 @@ void Block::erase() {
   memset(pNextWritePageIndex, 0, sizeof(uint32_t) * ioUnitInPage);
 
   eraseCount++;
+  validPageCount = 0;
+  state = BLOCK_FREE;
+
+  if (pVictimIndex) {
+    pVictimIndex->remove(idx);
+  }
 }
 
 void Block::invalidate(uint32_t pageIndex, uint32_t idx) {
-  if (ioUnitInPage == 1) {
-    pValidBits->reset(pageIndex);
-  }
-  else {
-    validBits.at(pageIndex).reset(idx);
+  Bitset &bits = ioUnitInPage == 1 ? *pValidBits : validBits.at(pageIndex);
+  uint32_t bit = ioUnitInPage == 1 ? pageIndex : idx;
+
+  if (bits.test(bit)) {
+    bits.reset(bit);
+    validPageCount--;
+
+    updateVictimIndex();
   }
 }
 
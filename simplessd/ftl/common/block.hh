@@ -29,12 +29,21 @@ namespace SimpleSSD {
 
 namespace FTL {
 
+class VictimIndex;
+
 typedef enum {
   HOT,
   COLD,
   COOL,
 } blockPoolType;
 
+typedef enum {
+  BLOCK_FREE,  // Erased, in free block list
+  BLOCK_OPEN,  // Allocated, has writable pages
+  BLOCK_FULL,  // Allocated, all pages are written
+  BLOCK_BAD,   // Retired by bad block threshold
+} blockState;
+
 class Block {
  private:
   uint32_t idx;
@@ -54,6 +63,7 @@ class Block {
 
   uint64_t lastAccessed;
   uint32_t eraseCount;
+  uint32_t validPageCount;  // Same as getValidPageCountRaw()
 
   // Refresh practice
   uint64_t lastWritten;
@@ -61,6 +71,11 @@ class Block {
   uint32_t refreshedPageCount;
 
   blockPoolType blockType;
+  blockState state;
+
+  VictimIndex *pVictimIndex;  // Notified while block is full
+
+  void updateVictimIndex();
 
 
 
@@ -101,6 +116,11 @@ class Block {
   // Hot Cold
   void setBlockType(blockPoolType);
   blockPoolType getBlockType();
+
+  void setBlockState(blockState);
+  blockState getBlockState();
+
+  void setVictimIndex(VictimIndex *);
 };
 
 }  // namespace FTL
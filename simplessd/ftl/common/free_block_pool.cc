@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ftl/common/free_block_pool.hh"
+
+#include "sim/trace.hh"
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+FreeBlockPool::FreeBlockPool()
+    : count(0), sequence(0), eraseCountSum(0), eraseCountSquareSum(0) {}
+
+void FreeBlockPool::init(uint32_t parallelism) {
+  if (parallelism == 0) {
+    panic("Invalid parallelism of free block pool");
+  }
+
+  units = std::vector<std::set<FreeBlock>>(parallelism);
+  count = 0;
+  sequence = 0;
+  eraseCountSum = 0;
+  eraseCountSquareSum = 0;
+}
+
+void FreeBlockPool::push(uint32_t blockIndex, uint32_t eraseCount) {
+  units[blockIndex % units.size()].insert({eraseCount, sequence++, blockIndex});
+
+  count++;
+  eraseCountSum += eraseCount;
+  eraseCountSquareSum += (uint64_t)eraseCount * eraseCount;
+}
+
+// Returns least worn block of given unit. If the unit has no free block, least
+// worn block of whole pool is returned.
+uint32_t FreeBlockPool::pop(uint32_t unit) {
+  if (count == 0) {
+    panic("No free block left");
+  }
+
+  if (unit >= units.size()) {
+    panic("Index out of range");
+  }
+
+  auto bucket = units.begin() + unit;
+
+  if (bucket->empty()) {
+    // Find first block of whole pool
+    bucket = units.end();
+
+    for (auto iter = units.begin(); iter != units.end(); iter++) {
+      if (iter->empty()) {
+        continue;
+      }
+
+      if (bucket == units.end() || *iter->begin() < *bucket->begin()) {
+        bucket = iter;
+      }
+    }
+  }
+
+  auto block = bucket->begin();
+  uint32_t blockIndex = block->blockIndex;
+  uint32_t eraseCount = block->eraseCount;
+
+  bucket->erase(block);
+
+  count--;
+  eraseCountSum -= eraseCount;
+  eraseCountSquareSum -= (uint64_t)eraseCount * eraseCount;
+
+  return blockIndex;
+}
+
+uint64_t FreeBlockPool::getEraseCountSum() {
+  return eraseCountSum;
+}
+
+uint64_t FreeBlockPool::getEraseCountSquareSum() {
+  return eraseCountSquareSum;
+}
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __FTL_COMMON_FREE_BLOCK_POOL__
+#define __FTL_COMMON_FREE_BLOCK_POOL__
+
+#include <cinttypes>
+#include <set>
+#include <vector>
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+// Free block pool bucketed by parallel unit
+// Block belongs to unit (block index % parallelism). Each unit keeps its free
+// blocks ordered by (erase count, release order), so the front of a unit is
+// the least worn block, and blocks with same erase count are reused in FIFO
+// order. Allocation and release are O(log n).
+class FreeBlockPool {
+ private:
+  typedef struct _FreeBlock {
+    uint32_t eraseCount;
+    uint64_t sequence;
+    uint32_t blockIndex;
+
+    bool operator<(const _FreeBlock &rhs) const {
+      return eraseCount < rhs.eraseCount ||
+             (eraseCount == rhs.eraseCount && sequence < rhs.sequence);
+    }
+  } FreeBlock;
+
+  std::vector<std::set<FreeBlock>> units;
+
+  uint32_t count;
+  uint64_t sequence;
+
+  // For wear-leveling factor
+  uint64_t eraseCountSum;
+  uint64_t eraseCountSquareSum;
+
+ public:
+  FreeBlockPool();
+
+  void init(uint32_t);
+
+  void push(uint32_t, uint32_t);
+  uint32_t pop(uint32_t);
+
+  inline uint32_t size() { return count; }
+  inline bool empty() { return count == 0; }
+
+  uint64_t getEraseCountSum();
+  uint64_t getEraseCountSquareSum();
+};
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
+
+#endif
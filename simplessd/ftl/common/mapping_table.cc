@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ftl/common/mapping_table.hh"
+
+#include <algorithm>
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+MappingTable::MappingTable() : totalPages(0), stride(0), mappedPages(0) {}
+
+void MappingTable::init(uint64_t pages, uint32_t unit, Mapping sentinel) {
+  totalPages = pages;
+  stride = unit;
+  mappedPages = 0;
+  unmapped = sentinel;
+
+  table.assign(totalPages * stride, unmapped);
+  table.shrink_to_fit();
+  mapped.assign(totalPages, false);
+}
+
+void MappingTable::erase(uint64_t lpn) {
+  if (lpn >= totalPages || !mapped[lpn]) {
+    return;
+  }
+
+  std::fill_n(table.begin() + lpn * stride, stride, unmapped);
+
+  mapped[lpn] = false;
+  mappedPages--;
+}
+
+bool MappingTable::isMapped(uint64_t lpn) {
+  return lpn < totalPages && mapped[lpn];
+}
+
+uint64_t MappingTable::size() {
+  return mappedPages;
+}
+
+uint64_t MappingTable::getMemoryUsage() {
+  return table.capacity() * sizeof(Mapping) + (totalPages + 7) / 8;
+}
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __FTL_COMMON_MAPPING_TABLE__
+#define __FTL_COMMON_MAPPING_TABLE__
+
+#include <cinttypes>
+#include <utility>
+#include <vector>
+
+#include "sim/trace.hh"
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+// Physical location of one I/O unit: (block index, page index)
+typedef std::pair<uint32_t, uint32_t> Mapping;
+
+// Flat page mapping table
+// All entries are stored in one array indexed by LPN, each LPN having
+// `stride` consecutive entries (one per I/O unit in page). Entries of LPN which
+// is not mapped are filled with sentinel value.
+class MappingTable {
+ private:
+  std::vector<Mapping> table;
+  std::vector<bool> mapped;
+
+  uint64_t totalPages;
+  uint32_t stride;
+  uint64_t mappedPages;
+  Mapping unmapped;
+
+ public:
+  MappingTable();
+
+  void init(uint64_t, uint32_t, Mapping);
+
+  // Returns nullptr if LPN is not mapped
+  inline Mapping *find(uint64_t lpn) {
+    if (lpn >= totalPages || !mapped[lpn]) {
+      return nullptr;
+    }
+
+    return table.data() + lpn * stride;
+  }
+
+  // Returns entries of LPN, marking LPN as mapped
+  inline Mapping *insert(uint64_t lpn) {
+    if (lpn >= totalPages) {
+      panic("LPN %" PRIu64 " is out of range", lpn);
+    }
+
+    if (!mapped[lpn]) {
+      mapped[lpn] = true;
+      mappedPages++;
+    }
+
+    return table.data() + lpn * stride;
+  }
+
+  void erase(uint64_t);
+
+  bool isMapped(uint64_t);
+  uint64_t size();
+  uint64_t getMemoryUsage();
+};
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
+
+#endif
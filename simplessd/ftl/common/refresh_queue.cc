@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ftl/common/refresh_queue.hh"
+
+#include "sim/trace.hh"
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+const uint32_t RefreshQueue::npos = 0xFFFFFFFF;
+
+RefreshQueue::RefreshQueue() {}
+
+void RefreshQueue::init(uint32_t queues, uint32_t layers) {
+  if (queues == 0) {
+    panic("Invalid number of refresh queues");
+  }
+
+  prevLayer = std::vector<uint32_t>(layers, npos);
+  nextLayer = std::vector<uint32_t>(layers, npos);
+  listOf = std::vector<uint32_t>(layers, npos);
+
+  head = std::vector<uint32_t>(queues * 2, npos);
+  tail = std::vector<uint32_t>(queues * 2, npos);
+  count = std::vector<uint32_t>(queues * 2, 0);
+
+  pendingList = std::vector<uint8_t>(queues, 0);
+}
+
+void RefreshQueue::link(uint32_t list, uint32_t layer) {
+  prevLayer[layer] = tail[list];
+  nextLayer[layer] = npos;
+
+  if (tail[list] == npos) {
+    head[list] = layer;
+  }
+  else {
+    nextLayer[tail[list]] = layer;
+  }
+
+  tail[list] = layer;
+  listOf[layer] = list;
+  count[list]++;
+}
+
+void RefreshQueue::unlink(uint32_t layer) {
+  uint32_t list = listOf[layer];
+  uint32_t before = prevLayer[layer];
+  uint32_t after = nextLayer[layer];
+
+  if (before == npos) {
+    head[list] = after;
+  }
+  else {
+    nextLayer[before] = after;
+  }
+
+  if (after == npos) {
+    tail[list] = before;
+  }
+  else {
+    prevLayer[after] = before;
+  }
+
+  prevLayer[layer] = npos;
+  nextLayer[layer] = npos;
+  listOf[layer] = npos;
+  count[list]--;
+}
+
+// Append layer to pending list of queue, moving it out of its current list
+void RefreshQueue::push(uint32_t queue, uint32_t layer) {
+  if (queue >= pendingList.size() || layer >= listOf.size()) {
+    panic("Refresh queue %u, layer %u is out of range", queue, layer);
+  }
+
+  if (listOf[layer] != npos) {
+    unlink(layer);
+  }
+
+  link(queue * 2 + pendingList[queue], layer);
+}
+
+void RefreshQueue::remove(uint32_t layer) {
+  if (listOf[layer] != npos) {
+    unlink(layer);
+  }
+}
+
+// Pending list becomes checked list and vice versa. Layers left in checked
+// list are refreshed at next turn of the queue.
+void RefreshQueue::swap(uint32_t queue) {
+  pendingList[queue] ^= 1;
+}
+
+bool RefreshQueue::popChecked(uint32_t queue, uint32_t &layer) {
+  uint32_t list = queue * 2 + (pendingList[queue] ^ 1);
+
+  layer = head[list];
+
+  if (layer == npos) {
+    return false;
+  }
+
+  unlink(layer);
+
+  return true;
+}
+
+uint32_t RefreshQueue::getPendingCount(uint32_t queue) {
+  return count[queue * 2 + pendingList[queue]];
+}
+
+uint32_t RefreshQueue::getCheckedCount(uint32_t queue) {
+  return count[queue * 2 + (pendingList[queue] ^ 1)];
+}
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
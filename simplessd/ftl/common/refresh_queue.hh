@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __FTL_COMMON_REFRESH_QUEUE__
+#define __FTL_COMMON_REFRESH_QUEUE__
+
+#include <cinttypes>
+#include <vector>
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+// Refresh queues of layers
+// Each queue has two intrusive lists over one per-layer node array: pending
+// list collects layers to refresh at next turn of the queue, and checked list
+// holds layers being refreshed in current turn. A layer is linked to at most
+// one list, so moving a layer to another queue is O(1) and a layer never
+// appears twice. Swapping pending and checked lists of a queue is O(1).
+class RefreshQueue {
+ private:
+  // Per layer
+  std::vector<uint32_t> prevLayer;
+  std::vector<uint32_t> nextLayer;
+  std::vector<uint32_t> listOf;
+
+  // Per list (two lists per queue)
+  std::vector<uint32_t> head;
+  std::vector<uint32_t> tail;
+  std::vector<uint32_t> count;
+
+  // Per queue: which of two lists is pending list
+  std::vector<uint8_t> pendingList;
+
+  void link(uint32_t, uint32_t);
+  void unlink(uint32_t);
+
+ public:
+  static const uint32_t npos;
+
+  RefreshQueue();
+
+  void init(uint32_t, uint32_t);
+
+  inline uint32_t size() { return (uint32_t)pendingList.size(); }
+  inline bool isQueued(uint32_t layer) { return listOf[layer] != npos; }
+  inline uint32_t getQueue(uint32_t layer) { return listOf[layer] / 2; }
+
+  void push(uint32_t, uint32_t);
+  void remove(uint32_t);
+  void swap(uint32_t);
+  bool popChecked(uint32_t, uint32_t &);
+
+  uint32_t getPendingCount(uint32_t);
+  uint32_t getCheckedCount(uint32_t);
+};
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ftl/common/victim_index.hh"
+
+#include "sim/trace.hh"
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+const uint32_t VictimIndex::npos = 0xFFFFFFFF;
+
+VictimIndex::VictimIndex()
+    : policy(POLICY_GREEDY), enabled(false), recoParam(0.f), count(0) {}
+
+void VictimIndex::init(uint32_t blocks, uint32_t maxValid, EVICT_POLICY p,
+                       float param) {
+  policy = p;
+  recoParam = param;
+  count = 0;
+
+  switch (policy) {
+    case POLICY_GREEDY:
+      enabled = true;
+
+      bucketHead = std::vector<uint32_t>(maxValid + 1, npos);
+      bucketTail = std::vector<uint32_t>(maxValid + 1, npos);
+      prevIndex = std::vector<uint32_t>(blocks, npos);
+      nextIndex = std::vector<uint32_t>(blocks, npos);
+      bucketOf = std::vector<uint32_t>(blocks, npos);
+
+      break;
+    case POLICY_RECO:
+      enabled = true;
+
+      weights.clear();
+      weightOf = std::vector<float>(blocks, 0.f);
+      indexed = std::vector<bool>(blocks, false);
+
+      break;
+    default:
+      enabled = false;
+
+      break;
+  }
+}
+
+void VictimIndex::link(uint32_t blockIndex, uint32_t bucket) {
+  if (bucket >= bucketHead.size()) {
+    panic("Valid page count %u is out of range", bucket);
+  }
+
+  prevIndex[blockIndex] = bucketTail[bucket];
+  nextIndex[blockIndex] = npos;
+
+  if (bucketTail[bucket] == npos) {
+    bucketHead[bucket] = blockIndex;
+  }
+  else {
+    nextIndex[bucketTail[bucket]] = blockIndex;
+  }
+
+  bucketTail[bucket] = blockIndex;
+  bucketOf[blockIndex] = bucket;
+}
+
+void VictimIndex::unlink(uint32_t blockIndex) {
+  uint32_t bucket = bucketOf[blockIndex];
+  uint32_t before = prevIndex[blockIndex];
+  uint32_t after = nextIndex[blockIndex];
+
+  if (before == npos) {
+    bucketHead[bucket] = after;
+  }
+  else {
+    nextIndex[before] = after;
+  }
+
+  if (after == npos) {
+    bucketTail[bucket] = before;
+  }
+  else {
+    prevIndex[after] = before;
+  }
+
+  prevIndex[blockIndex] = npos;
+  nextIndex[blockIndex] = npos;
+  bucketOf[blockIndex] = npos;
+}
+
+// Insert block or re-key it with new page counts
+void VictimIndex::update(uint32_t blockIndex, uint32_t validPages,
+                         uint32_t refreshedPages) {
+  if (!enabled) {
+    return;
+  }
+
+  if (policy == POLICY_GREEDY) {
+    if (bucketOf[blockIndex] == validPages) {
+      return;
+    }
+
+    if (bucketOf[blockIndex] == npos) {
+      count++;
+    }
+    else {
+      unlink(blockIndex);
+    }
+
+    link(blockIndex, validPages);
+  }
+  else {
+    // Keep the expression of calculateVictimWeight, for exact ordering
+    float weight = validPages - (recoParam * refreshedPages);
+
+    if (indexed[blockIndex]) {
+      if (weightOf[blockIndex] == weight) {
+        return;
+      }
+
+      weights.erase({weightOf[blockIndex], blockIndex});
+    }
+    else {
+      indexed[blockIndex] = true;
+      count++;
+    }
+
+    weightOf[blockIndex] = weight;
+    weights.emplace(weight, blockIndex);
+  }
+}
+
+void VictimIndex::remove(uint32_t blockIndex) {
+  if (!enabled) {
+    return;
+  }
+
+  if (policy == POLICY_GREEDY) {
+    if (bucketOf[blockIndex] != npos) {
+      unlink(blockIndex);
+      count--;
+    }
+  }
+  else if (indexed[blockIndex]) {
+    weights.erase({weightOf[blockIndex], blockIndex});
+    indexed[blockIndex] = false;
+    count--;
+  }
+}
+
+void VictimIndex::select(std::vector<uint32_t> &list, uint64_t n,
+                         std::function<bool(uint32_t)> skip) {
+  uint64_t selected = 0;
+
+  if (!enabled) {
+    panic("Victim index is not enabled for this evict policy");
+  }
+
+  if (policy == POLICY_GREEDY) {
+    for (uint32_t bucket = 0; bucket < bucketHead.size() && selected < n;
+         bucket++) {
+      for (uint32_t iter = bucketHead[bucket]; iter != npos && selected < n;
+           iter = nextIndex[iter]) {
+        if (skip && skip(iter)) {
+          continue;
+        }
+
+        list.push_back(iter);
+        selected++;
+      }
+    }
+  }
+  else {
+    for (auto iter = weights.begin(); iter != weights.end() && selected < n;
+         iter++) {
+      if (skip && skip(iter->second)) {
+        continue;
+      }
+
+      list.push_back(iter->second);
+      selected++;
+    }
+  }
+}
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __FTL_COMMON_VICTIM_INDEX__
+#define __FTL_COMMON_VICTIM_INDEX__
+
+#include <cinttypes>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ftl/config.hh"
+
+namespace SimpleSSD {
+
+namespace FTL {
+
+// Index of GC victim candidates (full blocks)
+// Updated by Block whenever valid page count or refreshed page count of a
+// full block changes, so victims can be taken in weight order without
+// scanning all blocks.
+//  POLICY_GREEDY: Bucketed by valid page count (O(1) update)
+//  POLICY_RECO:   Ordered by validPages - RecoGCParam * refreshedPages
+//                 (O(log n) update)
+// Other policies depend on current tick or randomness, so index is disabled.
+class VictimIndex {
+ private:
+  EVICT_POLICY policy;
+  bool enabled;
+  float recoParam;
+
+  // Greedy: doubly linked list per valid page count
+  std::vector<uint32_t> bucketHead;
+  std::vector<uint32_t> bucketTail;
+  std::vector<uint32_t> prevIndex;
+  std::vector<uint32_t> nextIndex;
+  std::vector<uint32_t> bucketOf;
+
+  // RECO: (weight, block index) in ascending order
+  std::set<std::pair<float, uint32_t>> weights;
+  std::vector<float> weightOf;
+  std::vector<bool> indexed;
+
+  uint32_t count;
+
+  void link(uint32_t, uint32_t);
+  void unlink(uint32_t);
+
+ public:
+  static const uint32_t npos;
+
+  VictimIndex();
+
+  void init(uint32_t, uint32_t, EVICT_POLICY, float);
+
+  inline bool isEnabled() { return enabled; }
+  inline uint32_t size() { return count; }
+
+  void update(uint32_t, uint32_t, uint32_t);
+  void remove(uint32_t);
+
+  // Append up to n blocks with the lowest weight, skipping blocks which
+  // skip(blockIndex) returns true
+  void select(std::vector<uint32_t> &, uint64_t,
+              std::function<bool(uint32_t)> = nullptr);
+};
+
+}  // namespace FTL
+
+}  // namespace SimpleSSD
+
+#endif
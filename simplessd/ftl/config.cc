@@ -38,6 +38,7 @@ const char NAME_GC_RECLAIM_THRESHOLD[] = "GCReclaimThreshold";
 const char NAME_GC_EVICT_POLICY[] = "EvictPolicy";
 const char NAME_GC_D_CHOICE_PARAM[] = "DChoiceParam";
 const char NAME_USE_RANDOM_IO_TWEAK[] = "EnableRandomIOTweak";
+const char NAME_COPYBACK_LIMIT[] = "CopybackLimit";
 
 const char NAME_REFRESH_POLICY[] = "RefreshPolicy";
 const char NAME_REFRESH_THREHSHOLD[] = "RefreshThreshold";
@@ -47,6 +48,8 @@ const char NAME_REFRESH_FILTER_SIZE[] = "RefreshFilterSize";
 const char NAME_REFRESH_MODE[] = "RefreshMode";
 const char NAME_REFRESH_MAX_LAYER_NUM[] = "RefreshMaxLayerNum";
 const char NAME_REFRESH_GROUPING_SIZE[] = "RefreshGroupingSize";
+const char NAME_REFRESH_CHUNK_LAYER_NUM[] = "RefreshChunkLayerNum";
+const char NAME_REFRESH_IDLE_TIME[] = "RefreshIdleTime";
 
 const char NAME_INIT_ERASE_COUNT[] = "InitialPECycle";
 
@@ -60,6 +63,10 @@ const char NAME_MTERM[] = "Mterm";
 const char NAME_NTERM[] = "Nterm";
 const char NAME_ERROR_SIGMA[] = "ErrorSigma";
 const char NAME_RANDOM_SEED[] = "RandomSeed";
+const char NAME_LAYER_COUNT[] = "LayerCount";
+const char NAME_LAYER_FACTOR_FILE[] = "LayerFactorFile";
+const char NAME_BLOCK_VARIATION_FILE[] = "BlockVariationFile";
+const char NAME_DIE_VARIATION_FILE[] = "DieVariationFile";
 const char NAME_REFRESH_MAX_RBER[] = "MaxRBER";
 const char NAME_GC_RECO_PARAM[] = "RecoGCParam";
 
@@ -82,6 +89,7 @@ Config::Config() {
   evictPolicy = POLICY_GREEDY;
   dChoiceParam = 3;
   randomIOTweak = true;
+  copybackLimit = 0;
 
   refreshPolicy = POLICY_NONE;
   refreshThreshold = 10000000;
@@ -91,6 +99,8 @@ Config::Config() {
   refreshMode = 0;
   refreshMaxLayerNum = 100000;
   refreshGroupingSize = 3;
+  refreshChunkLayerNum = 64;
+  refreshIdleTime = 1000000000;
 
   temperature = 25;
   epsilon = 0.00148;
@@ -106,6 +116,8 @@ Config::Config() {
   randomSeed = 0;
   initEraseCount = 0;
 
+  layerCount = 64;
+
   hotColdSeperation = 0;
   hotBlocksRatio = 0.1;
   coolDownWindowSize = 64;
@@ -154,6 +166,9 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_USE_RANDOM_IO_TWEAK)) {
     randomIOTweak = convertBool(value);
   }
+  else if (MATCH_NAME(NAME_COPYBACK_LIMIT)) {
+    copybackLimit = strtoul(value, nullptr, 10);
+  }
 
   else if (MATCH_NAME(NAME_REFRESH_POLICY)) {
     refreshPolicy = (REFRESH_POLICY)strtoul(value, nullptr, 10);
@@ -179,6 +194,12 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_REFRESH_GROUPING_SIZE)) {
     refreshGroupingSize = strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_REFRESH_CHUNK_LAYER_NUM)) {
+    refreshChunkLayerNum = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_REFRESH_IDLE_TIME)) {
+    refreshIdleTime = strtoul(value, nullptr, 10);
+  }
   
   else if (MATCH_NAME(NAME_TEMPERATURE)) {
     temperature = strtof(value, nullptr);
@@ -213,6 +234,18 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_RANDOM_SEED)) {
     randomSeed = strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_LAYER_COUNT)) {
+    layerCount = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_LAYER_FACTOR_FILE)) {
+    layerFactorFile = value;
+  }
+  else if (MATCH_NAME(NAME_BLOCK_VARIATION_FILE)) {
+    blockVariationFile = value;
+  }
+  else if (MATCH_NAME(NAME_DIE_VARIATION_FILE)) {
+    dieVariationFile = value;
+  }
   else if (MATCH_NAME(NAME_INIT_ERASE_COUNT)) {
     initEraseCount = strtoul(value, nullptr, 10);
   }
@@ -252,6 +285,11 @@ void Config::update() {
   if (invalidRatio < 0.f || invalidRatio > 1.f) {
     panic("Invalid InvalidPageRatio");
   }
+
+  // Refresh grouping splits layers into three segments
+  if (layerCount < 3) {
+    panic("Invalid LayerCount");
+  }
 }
 
 int64_t Config::readInt(uint32_t idx) {
@@ -291,6 +329,9 @@ uint64_t Config::readUint(uint32_t idx) {
     case FTL_GC_D_CHOICE_PARAM:
       ret = dChoiceParam;
       break;
+    case FTL_COPYBACK_LIMIT:
+      ret = copybackLimit;
+      break;
 
     case FTL_REFRESH_THRESHOLD:
       ret = refreshThreshold;
@@ -298,6 +339,9 @@ uint64_t Config::readUint(uint32_t idx) {
     case FTL_RANDOM_SEED:
       ret = randomSeed;
       break;
+    case FTL_LAYER_COUNT:
+      ret = layerCount;
+      break;
     case FTL_INITIAL_ERASE_COUNT:
       ret = initEraseCount;
       break;
@@ -320,6 +364,12 @@ uint64_t Config::readUint(uint32_t idx) {
     case FTL_REFRESH_GROUPING_SIZE:
       ret = refreshGroupingSize;
       break;
+    case FTL_REFRESH_CHUNK_LAYER_NUM:
+      ret = refreshChunkLayerNum;
+      break;
+    case FTL_REFRESH_IDLE_TIME:
+      ret = refreshIdleTime;
+      break;
     case FTL_HOT_COLD_SEPERATION :
       ret = hotColdSeperation;
       break;
@@ -404,6 +454,24 @@ bool Config::readBoolean(uint32_t idx) {
   return ret;
 }
 
+std::string Config::readString(uint32_t idx) {
+  std::string ret("");
+
+  switch (idx) {
+    case FTL_LAYER_FACTOR_FILE:
+      ret = layerFactorFile;
+      break;
+    case FTL_BLOCK_VARIATION_FILE:
+      ret = blockVariationFile;
+      break;
+    case FTL_DIE_VARIATION_FILE:
+      ret = dieVariationFile;
+      break;
+  }
+
+  return ret;
+}
+
 }  // namespace FTL
 
 }  // namespace SimpleSSD
@@ -41,6 +41,7 @@ typedef enum {
   FTL_GC_EVICT_POLICY,
   FTL_GC_D_CHOICE_PARAM,
   FTL_USE_RANDOM_IO_TWEAK,
+  FTL_COPYBACK_LIMIT,
 
   /* Refresh configuration*/
   FTL_REFRESH_POLICY,
@@ -53,6 +54,8 @@ typedef enum {
   FTL_REFRESH_MAX_RBER,
   FTL_GC_RECO_PARAM,
   FTL_REFRESH_GROUPING_SIZE,
+  FTL_REFRESH_CHUNK_LAYER_NUM,
+  FTL_REFRESH_IDLE_TIME,
 
   /*Initial configuration for experiment*/
   FTL_INITIAL_ERASE_COUNT,
@@ -69,6 +72,12 @@ typedef enum {
   FTL_ERROR_SIGMA,
   FTL_RANDOM_SEED,
 
+  /* Layer model configuration */
+  FTL_LAYER_COUNT,
+  FTL_LAYER_FACTOR_FILE,
+  FTL_BLOCK_VARIATION_FILE,
+  FTL_DIE_VARIATION_FILE,
+
   /* N+K Mapping configuration*/
   FTL_NKMAP_N,
   FTL_NKMAP_K,
@@ -120,6 +129,7 @@ class Config : public BaseConfig {
   EVICT_POLICY evictPolicy;     //!< Default: POLICY_GREEDY
   uint64_t dChoiceParam;        //!< Default: 3
   bool randomIOTweak;           //!< Default: true
+  uint32_t copybackLimit;       //!< Default: 0 (copyback disabled)
 
   REFRESH_POLICY refreshPolicy; //!< Default: POLICY_NONE
   uint64_t refreshThreshold;    //!< Default: 10000000
@@ -129,6 +139,8 @@ class Config : public BaseConfig {
   uint32_t refreshMode;         //!< Default: 0
   uint32_t refreshMaxLayerNum;  //!< Default: 100000
   uint32_t refreshGroupingSize; //!< Default: 3
+  uint32_t refreshChunkLayerNum;//!< Default: 64
+  uint64_t refreshIdleTime;     //!< Default: 1000000000 (1ms)
 
   uint32_t randomSeed;          //!< Default: 0
   float temperature;            //!< Default: 25
@@ -140,6 +152,11 @@ class Config : public BaseConfig {
   float mTerm;
   float nTerm;
   float errorSigma;             //!< Default: 2
+
+  uint32_t layerCount;              //!< Default: 64
+  std::string layerFactorFile;      //!< Default: "" (built-in ramps)
+  std::string blockVariationFile;   //!< Default: "" (no variation)
+  std::string dieVariationFile;     //!< Default: "" (no variation)
   float refreshMaxRBER;         //!< Default: 0.00018
   uint32_t initEraseCount;      //!< Default : 0
   float recoGCParam;            //!< Default : 0.2
@@ -158,6 +175,7 @@ class Config : public BaseConfig {
   uint64_t readUint(uint32_t) override;
   float readFloat(uint32_t) override;
   bool readBoolean(uint32_t) override;
+  std::string readString(uint32_t) override;
 };
 
 }  // namespace FTL
@@ -1,6 +1,9 @@
 #include "ftl/error_modeling.hh"
+#include "sim/trace.hh"
 #include "util/algorithm.hh"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 
@@ -9,6 +12,12 @@ namespace SimpleSSD {
 
 namespace FTL {
 
+// Number of normal samples generated at once
+#define NORMAL_POOL_SIZE 1024
+
+// Number of survival curves kept before dropping all of them
+#define SURVIVAL_TABLE_LIMIT 4096
+
 ErrorModeling::ErrorModeling(){}
 
 ErrorModeling::ErrorModeling(float temperature, float activationEnergy,
@@ -34,49 +43,210 @@ ErrorModeling::ErrorModeling(float temperature, float activationEnergy,
 
   this-> generator = std::mt19937(seed);
 
-  this->layerFactor = std::vector<float>(64);
-  //std::cout << "epsilon " << epsilon << std::endl;
-  //std::cout << "alpha " << alpha << std::endl;
-  //std::cout << "beta " << beta << std::endl;
-  //std::cout << "k " << k << std::endl;
-  //std::cout << "m " << m << std::endl;
-  //std::cout << "n " << n << std::endl;
-  
-  // read File
-  /*
-  std::ifstream layerFile;
-  layerFile.open("/home/rdolf/SimpleSSD/SimpleSSD-Standalone-base/simplessd/ftl/layer_factor.txt");
-  std::string line;
-  for(int i=0; i<64; i++){
-    std::getline(layerFile, line);
-    layerFactor[i] = std::stof(line);
-    //std::cout << "layer factor " << i<< " " << layerFactor[i] << std::endl;
-  }
-  layerFile.close();
-  */
-  float factor = 1.00;
-  for(int i=0; i<21; i++){
-    layerFactor[i] = factor;
-    factor = factor + 0.01;
-  }
-  factor = 1.00;
-  for(int i=21; i<42; i++){
-    layerFactor[i] = factor;
-    factor = factor + 0.01;
-  }
-  factor = 1.00;
-  for(int i=42; i<64; i++){
-    layerFactor[i] = factor;
-    factor = factor + 0.01;
-  }
-  
-  
+  normalPool = std::vector<double>(NORMAL_POOL_SIZE);
+  normalIndex = NORMAL_POOL_SIZE;
+  schedulePeriod = 0;
+  scheduleCount = 0;
+
+  updateArrheniusFactor();
 }
 
 ErrorModeling::~ErrorModeling() {}
 
+// Read whitespace separated factors. Reads all factors if count is 0.
+std::vector<float> ErrorModeling::loadFactors(std::string path,
+                                              uint32_t count) {
+  std::vector<float> ret;
+  std::ifstream file(path);
+  float factor;
+
+  if (!file.is_open()) {
+    panic("Failed to open factor file %s", path.c_str());
+  }
+
+  while ((count == 0 || ret.size() < count) && file >> factor) {
+    ret.push_back(factor);
+  }
+
+  if (ret.size() == 0 || ret.size() < count) {
+    panic("Factor file %s has %u of %u factors", path.c_str(),
+          (uint32_t)ret.size(), count);
+  }
+
+  return ret;
+}
+
+// Build per-layer and per-block factor tables. Without layer factor file,
+// layers are split into three segments and factor ramps 1.00, 1.01, ...
+// in each segment. Die variation file has one factor per die, and block i
+// belongs to die (i % number of factors).
+void ErrorModeling::setLayerModel(uint32_t layers, uint32_t blocks,
+                                  std::string layerFile, std::string blockFile,
+                                  std::string dieFile) {
+  if (layerFile.length() > 0) {
+    layerFactor = loadFactors(layerFile, layers);
+  }
+  else {
+    uint32_t segmentSize = layers / 3;
+
+    layerFactor = std::vector<float>(layers);
+
+    for (uint32_t segment = 0; segment < 3; segment++) {
+      uint32_t last = segment == 2 ? layers : (segment + 1) * segmentSize;
+      float factor = 1.00;
+
+      for (uint32_t i = segment * segmentSize; i < last; i++) {
+        layerFactor[i] = factor;
+        factor = factor + 0.01;
+      }
+    }
+  }
+
+  if (blockFile.length() > 0) {
+    blockFactor = loadFactors(blockFile, blocks);
+  }
+  else {
+    blockFactor = std::vector<float>(blocks, 1.f);
+  }
+
+  if (dieFile.length() > 0) {
+    std::vector<float> dieFactor = loadFactors(dieFile, 0);
+
+    for (uint32_t i = 0; i < blocks; i++) {
+      blockFactor[i] *= dieFactor[i % dieFactor.size()];
+    }
+  }
+}
+
 void ErrorModeling::setTemperature(float newTemp) {
   temperature = newTemp;
+
+  updateArrheniusFactor();
+}
+
+// Box-Muller over a whole pool, so the loops have no dependency between
+// samples and no rejection
+void ErrorModeling::fillNormalPool() {
+  const double scale = 1.0 / 4294967296.0;
+  const double twoPi = 6.283185307179586;
+  uint32_t half = NORMAL_POOL_SIZE / 2;
+  double u1[NORMAL_POOL_SIZE / 2];
+  double u2[NORMAL_POOL_SIZE / 2];
+
+  // Uniform in (0, 1)
+  for (uint32_t i = 0; i < half; i++) {
+    u1[i] = (generator() + 0.5) * scale;
+    u2[i] = (generator() + 0.5) * scale;
+  }
+
+  for (uint32_t i = 0; i < half; i++) {
+    double r = sqrt(-2.0 * log(u1[i]));
+
+    normalPool[i] = r * cos(twoPi * u2[i]);
+    normalPool[i + half] = r * sin(twoPi * u2[i]);
+  }
+
+  normalIndex = 0;
+}
+
+void ErrorModeling::updateArrheniusFactor() {
+  float kb = 8.62 * pow(10, -5);
+  float Ea = activationEnergy;
+
+  arrheniusFactor = exp((Ea/kb) * (1/roomTemp - 1/temperature));
+
+  buildRetentionTable();
+}
+
+// Tabulate log(retention time) of each refresh period. With model
+//   RBER = exp((alpha * PE + beta) * log(t) + gamma * PE + epsilon) * factor
+// RBER of period i is one exp over this table.
+void ErrorModeling::setRefreshSchedule(uint64_t period, uint32_t count) {
+  schedulePeriod = period;
+  scheduleCount = count;
+
+  buildRetentionTable();
+}
+
+void ErrorModeling::buildRetentionTable() {
+  logRetention = std::vector<double>(scheduleCount);
+  survival.clear();
+
+  for (uint32_t i = 0; i < scheduleCount; i++) {
+    // Same conversion as getRBER
+    uint64_t retentionTime = arrhenius(schedulePeriod * i);
+
+    retentionTime = retentionTime / 1000000000000;  // time unit : sec
+    logRetention[i] = log(retentionTime);
+  }
+}
+
+// Survival curve S of refresh scheduling. Period i draws noisy RBER
+// rber_i + sigma * N(0, 1) as getRBER does, so RBER stays within maxRBER in
+// periods 1 to i with probability
+//   S[i] = prod_{j <= i} Phi((maxRBER - rber_j) / sigma)
+const std::vector<double> &ErrorModeling::getSurvival(float peCycle,
+                                                      float factor,
+                                                      float maxRBER) {
+  auto key = std::make_tuple(peCycle, factor, maxRBER);
+  auto iter = survival.find(key);
+
+  if (iter != survival.end()) {
+    return iter->second;
+  }
+
+  if (survival.size() >= SURVIVAL_TABLE_LIMIT) {
+    survival.clear();
+  }
+
+  std::vector<double> &table = survival[key];
+  uint32_t count = logRetention.size();
+  float slope = alpha * peCycle + beta;
+  float offset = gamma * peCycle;
+  double p = 1.0;
+
+  table.resize(count);
+
+  if (count > 0) {
+    table[0] = 1.0;
+  }
+
+  for (uint32_t i = 1; i < count; i++) {
+    // Same arithmetic as getRBER
+    double rber = exp(slope * logRetention[i] + offset + epsilon) * factor;
+
+    if (sigma > 0.f) {
+      p *= 0.5 * erfc((rber - maxRBER) / (sigma * sqrt(2.0)));
+    }
+    else if (rber > maxRBER) {
+      p = 0.0;
+    }
+
+    table[i] = p;
+  }
+
+  return table;
+}
+
+// First refresh period i (1 <= i < queue count) whose noisy RBER exceeds
+// maxRBER, or queue count if it does not exceed maxRBER in any period.
+// Same distribution as drawing getRBER at each period in order, by inverting
+// survival curve with one uniform sample.
+uint32_t ErrorModeling::getRefreshIndex(float peCycle, uint32_t block,
+                                        uint32_t layer, float maxRBER) {
+  if (logRetention.size() < 2) {
+    return logRetention.size();
+  }
+
+  const std::vector<double> &table =
+      getSurvival(peCycle, layerFactor[layer] * blockFactor[block], maxRBER);
+  double u = getUniform();
+
+  // Index > i with probability S[i], and S is non-increasing
+  auto iter = std::partition_point(table.begin() + 1, table.end(),
+                                   [u](double s) { return s >= u; });
+
+  return iter - table.begin();
 }
 /*
 float ErrorModeling::getAterm(float peCycle) {
@@ -114,12 +284,9 @@ float ErrorModeling::getLayerFactor(uint32_t layer){
 }
 
 float ErrorModeling::arrhenius(float t2){
-  float kb = 8.62 * pow(10, -5);
-  float Ea = activationEnergy;
-
   float t1;
 
-  t1 = t2 * exp((Ea/kb) * (1/roomTemp - 1/temperature));
+  t1 = t2 * arrheniusFactor;
 
   return t1;
 }
@@ -154,7 +321,7 @@ float ErrorModeling::getRBER(float retentionTime, float peCycle, uint32_t layer)
   return rber;
 }
 */
-float ErrorModeling::getRBER(uint64_t retentionTime, float peCycle, uint32_t layer){ //Y.Luo 3D NAND version
+float ErrorModeling::getRBER(uint64_t retentionTime, float peCycle, uint32_t block, uint32_t layer){ //Y.Luo 3D NAND version
   
   double rber;
   //std::cout << "retentionTime " << retentionTime << std::endl;
@@ -172,11 +339,9 @@ float ErrorModeling::getRBER(uint64_t retentionTime, float peCycle, uint32_t lay
   //std::cout << "layer " << layer << std::endl;
   //std::cout << "layer factor " << layerFactor[layer] << std::endl;
   
-  rber = rber * layerFactor[layer];  
+  rber = rber * (layerFactor[layer] * blockFactor[block]);
 
-  std::normal_distribution<double> normal(rber, sigma);
-  
-  double randRber = normal(generator);
+  double randRber = rber + sigma * getNormal();
 
   //std::cout << "rand RBER " << randRber << std::endl<< std::endl;
 
@@ -185,9 +350,9 @@ float ErrorModeling::getRBER(uint64_t retentionTime, float peCycle, uint32_t lay
 
 
 uint32_t ErrorModeling::getRandError(float retentionTime, float peCycle,
-                                     uint32_t layer){
+                                     uint32_t block, uint32_t layer){
                                        
-  float rber = getRBER(retentionTime, peCycle, layer);
+  float rber = getRBER(retentionTime, peCycle, block, layer);
   //std::cout << "rber " << rber << std::endl;
   //std::cout << "pecycle " << peCycle << std::endl;
   //std::cout << "retentionTime " << retentionTime << std::endl;
@@ -198,9 +363,7 @@ uint32_t ErrorModeling::getRandError(float retentionTime, float peCycle,
 
   averageError = rber * pageSize * 8;
 
-  std::normal_distribution<double> normal(averageError, sigma);
-
-  errorCount = normal(generator);
+  errorCount = averageError + sigma * getNormal();
 
   if (errorCount < 0){
     errorCount = 0;
@@ -211,9 +374,9 @@ uint32_t ErrorModeling::getRandError(float retentionTime, float peCycle,
 }
 
 uint32_t ErrorModeling::getAverageError(float retentionTime, float peCycle,
-                                      uint32_t layer){
+                                      uint32_t block, uint32_t layer){
                                        
-  float rber = getRBER(retentionTime, peCycle, layer);
+  float rber = getRBER(retentionTime, peCycle, block, layer);
   //std::cout << "rber " << rber << std::endl;
   //std::cout << "pecycle " << peCycle << std::endl;
   //std::cout << "retentionTime " << retentionTime << std::endl;
@@ -21,7 +21,11 @@
 #define __FTL_ERROR_MODELING__
 
 #include <cinttypes>
+#include <map>
 #include <random>
+#include <string>
+#include <tuple>
+#include <vector>
 
 
 namespace SimpleSSD {
@@ -53,16 +57,51 @@ class ErrorModeling {
   float m;
   float n;
 
-  std::vector<float> layerFactor;
+  // Layer model, indexed directly by getRBER. Die variation is folded into
+  // blockFactor.
+  std::vector<float> layerFactor;   // per layer
+  std::vector<float> blockFactor;   // per block
   
   float sigma;
   std::mt19937 generator;
 
+  // Standard normal samples, generated in batches
+  std::vector<double> normalPool;
+  uint32_t normalIndex;
+
+  // Retention time scale from high temp to room temp
+  double arrheniusFactor;
+
+  // log(retention time in sec) after i refresh periods, i < queue count
+  uint64_t schedulePeriod;
+  uint32_t scheduleCount;
+  std::vector<double> logRetention;
+
+  // Probability that RBER stays within maxRBER in periods 1 to i, per
+  // (PE cycle, layer/block factor, maxRBER). Built on first use.
+  std::map<std::tuple<float, float, float>, std::vector<double>> survival;
+
+  void fillNormalPool();
+  inline double getNormal() {
+    if (normalIndex == normalPool.size()) {
+      fillNormalPool();
+    }
+
+    return normalPool[normalIndex++];
+  }
+  inline double getUniform() {
+    return (generator() + 0.5) / 4294967296.0;
+  }
+
+  void updateArrheniusFactor();
+  void buildRetentionTable();
+  const std::vector<double> &getSurvival(float, float, float);
   float arrhenius(float);   // convert time in high temp to time in room temp
   float getAterm(float);
   float getBterm(float);
 
   float getLayerFactor(uint32_t);
+  static std::vector<float> loadFactors(std::string, uint32_t);
 
 
 
@@ -72,11 +111,15 @@ class ErrorModeling {
                 float, float, float, float, uint32_t, uint32_t);
   ~ErrorModeling();
   void setTemperature(float);
+  void setLayerModel(uint32_t, uint32_t, std::string, std::string,
+                     std::string);
+  void setRefreshSchedule(uint64_t, uint32_t);
 
   //float getRBER(float, float);
-  float getRBER(uint64_t, float, uint32_t);
-  uint32_t getRandError(float, float, uint32_t);
-  uint32_t getAverageError(float, float, uint32_t);
+  float getRBER(uint64_t, float, uint32_t, uint32_t);
+  uint32_t getRefreshIndex(float, uint32_t, uint32_t, float);
+  uint32_t getRandError(float, float, uint32_t, uint32_t);
+  uint32_t getAverageError(float, float, uint32_t, uint32_t);
 };
 
 }  // namespace FTL
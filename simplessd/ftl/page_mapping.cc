@@ -26,17 +26,52 @@
 #include "util/algorithm.hh"
 #include "util/bitset.hh"
 
-SimpleSSD::Event refreshEvent;
-
 namespace SimpleSSD {
 
 namespace FTL {
 
+PageMappingConfig PageMapping::readConfig(ConfigReader &conf) {
+  PageMappingConfig ret;
+
+  ret.initialEraseCount = conf.readUint(CONFIG_FTL, FTL_INITIAL_ERASE_COUNT);
+  ret.randomIOTweak = conf.readBoolean(CONFIG_FTL, FTL_USE_RANDOM_IO_TWEAK);
+
+  ret.gcMode = (GC_MODE)conf.readInt(CONFIG_FTL, FTL_GC_MODE);
+  ret.evictPolicy = (EVICT_POLICY)conf.readInt(CONFIG_FTL, FTL_GC_EVICT_POLICY);
+  ret.gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
+  ret.reclaimBlock = conf.readUint(CONFIG_FTL, FTL_GC_RECLAIM_BLOCK);
+  ret.reclaimThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_RECLAIM_THRESHOLD);
+  ret.dChoiceParam = conf.readUint(CONFIG_FTL, FTL_GC_D_CHOICE_PARAM);
+  ret.recoParam = conf.readFloat(CONFIG_FTL, FTL_GC_RECO_PARAM);
+  ret.badBlockThreshold = conf.readUint(CONFIG_FTL, FTL_BAD_BLOCK_THRESHOLD);
+  ret.copybackLimit = conf.readUint(CONFIG_FTL, FTL_COPYBACK_LIMIT);
+
+  ret.refreshFilterNum = conf.readUint(CONFIG_FTL, FTL_REFRESH_FILTER_NUM);
+  ret.refreshMaxRBER = conf.readFloat(CONFIG_FTL, FTL_REFRESH_MAX_RBER);
+  ret.refreshMode = conf.readUint(CONFIG_FTL, FTL_REFRESH_MODE);
+  ret.refreshGroupingSize =
+      conf.readUint(CONFIG_FTL, FTL_REFRESH_GROUPING_SIZE);
+  ret.refreshMaxLayerNum = conf.readUint(CONFIG_FTL, FTL_REFRESH_MAX_LAYER_NUM);
+  ret.refreshChunkLayerNum =
+      conf.readUint(CONFIG_FTL, FTL_REFRESH_CHUNK_LAYER_NUM);
+  ret.refreshIdleTime = conf.readUint(CONFIG_FTL, FTL_REFRESH_IDLE_TIME);
+
+  ret.layerCount = conf.readUint(CONFIG_FTL, FTL_LAYER_COUNT);
+
+  ret.hotColdSeparation =
+      conf.readUint(CONFIG_FTL, FTL_HOT_COLD_SEPERATION) != 0;
+  ret.hotBlockRatio = conf.readFloat(CONFIG_FTL, FTL_HOT_BLOCK_RATIO);
+  ret.coolDownWindowSize = conf.readUint(CONFIG_FTL, FTL_COOL_DOWN_WINDOW_SIZE);
+
+  return ret;
+}
+
 PageMapping::PageMapping(ConfigReader &c, Parameter &p, PAL::PAL *l,
                          DRAM::AbstractDRAM *d)
     : AbstractFTL(p, l, d),
       pPAL(l),
       conf(c),
+      cfg(readConfig(c)),
       lastFreeBlock(param.pageCountToMaxPerf),
       lastFreeBlockIOMap(param.ioUnitInPage),
       bReclaimMore(false),
@@ -47,42 +82,64 @@ PageMapping::PageMapping(ConfigReader &c, Parameter &p, PAL::PAL *l,
       lastHotFreeBlockIOMap(param.ioUnitInPage),
       lastColdFreeBlockIOMap(param.ioUnitInPage),
       lastCoolFreeBlockIOMap(param.ioUnitInPage) {
+  selectPolicy();
+
   blocks.reserve(param.totalPhysicalBlocks);
-  table.reserve(param.totalLogicalBlocks * param.pagesInBlock);
+  freeBlocks.init(param.pageCountToMaxPerf);
+  hotFreeBlocks.init(param.pageCountToMaxPerf);
+  coldFreeBlocks.init(param.pageCountToMaxPerf);
 
-  uint32_t initEraseCount = conf.readUint(CONFIG_FTL, FTL_INITIAL_ERASE_COUNT);
+  if (cfg.copybackLimit > 0) {
+    if (cfg.copybackLimit > 255) {
+      panic("Copyback limit should be less than 256");
+    }
 
-  uint32_t hotColdSeparation = conf.readUint(CONFIG_FTL, FTL_HOT_COLD_SEPERATION);
+    copybackCount.resize(
+        (uint64_t)param.totalPhysicalBlocks * param.pagesInBlock, 0);
+  }
+
+  uint32_t initEraseCount = cfg.initialEraseCount;
 
-  if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
+  if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
     std::cout << "hot/cold separation disabled" << std::endl;
     for (uint32_t i = 0; i < param.totalPhysicalBlocks; i++) {
-      freeBlocks.emplace_back(Block(i, param.pagesInBlock, param.ioUnitInPage, initEraseCount));
+      blocks.emplace_back(Block(i, param.pagesInBlock, param.ioUnitInPage, initEraseCount));
+      freeBlocks.push(i, initEraseCount);
     }
     nFreeBlocks = param.totalPhysicalBlocks;
+    nHotFreeBlocks = 0;
+    nColdFreeBlocks = 0;
   }
   else {  /* hot/cold seperation enabled */
     std::cout << "hot/cold separation enabeled" << std::endl;
     nFreeBlocks = param.totalPhysicalBlocks;
-    coldRatio = 1 - conf.readFloat(CONFIG_FTL, FTL_HOT_BLOCK_RATIO);
-    hotBlocksLimit = nFreeBlocks * conf.readFloat(CONFIG_FTL, FTL_HOT_BLOCK_RATIO);
+    coldRatio = 1 - cfg.hotBlockRatio;
+    hotBlocksLimit = nFreeBlocks * cfg.hotBlockRatio;
     coldBlocksLimit = nFreeBlocks - hotBlocksLimit;
 
     nHotFreeBlocks = hotBlocksLimit; 
     nColdFreeBlocks = coldBlocksLimit;
-    nCooldownBlocks = conf.readUint(CONFIG_FTL, FTL_COOL_DOWN_WINDOW_SIZE);
-
-    hotPoolBlocks.reserve(nHotFreeBlocks);
-    coolDownBlocks.reserve(nCooldownBlocks);
+    nCooldownBlocks = cfg.coolDownWindowSize;
 
     for (uint32_t i = 0; i < nHotFreeBlocks; i++) {
-      hotFreeBlocks.emplace_back(Block(i, param.pagesInBlock, param.ioUnitInPage, initEraseCount, HOT));
+      blocks.emplace_back(Block(i, param.pagesInBlock, param.ioUnitInPage, initEraseCount, HOT));
+      hotFreeBlocks.push(i, initEraseCount);
     }
     for (uint32_t i = nHotFreeBlocks; i < nHotFreeBlocks + nColdFreeBlocks; i++) {
-      coldFreeBlocks.emplace_back(Block(i, param.pagesInBlock, param.ioUnitInPage, initEraseCount, COLD));
+      blocks.emplace_back(Block(i, param.pagesInBlock, param.ioUnitInPage, initEraseCount, COLD));
+      coldFreeBlocks.push(i, initEraseCount);
     }
   }
 
+  // Victim candidates are indexed as blocks become full
+  victimIndex.init(param.totalPhysicalBlocks,
+                   param.pagesInBlock * param.ioUnitInPage,
+                   cfg.evictPolicy, cfg.recoParam);
+
+  for (auto &block : blocks) {
+    block.setVictimIndex(&victimIndex);
+  }
+
   status.totalLogicalPages = param.totalLogicalBlocks * param.pagesInBlock;
 
   //std::cout << "param.pageCountToMaxPerf: " << param.pageCountToMaxPerf << std::endl;
@@ -90,7 +147,7 @@ PageMapping::PageMapping(ConfigReader &c, Parameter &p, PAL::PAL *l,
 
   // Allocate free blocks
   for (uint32_t i = 0; i < param.pageCountToMaxPerf; i++) {
-    if (hotColdSeparation == 0) {
+    if (!cfg.hotColdSeparation) {
       lastFreeBlock.at(i) = getFreeBlock(i);
     }
     else {  /* hot/cold seperation enabled */
@@ -107,9 +164,16 @@ PageMapping::PageMapping(ConfigReader &c, Parameter &p, PAL::PAL *l,
 
   memset(&stat, 0, sizeof(stat));
 
-  bRandomTweak = conf.readBoolean(CONFIG_FTL, FTL_USE_RANDOM_IO_TWEAK);
+  bRandomTweak = cfg.randomIOTweak;
   bitsetSize = bRandomTweak ? param.ioUnitInPage : 1;
 
+  table.init(status.totalLogicalPages, bitsetSize,
+             {param.totalPhysicalBlocks, param.pagesInBlock});
+
+  std::cout << "page mapping table: " << status.totalLogicalPages
+            << " logical pages, " << table.getMemoryUsage() / 1048576.0
+            << " MiB" << std::endl;
+
   float tmp = conf.readFloat(CONFIG_FTL, FTL_TEMPERATURE);
   float Ea = 1.1;
   float epsilon = conf.readFloat(CONFIG_FTL, FTL_EPSILON);
@@ -126,6 +190,10 @@ PageMapping::PageMapping(ConfigReader &c, Parameter &p, PAL::PAL *l,
   errorModel = ErrorModeling(tmp, Ea, epsilon, alpha, beta, gamma,
                              kTerm, mTerm, nTerm, 
                              sigma, param.pageSize, seed);
+  errorModel.setLayerModel(cfg.layerCount, param.totalPhysicalBlocks,
+                           conf.readString(CONFIG_FTL, FTL_LAYER_FACTOR_FILE),
+                           conf.readString(CONFIG_FTL, FTL_BLOCK_VARIATION_FILE),
+                           conf.readString(CONFIG_FTL, FTL_DIE_VARIATION_FILE));
 }
 
 PageMapping::~PageMapping() {
@@ -177,64 +245,63 @@ bool PageMapping::initialize() {
 
     //setup refresh
   //uint64_t random_seed = conf.readUint(CONFIG_FTL, FTL_RANDOM_SEED);
-  uint32_t num_bf = conf.readUint(CONFIG_FTL, FTL_REFRESH_FILTER_NUM);
+  uint32_t num_bf = cfg.refreshFilterNum;
   //uint32_t filter_size = conf.readUint(CONFIG_FTL, FTL_REFRESH_FILTER_SIZE);
   //debugprint(LOG_FTL_PAGE_MAPPING, "Refresh setting start. The number of bloom filters: %u", num_bf);
   //debugprint(LOG_FTL_PAGE_MAPPING, "Refresh threshold error count: %u", param.pageSize / 1000);
   
   
-  //deque version
-  for (uint32_t i=0; i<num_bf; i++){
-    refreshQueues.push_back(std::deque<uint32_t>());
-    checkedQueues.push_back(std::deque<uint32_t>());
-  }
-  insertedLayerCheck = Bitset(DIVCEIL(param.totalPhysicalBlocks * param.pagesInBlock, 8)); 
-  // Note : 8 = # of pages for each layer
-  insertedLayerCheck.reset();
+  refreshQueue.init(num_bf, param.totalPhysicalBlocks * cfg.layerCount);
 
   insertedGroupCheck = Bitset(DIVCEIL(param.totalPhysicalBlocks * param.pagesInBlock, 8)); 
   // Note : 8 = # of pages for each layer
   insertedGroupCheck.reset();
 
-  layerQueueNum = std::vector<uint32_t>(DIVCEIL(param.totalPhysicalBlocks * param.pagesInBlock, 8));
-
   // total physical blocks : total blocks in SSD
   // total logical blocks : total blocks that host can use (smaller than physical because of OP)
 
   debugprint(LOG_FTL_PAGE_MAPPING, "DIVCEIL(param.totalLogicalBlocks * param.pagesInBlock, 8): %u", DIVCEIL(param.totalLogicalBlocks * param.pagesInBlock, 8));
-  debugprint(LOG_FTL_PAGE_MAPPING, "insertedLayerCheck.size(): %u", insertedLayerCheck.size());
 
   
 
   // set up periodic refresh event
   refresh_period = 3600000000000000*2;  // 1hour
   background_ratio = 1;     // refresh period / background refresh period
+
+  errorModel.setRefreshSchedule(refresh_period, cfg.refreshFilterNum);
   
   if (refresh_period > 0) {
-    refreshEvent = engine.allocateEvent([this](uint64_t tick) {
+    refreshEvent = allocate([this](uint64_t tick) {
       refresh_event(tick);
 
-      /*engine.scheduleEvent(
+      /*schedule(
           refreshEvent,
           tick + conf.readUint(CONFIG_FTL, FTL_REFRESH_PERIOD) *
                      1000000000ULL);*/
-      engine.scheduleEvent(
+      schedule(
           refreshEvent,
           tick + 7200000000000000);   //1800000000000000 : 0.5 day
     });
-    engine.scheduleEvent(
+    schedule(
         refreshEvent, 7200000000000000);    // 1800000000000000 0.5 day
   }
 
   stat.refreshCallCount = 0;
-  debugprint(LOG_FTL_PAGE_MAPPING, "Refresh setting done. The number of queues: %u", refreshQueues.size());
+
+  refreshChunkInterval = refresh_period;
+  refreshChunkDeadline = 0;
+  hostBusyUntil = 0;
+  refreshBusyUntil = 0;
+  refreshChunkEvent =
+      allocate([this](uint64_t tick) { refreshChunk(tick); });
+  debugprint(LOG_FTL_PAGE_MAPPING, "Refresh setting done. The number of queues: %u", refreshQueue.size());
   
-  uint32_t hotColdSeparation = conf.readUint(CONFIG_FTL, FTL_HOT_COLD_SEPERATION);
+
 
   // Step 1. Filling
   if (mode == FILLING_MODE_0 || mode == FILLING_MODE_1) {
     // Sequential
-    if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
+    if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
       for (uint64_t i = 0; i < nPagesToWarmup; i++) {
         tick = 0;
         req.lpn = i;
@@ -333,7 +400,7 @@ void PageMapping::refresh_event(uint64_t tick){
 
 
   uint64_t refreshcallCount = stat.refreshCallCount / background_ratio;
-  uint32_t target_queue = (refreshcallCount + 1) % refreshQueues.size();
+  uint32_t target_queue = (refreshcallCount + 1) % refreshQueue.size();
 
   //refreshRotationCount = (refreshcallCount + 1) / refreshQueues.size();
   
@@ -365,19 +432,23 @@ void PageMapping::refresh_event(uint64_t tick){
   // if level 3 is refreshed for 4th interval, level 1, 2 also should be refreshed
 
   //for (uint32_t i = 0; i <= target_queue; i++){
-  std::deque<uint32_t> tempQueue = checkedQueues[target_queue];
-  checkedQueues[target_queue] = refreshQueues[target_queue];
-  refreshQueues[target_queue] = tempQueue;
-  refreshPage(target_queue, tick);
+  refreshQueue.swap(target_queue);
+
+  if (cfg.refreshChunkLayerNum == 0) {
+    // Refresh all layers at once, blocking host I/O behind it
+    uint64_t beginAt = tick;
+
+    refreshPage(target_queue, cfg.refreshMaxLayerNum, beginAt);
+
+    stat.refreshChunks++;
+    stat.refreshBusyTime += beginAt - tick;
+    refreshBusyUntil = MAX(refreshBusyUntil, beginAt);
+  }
+  else {
+    startBackgroundRefresh(target_queue, tick);
+  }
   //}
-  
-  // TODO : This can make huge performance overehead. 
-  //        It can be reduced by refreshing in background with maxRefreshPage in refreshPage function
 
-  // TODO : The 2 queue should be maintained during background refresh
-  //        One for should be refreshed and the other for new refresh queue
-  //        Currently there is only one queue for each level.
-  
 
   stat.refreshCallCount++;
   stat.layerCheckCount += 0;
@@ -385,257 +456,302 @@ void PageMapping::refresh_event(uint64_t tick){
   //debugprint(LOG_FTL_PAGE_MAPPING, "Refresh event end");
 }
 
+// Queue checked layers of target queue for background refresh, and spread
+// all queued layers over one refresh period
+void PageMapping::startBackgroundRefresh(uint32_t queueNum, uint64_t tick) {
+  RefreshJob job;
+  uint64_t layers = 0;
+
+  job.queue = queueNum;
+  job.budget = MIN(cfg.refreshMaxLayerNum,
+                   refreshQueue.getCheckedCount(queueNum));
+
+  if (job.budget > 0) {
+    refreshJobs.push_back(job);
+  }
+
+  for (auto &iter : refreshJobs) {
+    layers += iter.budget;
+  }
+
+  if (layers == 0) {
+    return;
+  }
+
+  refreshChunkInterval =
+      refresh_period / DIVCEIL(layers, cfg.refreshChunkLayerNum);
+
+  if (!scheduled(refreshChunkEvent)) {
+    refreshChunkDeadline = tick + refreshChunkInterval;
+    schedule(refreshChunkEvent, tick);
+  }
+}
+
+void PageMapping::refreshChunk(uint64_t tick) {
+  uint64_t idleAt = hostBusyUntil + cfg.refreshIdleTime;
+
+  if (refreshJobs.empty()) {
+    return;
+  }
+
+  // Host is busy, resume when host becomes idle
+  if (tick < idleAt && tick < refreshChunkDeadline) {
+    stat.refreshDeferredChunks++;
+    schedule(refreshChunkEvent, MIN(idleAt, refreshChunkDeadline));
+
+    return;
+  }
+
+  RefreshJob &job = refreshJobs.front();
+  uint32_t layers = MIN(cfg.refreshChunkLayerNum, job.budget);
+  uint64_t beginAt = tick;
+
+  // Checked list is drained when fewer layers are refreshed than requested
+  if (refreshPage(job.queue, layers, beginAt) < layers ||
+      job.budget == layers) {
+    refreshJobs.pop_front();
+  }
+  else {
+    job.budget -= layers;
+  }
+
+  stat.refreshChunks++;
+  stat.refreshBusyTime += beginAt - tick;
+  refreshBusyUntil = MAX(refreshBusyUntil, beginAt);
+
+  if (!refreshJobs.empty()) {
+    uint64_t next = MAX(beginAt, tick + refreshChunkInterval);
+
+    refreshChunkDeadline = next + refreshChunkInterval;
+    schedule(refreshChunkEvent, next);
+  }
+}
+
+// Track host I/O for idle detection and refresh interference
+void PageMapping::updateHostIO(uint64_t begin, uint64_t end) {
+  if (begin < refreshBusyUntil) {
+    stat.refreshOverlappedHostIO++;
+    stat.refreshOverlappedHostTime += MIN(end, refreshBusyUntil) - begin;
+  }
+
+  hostBusyUntil = MAX(hostBusyUntil, end);
+}
+
 // insert to refresh queue
 void PageMapping::setRefreshPeriod(uint32_t eraseCount, uint32_t blockNum, uint32_t layerNum){
+  (this->*pSetRefreshPeriod)(eraseCount, blockNum, layerNum);
+}
 
-  //debugprint(LOG_FTL_PAGE_MAPPING, "start set refresh period: %u, %u", blockNum, layerNum);
+// Grouping mode 0: single layer
+template <>
+void PageMapping::setRefreshPeriodMode<0>(uint32_t eraseCount,
+                                          uint32_t blockNum,
+                                          uint32_t layerNum) {
   uint64_t refreshcallCount = stat.refreshCallCount / background_ratio;
-  uint32_t num_queue = conf.readUint(CONFIG_FTL, FTL_REFRESH_FILTER_NUM);
+  uint32_t num_queue = cfg.refreshFilterNum;
   uint32_t cur_queue = refreshcallCount % num_queue;
-  float maxRBER = conf.readFloat(CONFIG_FTL, FTL_REFRESH_MAX_RBER);
-
-  uint32_t groupingMode = conf.readUint(CONFIG_FTL, FTL_REFRESH_MODE);    // 0: single layer, 1: neighbor 3 layers, 2 : similar loaction b.t.w segments
+  float maxRBER = cfg.refreshMaxRBER;
 
+  uint32_t layerID = blockNum * cfg.layerCount + layerNum;
 
-  //debugprint(LOG_FTL_PAGE_MAPPING, "maxRBER: %f", maxRBER);
+  //if (insertedLayerCheck.test(layerID)){   // The layer is already in queue. It has to be erased first.
+  //  removeFromQueue(layerID);
+  //}
+  //insertedLayerCheck.set(layerID, true);
 
-  if (groupingMode == 0) {
-    uint32_t layerID = blockNum * 64 + layerNum;
+  // First refresh period exceeding maxRBER, num_queue if none
+  uint32_t i = errorModel.getRefreshIndex(eraseCount, blockNum, layerNum, maxRBER);
 
-    //if (insertedLayerCheck.test(layerID)){   // The layer is already in queue. It has to be erased first.
-    //  removeFromQueue(layerID);
-    //}
-    //insertedLayerCheck.set(layerID, true);
+  insertToQueue(cur_queue + i, layerID);
 
-    for (uint32_t i = 1; i <= num_queue; i++){
+  /*
+  if (!insertedLayerCheck.test(layerID)){  
+    for (uint32_t i = 1, j = 1; i <= num_queue; i++, j=j+1){
       if (i == num_queue) {
-        insertToQueue(cur_queue, layerID);
+        refreshQueues[cur_queue].push_back(layerID);
+        layerQueueNum[layerID] = cur_queue;
         break;
       }
     
-      float newRBER = errorModel.getRBER(refresh_period * i, eraseCount, layerID % 64);
+      float newRBER = errorModel.getRBER(refresh_period * j, eraseCount, layerID % 64);
 
-      if (newRBER > maxRBER){ //0.00018){
-        insertToQueue(cur_queue + i, layerID);
-        break;
+      if (newRBER > 0.00018){ //0.00018){
+        refreshQueues[(cur_queue + j) % num_queue].push_back(layerID);
+        layerQueueNum[layerID] = (cur_queue + j) % num_queue;
+        break; // In deque version, we should insert layer to only one deque
       }
     }
+    insertedLayerCheck.set(layerID,true);
+  }
+  */
+}
 
-    /*
-    if (!insertedLayerCheck.test(layerID)){  
-      for (uint32_t i = 1, j = 1; i <= num_queue; i++, j=j+1){
-        if (i == num_queue) {
-          refreshQueues[cur_queue].push_back(layerID);
-          layerQueueNum[layerID] = cur_queue;
-          break;
-        }
-      
-        float newRBER = errorModel.getRBER(refresh_period * j, eraseCount, layerID % 64);
+// Grouping mode 1: neighbor layers (RefreshGroupingSize)
+template <>
+void PageMapping::setRefreshPeriodMode<1>(uint32_t eraseCount,
+                                          uint32_t blockNum,
+                                          uint32_t layerNum) {
+  uint64_t refreshcallCount = stat.refreshCallCount / background_ratio;
+  uint32_t num_queue = cfg.refreshFilterNum;
+  uint32_t cur_queue = refreshcallCount % num_queue;
+  float maxRBER = cfg.refreshMaxRBER;
 
-        if (newRBER > 0.00018){ //0.00018){
-          refreshQueues[(cur_queue + j) % num_queue].push_back(layerID);
-          layerQueueNum[layerID] = (cur_queue + j) % num_queue;
-          break; // In deque version, we should insert layer to only one deque
-        }
-      }
-      insertedLayerCheck.set(layerID,true);
+  //uint32_t layerID = blockNum * 64 + layerNum;
+  uint32_t groupingSize = cfg.refreshGroupingSize;
+  uint32_t groupFirst = (layerNum / groupingSize) * groupingSize;
+  
+  uint32_t layerCount = cfg.layerCount;
+
+  if (layerNum == groupFirst){  // Only group first layer can insert the group
+    uint32_t groupLast = groupFirst + groupingSize - 1;
+    if (groupLast >= layerCount){
+      groupLast = layerCount - 1;
     }
-    */
-  }
-  else if (groupingMode == 1) {
-    //uint32_t layerID = blockNum * 64 + layerNum;
-    uint32_t groupingSize = conf.readUint(CONFIG_FTL, FTL_REFRESH_GROUPING_SIZE);
-    uint32_t groupFirst = (layerNum / groupingSize) * groupingSize;
-    
-    if (layerNum == groupFirst){  // Only group first layer can insert the group
-      for (uint32_t i = 1; i <= num_queue; i++){
-        if (i == num_queue) {
-          for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < 64); k ++){
-            insertToQueue(cur_queue, (blockNum * 64) + groupFirst + k);
-          }
-          break;
-        }
 
-        uint32_t groupLast = groupFirst + groupingSize - 1;
-        if (groupLast >=64){
-          groupLast = 63;
-        }
-        float newRBER = errorModel.getRBER(refresh_period * i, eraseCount, groupLast);
+    uint32_t i = errorModel.getRefreshIndex(eraseCount, blockNum, groupLast, maxRBER);
 
-        if (newRBER > maxRBER){ //0.00018
-          for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < 64); k ++){   // Second condition for last layer
-            insertToQueue((cur_queue + i) % num_queue, (blockNum * 64) + groupFirst + k);
-          }
-          break;
-        }
-      }
+    for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < layerCount); k ++){   // Second condition for last layer
+      insertToQueue((cur_queue + i) % num_queue, (blockNum * layerCount) + groupFirst + k);
     }
-    /*
-    uint32_t layerID = blockNum * 64 + layerNum;
-    uint32_t groupingSize = 7;
-    if (!insertedLayerCheck.test(layerID)){
+  }
+  /*
+  uint32_t layerID = blockNum * 64 + layerNum;
+  uint32_t groupingSize = 7;
+  if (!insertedLayerCheck.test(layerID)){
 
-      uint32_t groupFirst = (layerNum / groupingSize) * groupingSize;
-      for (uint32_t i = 1, j = 1; i <= num_queue; i++, j=j+1){
-        if (i == num_queue) {
-          for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < 64); k ++){
-            
-            // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
-            // This condition should be removed.
-            if (!insertedLayerCheck.test((blockNum * 64) + groupFirst + k)) {
-              refreshQueues[cur_queue].push_back((blockNum * 64) + groupFirst + k);
-              insertedLayerCheck.set((blockNum * 64) + groupFirst + k, true);
-            }
+    uint32_t groupFirst = (layerNum / groupingSize) * groupingSize;
+    for (uint32_t i = 1, j = 1; i <= num_queue; i++, j=j+1){
+      if (i == num_queue) {
+        for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < 64); k ++){
+          
+          // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
+          // This condition should be removed.
+          if (!insertedLayerCheck.test((blockNum * 64) + groupFirst + k)) {
+            refreshQueues[cur_queue].push_back((blockNum * 64) + groupFirst + k);
+            insertedLayerCheck.set((blockNum * 64) + groupFirst + k, true);
           }
-          break;
         }
-        uint32_t groupLast = groupFirst + groupingSize - 1;
-        if (groupLast >=64){
-          groupLast = 63;
-        }
-        
-        //std::cout << "j " << j << std::endl;
-        //debugprint(LOG_FTL_PAGE_MAPPING, "refresh period: %lu", refresh_period);
-        float newRBER = errorModel.getRBER(refresh_period * j, eraseCount, groupLast);
-        //debugprint(LOG_FTL_PAGE_MAPPING, "%u period RBER: %f", i, newRBER);
-
-        if (newRBER > 0.00032){ // 10^-4 = ECC capability
-          //debugprint(LOG_FTL_PAGE_MAPPING, "insert %u, %u, %u", block->first, layerNumber, i);
-          for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < 64); k ++){   // Second condition for last layer
-            
-            // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
-            // This condition should be removed.
-            if (!insertedLayerCheck.test((blockNum * 64) + groupFirst + k)) {
-              refreshQueues[(cur_queue + j) % num_queue].push_back((blockNum * 64) + groupFirst + k);
-              insertedLayerCheck.set((blockNum * 64) + groupFirst + k, true);
-            }
+        break;
+      }
+      uint32_t groupLast = groupFirst + groupingSize - 1;
+      if (groupLast >=64){
+        groupLast = 63;
+      }
+      
+      //std::cout << "j " << j << std::endl;
+      //debugprint(LOG_FTL_PAGE_MAPPING, "refresh period: %lu", refresh_period);
+      float newRBER = errorModel.getRBER(refresh_period * j, eraseCount, groupLast);
+      //debugprint(LOG_FTL_PAGE_MAPPING, "%u period RBER: %f", i, newRBER);
+
+      if (newRBER > 0.00032){ // 10^-4 = ECC capability
+        //debugprint(LOG_FTL_PAGE_MAPPING, "insert %u, %u, %u", block->first, layerNumber, i);
+        for (uint32_t k = 0; (k < groupingSize) && (groupFirst + k < 64); k ++){   // Second condition for last layer
+          
+          // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
+          // This condition should be removed.
+          if (!insertedLayerCheck.test((blockNum * 64) + groupFirst + k)) {
+            refreshQueues[(cur_queue + j) % num_queue].push_back((blockNum * 64) + groupFirst + k);
+            insertedLayerCheck.set((blockNum * 64) + groupFirst + k, true);
           }
-          break; // In deque version, we should insert layer to only one deque
         }
+        break; // In deque version, we should insert layer to only one deque
       }
     }
-    */
   }
-  else if (groupingMode == 2) {
-    uint32_t layerID = blockNum * 64 + layerNum;
-    if (!insertedLayerCheck.test(layerID)){
+  */
+}
 
-      uint32_t groupFirst = layerNum % 21;
-      if (layerNum == 63){
-        groupFirst = 63;
-      }
-      
-      for (uint32_t i = 1, j = 1; i <= num_queue; i++, j=j+1){
-        
-        if (i == num_queue) {
-          for (uint32_t k = 0; (k < 3) && (groupFirst + (k * 21) < 64); k ++){   // Second condition for last layer
-            
-            // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
-            // This condition should be removed.
-            uint32_t layerIndex = (blockNum * 64) + groupFirst + (k * 21);
-            if ( !insertedLayerCheck.test(layerIndex) ) {
-              refreshQueues[cur_queue].push_back(layerIndex);
-              insertedLayerCheck.set(layerIndex, true);
-            }
-          }
-          break;
-        }
-        
-        float newRBER = errorModel.getRBER(refresh_period * j, eraseCount, groupFirst);
+// Grouping mode 2: similar location between segments
+template <>
+void PageMapping::setRefreshPeriodMode<2>(uint32_t eraseCount,
+                                          uint32_t blockNum,
+                                          uint32_t layerNum) {
+  uint64_t refreshcallCount = stat.refreshCallCount / background_ratio;
+  uint32_t num_queue = cfg.refreshFilterNum;
+  uint32_t cur_queue = refreshcallCount % num_queue;
 
-        if (newRBER > 0.00032){ // 10^-4 = ECC capability
-          for (uint32_t k = 0; (k < 3) && (groupFirst + (k * 21) < 64); k ++){   // Second condition for last layer
-            
-            // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
-            // This condition should be removed.
-            uint32_t layerIndex = (blockNum * 64) + groupFirst + (k * 21);
-            if ( !insertedLayerCheck.test(layerIndex) ) {
-              refreshQueues[(cur_queue + j) % num_queue].push_back(layerIndex);
-              insertedLayerCheck.set(layerIndex, true);
-            }
-          }
-          break; // In deque version, we should insert layer to only one deque
-        }
-      }
+  uint32_t layerCount = cfg.layerCount;
+  uint32_t segmentSize = layerCount / 3;
+
+  uint32_t layerID = blockNum * layerCount + layerNum;
+  if (!refreshQueue.isQueued(layerID)){
+
+    uint32_t groupFirst = layerNum % segmentSize;
+    if (layerNum >= segmentSize * 3){   // Layers left over from segments
+      groupFirst = layerNum;
+    }
+    
+    uint32_t j = errorModel.getRefreshIndex(eraseCount, blockNum, groupFirst, 0.00032);
+
+    for (uint32_t k = 0; (k < 3) && (groupFirst + (k * segmentSize) < layerCount); k ++){   // Second condition for last layer
       
+      // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
+      // This condition should be removed.
+      uint32_t layerIndex = (blockNum * layerCount) + groupFirst + (k * segmentSize);
+      if (!refreshQueue.isQueued(layerIndex)) {
+        refreshQueue.push((cur_queue + j) % num_queue, layerIndex);
+      }
     }
+    
   }
-  else if (groupingMode == 3) {
-    uint32_t layerID = blockNum * 64 + layerNum;
-    uint32_t neighborGroupingSize = 3;
-    if (!insertedLayerCheck.test(layerID)){
+}
 
-      uint32_t groupFirst = layerNum % 21;
-      groupFirst = (groupFirst / neighborGroupingSize) * neighborGroupingSize;
-      if (layerNum == 63){
-        groupFirst = 63;
-      }
-      
-      for (uint32_t i = 1, j = 1; i <= num_queue; i++, j=j+1){
-        
-        if (i == num_queue) {
-          for (uint32_t k = 0; k < 3 ; k ++){   // k : b.t.w segements
-            for (uint32_t l = 0; (l < neighborGroupingSize) && (groupFirst + (k * 21) + l < 64); l++){  // l : neighbor
-              // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
-              // This condition should be removed.
-              uint32_t layerIndex = (blockNum * 64) + groupFirst + (k * 21) + l;
-              if ( !insertedLayerCheck.test(layerIndex) ) {
-                refreshQueues[cur_queue].push_back(layerIndex);
-                insertedLayerCheck.set(layerIndex, true);
-              }
-            }
-          }
-          break;
-        }
+// Grouping mode 3: neighbor layers of similar location between segments
+template <>
+void PageMapping::setRefreshPeriodMode<3>(uint32_t eraseCount,
+                                          uint32_t blockNum,
+                                          uint32_t layerNum) {
+  uint64_t refreshcallCount = stat.refreshCallCount / background_ratio;
+  uint32_t num_queue = cfg.refreshFilterNum;
+  uint32_t cur_queue = refreshcallCount % num_queue;
 
-        uint32_t groupLast = groupFirst + neighborGroupingSize - 1;
-        if (groupLast >=64){
-          groupLast = 63;
-        }
-        //std::cout << "layerNum " << layerNum << std::endl;
-        //std::cout << "groupFirst " << groupFirst << std::endl;
-        //std::cout << "groupLast " << groupLast << std::endl << std::endl;
-        
-        float newRBER = errorModel.getRBER(refresh_period * j, eraseCount, groupLast);
-
-        if (newRBER > 0.00032){ // 10^-4 = ECC capability
-          for (uint32_t k = 0; k < 3 ; k ++){   // k : b.t.w segements
-            for (uint32_t l = 0; (l < neighborGroupingSize) && (groupFirst + (k * 21) + l < 64); l++){  // l : neighbor
-              // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
-              // This condition should be removed.
-              uint32_t layerIndex = (blockNum * 64) + groupFirst + (k * 21) + l;
-              if ( !insertedLayerCheck.test(layerIndex) ) {
-                refreshQueues[(cur_queue + j) % num_queue].push_back(layerIndex);
-                insertedLayerCheck.set(layerIndex, true);
-              }
-            }
-          }
-          break;
+  uint32_t layerCount = cfg.layerCount;
+  uint32_t segmentSize = layerCount / 3;
+
+  uint32_t layerID = blockNum * layerCount + layerNum;
+  uint32_t neighborGroupingSize = 3;
+  if (!refreshQueue.isQueued(layerID)){
+
+    uint32_t groupFirst = layerNum % segmentSize;
+    groupFirst = (groupFirst / neighborGroupingSize) * neighborGroupingSize;
+    if (layerNum >= segmentSize * 3){   // Layers left over from segments
+      groupFirst = layerNum;
+    }
+    
+    uint32_t groupLast = groupFirst + neighborGroupingSize - 1;
+    if (groupLast >= layerCount){
+      groupLast = layerCount - 1;
+    }
+
+    uint32_t j = errorModel.getRefreshIndex(eraseCount, blockNum, groupLast, 0.00032);
+
+    for (uint32_t k = 0; k < 3 ; k ++){   // k : b.t.w segements
+      for (uint32_t l = 0; (l < neighborGroupingSize) && (groupFirst + (k * segmentSize) + l < layerCount); l++){  // l : neighbor
+        // TODO : Actually, this is wrong. Group should be refreshed together everytime in grouping mode.
+        // This condition should be removed.
+        uint32_t layerIndex = (blockNum * layerCount) + groupFirst + (k * segmentSize) + l;
+        if (!refreshQueue.isQueued(layerIndex)) {
+          refreshQueue.push((cur_queue + j) % num_queue, layerIndex);
         }
       }
-      
     }
+    
   }
-  
-  
-  
 }
 
 void PageMapping::insertToQueue(uint32_t queueNum , uint32_t layerID){
 
   // queueNum = cur_queue + i
   uint64_t refreshcallCount = stat.refreshCallCount / background_ratio;
-  uint32_t num_queue = conf.readUint(CONFIG_FTL, FTL_REFRESH_FILTER_NUM);
+  uint32_t num_queue = cfg.refreshFilterNum;
   uint32_t cur_queue = refreshcallCount % num_queue;
 
-  if (!insertedLayerCheck.test(layerID)) {
-    refreshQueues[queueNum % num_queue].push_back(layerID);
-    layerQueueNum[layerID] = queueNum % num_queue;
-    insertedLayerCheck.set(layerID, true);
+  if (!refreshQueue.isQueued(layerID)) {
+    refreshQueue.push(queueNum % num_queue, layerID);
   }
-  else if (insertedLayerCheck.test(layerID)){
+  else {
     uint32_t newQueue = queueNum % num_queue;
-    uint32_t oldQueue = layerQueueNum[layerID];
+    uint32_t oldQueue = refreshQueue.getQueue(layerID);
 
     if (newQueue <= cur_queue) {
       newQueue = newQueue + num_queue;
@@ -644,34 +760,16 @@ void PageMapping::insertToQueue(uint32_t queueNum , uint32_t layerID){
     if (oldQueue <= cur_queue) {
       oldQueue = oldQueue + num_queue;
     }
-    
 
     if (newQueue - oldQueue > 24) {   // 24 queues = 1 day
-      removeFromQueue(layerID);
-      refreshQueues[queueNum % num_queue].push_back(layerID);
-      layerQueueNum[layerID] = queueNum % num_queue;
+      // Moves the layer out of its current queue, pending or checked
+      refreshQueue.push(queueNum % num_queue, layerID);
     }
     // else if (newQueue < oldQueue) 
     // can happen because of process variation even in same layer but don't consider for now
 
     // else : do nothing
   }
-
-}
-
-void PageMapping::removeFromQueue(uint32_t layerID){
-  
-  auto queueNum = layerQueueNum[layerID];
-  for (auto iter = refreshQueues[queueNum].begin(); iter != refreshQueues[queueNum].end(); iter++){
-    if (iter == refreshQueues[queueNum].end()){
-      // This shouldn't be happened. If layer check is set, the layer should be in queue # layerQueueNum[layerID]
-      panic("Remove from queue failed, the layer is lost. Layer ID : %u, queue # : %u", layerID, queueNum);
-    }
-    if(*iter == layerID){
-      refreshQueues[queueNum].erase(iter);
-      break;
-    }
-  }
 }
 
 void PageMapping::read(Request &req, uint64_t &tick) {
@@ -679,6 +777,7 @@ void PageMapping::read(Request &req, uint64_t &tick) {
 
   if (req.ioFlag.count() > 0) {
     readInternal(req, tick);
+    updateHostIO(begin, tick);
 
     debugprint(LOG_FTL_PAGE_MAPPING,
                "READ  | LPN %" PRIu64 " | %" PRIu64 " - %" PRIu64 " (%" PRIu64
@@ -694,16 +793,18 @@ void PageMapping::read(Request &req, uint64_t &tick) {
 
 void PageMapping::write(Request &req, uint64_t &tick) {
   uint64_t begin = tick;
-  uint32_t hotColdSeparation = conf.readUint(CONFIG_FTL, FTL_HOT_COLD_SEPERATION);
+
   if (req.ioFlag.count() > 0) {
     
-    if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
+    if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
       writeInternal(req, tick);
     }
     else {  /* hot/cold seperation enabled */
       sepWriteInternal(req, tick);
     }
 
+    updateHostIO(begin, tick);
+
     debugprint(LOG_FTL_PAGE_MAPPING,
                "WRITE | LPN %" PRIu64 " | %" PRIu64 " - %" PRIu64 " (%" PRIu64
                ")",
@@ -735,29 +836,26 @@ void PageMapping::format(LPNRange &range, uint64_t &tick) {
 
   req.ioFlag.set();
 
-  for (auto iter = table.begin(); iter != table.end();) {
-    if (iter->first >= range.slpn && iter->first < range.slpn + range.nlp) {
-      auto &mappingList = iter->second;
+  for (uint64_t lpn = range.slpn; lpn < range.slpn + range.nlp; lpn++) {
+    auto mappingList = table.find(lpn);
 
+    if (mappingList) {
       // Do trim
       for (uint32_t idx = 0; idx < bitsetSize; idx++) {
-        auto &mapping = mappingList.at(idx);
-        auto block = blocks.find(mapping.first);
+        auto &mapping = mappingList[idx];
+        auto block = findBlock(mapping.first);
 
-        if (block == blocks.end()) {
+        if (!block) {
           panic("Block is not in use");
         }
 
-        block->second.invalidate(mapping.second, idx);
+        block->invalidate(mapping.second, idx);
 
         // Collect block indices
         list.push_back(mapping.first);
       }
 
-      iter = table.erase(iter);
-    }
-    else {
-      iter++;
+      table.erase(lpn);
     }
   }
 
@@ -766,8 +864,8 @@ void PageMapping::format(LPNRange &range, uint64_t &tick) {
   auto last = std::unique(list.begin(), list.end());
   list.erase(last, list.end());
 
-  uint32_t hotColdSeparation = conf.readUint(CONFIG_FTL, FTL_HOT_COLD_SEPERATION);
-  if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
+
+  if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
   // Do GC only in specified blocks
     doGarbageCollection(list, tick, false);
   }
@@ -788,7 +886,7 @@ Status *PageMapping::getStatus(uint64_t lpnBegin, uint64_t lpnEnd) {
     status.mappedLogicalPages = 0;
 
     for (uint64_t lpn = lpnBegin; lpn < lpnEnd; lpn++) {
-      if (table.count(lpn) > 0) {
+      if (table.isMapped(lpn)) {
         status.mappedLogicalPages++;
       }
     }
@@ -801,6 +899,22 @@ float PageMapping::freeBlockRatio() {
   return (float)nFreeBlocks / param.totalPhysicalBlocks;
 }
 
+Block *PageMapping::findBlock(uint32_t blockIndex) {
+  if (blockIndex >= blocks.size()) {
+    return nullptr;
+  }
+
+  Block &block = blocks[blockIndex];
+
+  // Only allocated blocks are visible
+  if (block.getBlockState() != BLOCK_OPEN &&
+      block.getBlockState() != BLOCK_FULL) {
+    return nullptr;
+  }
+
+  return &block;
+}
+
 uint32_t PageMapping::convertBlockIdx(uint32_t blockIdx) {
   return blockIdx % param.pageCountToMaxPerf;
 }
@@ -813,40 +927,23 @@ uint32_t PageMapping::getFreeBlock(uint32_t idx) {
   }
 
   if (nFreeBlocks > 0) {
-    // Search block which is blockIdx % param.pageCountToMaxPerf == idx
-    auto iter = freeBlocks.begin();
-
-    for (; iter != freeBlocks.end(); iter++) {
-      blockIndex = iter->getBlockIndex();
+    // Least worn block which is blockIdx % param.pageCountToMaxPerf == idx
+    // (or least worn one of any unit when there is no such block)
+    blockIndex = freeBlocks.pop(idx);
 
-      if (blockIndex % param.pageCountToMaxPerf == idx) {
-        break;
-      }
-    }
-
-    // Sanity check
-    if (iter == freeBlocks.end()) {
-      // Just use first one
-      iter = freeBlocks.begin();
-      blockIndex = iter->getBlockIndex();
-    }
+    Block &block = blocks[blockIndex];
 
-    // Insert found block to block list
-    if (blocks.find(blockIndex) != blocks.end()) {
+    if (block.getBlockState() != BLOCK_FREE) {
       panic("Corrupted");
     }
 
-    blocks.emplace(blockIndex, std::move(*iter));
+    block.setBlockState(BLOCK_OPEN);
 
     // Update first write time
-    blocks.find(blockIndex)->second.setLastWrittenTime(getTick());
-    
-    // Reset refresh page count
-    blocks.find(blockIndex)->second.setRefreshedPageCount(0);
+    block.setLastWrittenTime(getTick());
 
-
-    // Remove found block from free block list
-    freeBlocks.erase(iter);
+    // Reset refresh page count
+    block.setRefreshedPageCount(0);
     nFreeBlocks--;
   }
   else {
@@ -857,6 +954,31 @@ uint32_t PageMapping::getFreeBlock(uint32_t idx) {
   return blockIndex;
 }
 
+// Prefer current free block of parallel unit idx, so GC copies can stay in
+// the plane of victim block. Filling units unevenly may open a new block in
+// every unit, so this is done only while that many free blocks are left.
+uint32_t PageMapping::getLastFreeBlock(Bitset &iomap, uint32_t idx) {
+  if (nFreeBlocks < param.pageCountToMaxPerf) {
+    return getLastFreeBlock(iomap);
+  }
+
+  auto freeBlock = findBlock(lastFreeBlock.at(idx));
+
+  // Sanity check
+  if (!freeBlock) {
+    panic("Corrupted");
+  }
+
+  // If current free block is full, get next block
+  if (freeBlock->getBlockState() == BLOCK_FULL) {
+    lastFreeBlock.at(idx) = getFreeBlock(idx);
+
+    bReclaimMore = true;
+  }
+
+  return lastFreeBlock.at(idx);
+}
+
 uint32_t PageMapping::getLastFreeBlock(Bitset &iomap) {
   if (!bRandomTweak || (lastFreeBlockIOMap & iomap).any()) {
     // Update lastFreeBlockIndex
@@ -872,15 +994,15 @@ uint32_t PageMapping::getLastFreeBlock(Bitset &iomap) {
     lastFreeBlockIOMap |= iomap;
   }
 
-  auto freeBlock = blocks.find(lastFreeBlock.at(lastFreeBlockIndex));
+  auto freeBlock = findBlock(lastFreeBlock.at(lastFreeBlockIndex));
 
   // Sanity check
-  if (freeBlock == blocks.end()) {
+  if (!freeBlock) {
     panic("Corrupted");
   }
 
   // If current free block is full, get next block
-  if (freeBlock->second.getNextWritePageIndex() == param.pagesInBlock) {
+  if (freeBlock->getBlockState() == BLOCK_FULL) {
     lastFreeBlock.at(lastFreeBlockIndex) = getFreeBlock(lastFreeBlockIndex);
 
     bReclaimMore = true;
@@ -891,54 +1013,93 @@ uint32_t PageMapping::getLastFreeBlock(Bitset &iomap) {
 
 // calculate weight of each block regarding victim selection policy
 void PageMapping::calculateVictimWeight(
-    std::vector<std::pair<uint32_t, float>> &weight, const EVICT_POLICY policy,
-    uint64_t tick) {
+    std::vector<std::pair<uint32_t, float>> &weight, uint64_t tick) {
+  weight.reserve(blocks.size());
+
+  (this->*pCalculateVictimWeight)(weight, tick);
+}
+
+// Greedy, random and d-choice: valid page count
+template <>
+void PageMapping::calculateVictimWeightPolicy<POLICY_GREEDY>(
+    std::vector<std::pair<uint32_t, float>> &weight, uint64_t) {
+  for (auto &iter : blocks) {
+    if (iter.getBlockState() != BLOCK_FULL) {
+      continue;
+    }
+
+    weight.push_back({iter.getBlockIndex(), iter.getValidPageCountRaw()});
+  }
+}
+
+template <>
+void PageMapping::calculateVictimWeightPolicy<POLICY_COST_BENEFIT>(
+    std::vector<std::pair<uint32_t, float>> &weight, uint64_t tick) {
   float temp;
 
-  weight.reserve(blocks.size());
+  for (auto &iter : blocks) {
+    if (iter.getBlockState() != BLOCK_FULL) {
+      continue;
+    }
 
-  switch (policy) {
-    case POLICY_GREEDY:
-    case POLICY_RANDOM:
-    case POLICY_DCHOICE:
-      for (auto &iter : blocks) {
-        if (iter.second.getNextWritePageIndex() != param.pagesInBlock) {
-          continue;
-        }
+    temp = (float)(iter.getValidPageCountRaw()) / param.pagesInBlock;
 
-        weight.push_back({iter.first, iter.second.getValidPageCountRaw()});
-      }
+    weight.push_back(
+        {iter.getBlockIndex(),
+         temp / ((1 - temp) * (tick - iter.getLastAccessedTime()))});
+  }
+}
 
-      break;
-    case POLICY_COST_BENEFIT:
-      for (auto &iter : blocks) {
-        if (iter.second.getNextWritePageIndex() != param.pagesInBlock) {
-          continue;
-        }
+template <>
+void PageMapping::calculateVictimWeightPolicy<POLICY_RECO>(
+    std::vector<std::pair<uint32_t, float>> &weight, uint64_t) {
+  float temp;
 
-        temp = (float)(iter.second.getValidPageCountRaw()) / param.pagesInBlock;
+  for (auto &iter : blocks) {
+    if (iter.getBlockState() != BLOCK_FULL) {
+      continue;
+    }
 
-        weight.push_back(
-            {iter.first,
-             temp / ((1 - temp) * (tick - iter.second.getLastAccessedTime()))});
-      }
+    temp = iter.getValidPageCountRaw() -
+           (cfg.recoParam * iter.getRefreshedPageCount());
 
+    weight.push_back({iter.getBlockIndex(), temp});
+  }
+}
+
+// Bind per-mode and per-policy implementations
+void PageMapping::selectPolicy() {
+  switch (cfg.refreshMode) {
+    case 0:
+      pSetRefreshPeriod = &PageMapping::setRefreshPeriodMode<0>;
       break;
-    case POLICY_RECO:
-      for (auto &iter : blocks) {
-        if (iter.second.getNextWritePageIndex() != param.pagesInBlock) {
-          continue;
-        }
-        float refreshWeight = conf.readFloat(CONFIG_FTL, FTL_GC_RECO_PARAM);
-        temp = iter.second.getValidPageCountRaw() - ( refreshWeight * iter.second.getRefreshedPageCount() );
-        
-        //debugprint(LOG_FTL_PAGE_MAPPING, "Valid page count raw : %u", iter.second.getValidPageCountRaw());
-        //debugprint(LOG_FTL_PAGE_MAPPING, "Refreshed page count : %u", iter.second.getRefreshedPageCount());
-        //debugprint(LOG_FTL_PAGE_MAPPING, "Filling finished. Page status:");
+    case 1:
+      pSetRefreshPeriod = &PageMapping::setRefreshPeriodMode<1>;
+      break;
+    case 2:
+      pSetRefreshPeriod = &PageMapping::setRefreshPeriodMode<2>;
+      break;
+    case 3:
+      pSetRefreshPeriod = &PageMapping::setRefreshPeriodMode<3>;
+      break;
+    default:
+      panic("Invalid refresh grouping mode");
+  }
 
-        weight.push_back({iter.first, temp});
-      }
-      
+  switch (cfg.evictPolicy) {
+    case POLICY_GREEDY:
+    case POLICY_RANDOM:
+    case POLICY_DCHOICE:
+      pCalculateVictimWeight =
+          &PageMapping::calculateVictimWeightPolicy<POLICY_GREEDY>;
+      break;
+    case POLICY_COST_BENEFIT:
+      pCalculateVictimWeight =
+          &PageMapping::calculateVictimWeightPolicy<POLICY_COST_BENEFIT>;
+      break;
+    case POLICY_RECO:
+      pCalculateVictimWeight =
+          &PageMapping::calculateVictimWeightPolicy<POLICY_RECO>;
       break;
     default:
       panic("Invalid evict policy");
@@ -947,12 +1108,9 @@ void PageMapping::calculateVictimWeight(
 
 void PageMapping::selectVictimBlock(std::vector<uint32_t> &list,
                                     uint64_t &tick, std::vector<uint32_t> &exceptList) {
-  static const GC_MODE mode = (GC_MODE)conf.readInt(CONFIG_FTL, FTL_GC_MODE);
-  static const EVICT_POLICY policy =
-      (EVICT_POLICY)conf.readInt(CONFIG_FTL, FTL_GC_EVICT_POLICY);
-  static uint32_t dChoiceParam =
-      conf.readUint(CONFIG_FTL, FTL_GC_D_CHOICE_PARAM);
-  uint64_t nBlocks = conf.readUint(CONFIG_FTL, FTL_GC_RECLAIM_BLOCK);
+  const GC_MODE mode = cfg.gcMode;
+  const EVICT_POLICY policy = cfg.evictPolicy;
+  uint64_t nBlocks = cfg.reclaimBlock;
   std::vector<std::pair<uint32_t, float>> weight;
 
   list.clear();
@@ -962,9 +1120,7 @@ void PageMapping::selectVictimBlock(std::vector<uint32_t> &list,
     // DO NOTHING
   }
   else if (mode == GC_MODE_1) {
-    static const float t = conf.readFloat(CONFIG_FTL, FTL_GC_RECLAIM_THRESHOLD);
-
-    nBlocks = param.totalPhysicalBlocks * t - nFreeBlocks;
+    nBlocks = param.totalPhysicalBlocks * cfg.reclaimThreshold - nFreeBlocks;
   }
   else {
     panic("Invalid GC mode");
@@ -977,12 +1133,21 @@ void PageMapping::selectVictimBlock(std::vector<uint32_t> &list,
     bReclaimMore = false;
   }
 
+  // Greedy and RECO keep their victims ordered in victim index
+  if (victimIndex.isEnabled()) {
+    victimIndex.select(list, nBlocks);
+
+    tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::SELECT_VICTIM_BLOCK);
+
+    return;
+  }
+
   // Calculate weights of all blocks
-  calculateVictimWeight(weight, policy, tick);
+  calculateVictimWeight(weight, tick);
 
   if (policy == POLICY_RANDOM || policy == POLICY_DCHOICE) {
     uint64_t randomRange =
-        policy == POLICY_RANDOM ? nBlocks : dChoiceParam * nBlocks;
+        policy == POLICY_RANDOM ? nBlocks : cfg.dChoiceParam * nBlocks;
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<uint64_t> dist(0, weight.size() - 1);
@@ -1003,16 +1168,16 @@ void PageMapping::selectVictimBlock(std::vector<uint32_t> &list,
     weight = std::move(selected);
   }
 
-  // Sort weights
-  std::sort(
-      weight.begin(), weight.end(),
+  // Select victims from the blocks with the lowest weight
+  nBlocks = MIN(nBlocks, weight.size());
+
+  // Only first nBlocks weights need to be sorted
+  std::partial_sort(
+      weight.begin(), weight.begin() + nBlocks, weight.end(),
       [](std::pair<uint32_t, float> a, std::pair<uint32_t, float> b) -> bool {
         return a.second < b.second;
       });
 
-  // Select victims from the blocks with the lowest weight
-  nBlocks = MIN(nBlocks, weight.size());
-
   for (uint64_t i = 0; i < nBlocks; i++) {
     list.push_back(weight.at(i).first);
   }
@@ -1022,16 +1187,11 @@ void PageMapping::selectVictimBlock(std::vector<uint32_t> &list,
 
 void PageMapping::doGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
                                       uint64_t &tick, bool isRefresh) {
-  PAL::Request req(param.ioUnitInPage);
-  std::vector<PAL::Request> readRequests;
-  std::vector<PAL::Request> writeRequests;
-  std::vector<PAL::Request> eraseRequests;
-  std::vector<uint64_t> lpns;
-  Bitset bit(param.ioUnitInPage);
-  uint64_t beginAt;
-  uint64_t readFinishedAt = tick;
-  uint64_t writeFinishedAt = tick;
-  uint64_t eraseFinishedAt = tick;
+  PAL::Request req(param.ioUnitInPage);
+  CopyBatch batch;
+  std::vector<uint64_t> lpns;
+  Bitset bit(param.ioUnitInPage);
+  uint64_t beginAt = tick;
 
   if (blocksToReclaim.size() == 0) {
     return;
@@ -1039,54 +1199,60 @@ void PageMapping::doGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
 
   // For all blocks to reclaim, collecting request structure only
   for (auto &iter : blocksToReclaim) {
-    auto block = blocks.find(iter);
+    auto block = findBlock(iter);
 
-    if (block == blocks.end()) {
+    if (!block) {
       panic("Invalid block");
     }
 
     // Copy valid pages to free block
     for (uint32_t pageIndex = 0; pageIndex < param.pagesInBlock; pageIndex++) {
       // Valid?
-      if (block->second.getPageInfo(pageIndex, lpns, bit)) {
+      if (block->getPageInfo(pageIndex, lpns, bit)) {
         if (!bRandomTweak) {
           bit.set();
         }
 
-        // Retrive free block
-        auto freeBlock = blocks.find(getLastFreeBlock(bit));
+        // Retrive free block, in plane of victim when copyback is possible
+        auto freeBlock = findBlock(
+            cfg.copybackLimit > 0
+                ? getLastFreeBlock(bit, block->getBlockIndex() %
+                                            param.pageCountToMaxPerf)
+                : getLastFreeBlock(bit));
 
         // Issue Read
-        req.blockIndex = block->first;
+        req.blockIndex = block->getBlockIndex();
         req.pageIndex = pageIndex;
         req.ioFlag = bit;
 
-        readRequests.push_back(req);
+        batch.reads.push_back(req);
+        batch.onDie.push_back(
+            useCopyback(block, pageIndex, freeBlock->getBlockIndex(), tick));
 
         // Update mapping table
-        uint32_t newBlockIdx = freeBlock->first;
+        uint32_t newBlockIdx = freeBlock->getBlockIndex();
 
         for (uint32_t idx = 0; idx < bitsetSize; idx++) {
           if (bit.test(idx)) {
             // Invalidate
-            block->second.invalidate(pageIndex, idx);
+            block->invalidate(pageIndex, idx);
 
             auto mappingList = table.find(lpns.at(idx));
 
-            if (mappingList == table.end()) {
+            if (!mappingList) {
               panic("Invalid mapping table entry");
             }
 
-            pDRAM->read(&(*mappingList), 8 * param.ioUnitInPage, tick);
+            pDRAM->read(mappingList, 8 * param.ioUnitInPage, tick);
 
-            auto &mapping = mappingList->second.at(idx);
+            auto &mapping = mappingList[idx];
 
-            uint32_t newPageIdx = freeBlock->second.getNextWritePageIndex(idx);
+            uint32_t newPageIdx = freeBlock->getNextWritePageIndex(idx);
 
             mapping.first = newBlockIdx;
             mapping.second = newPageIdx;
 
-            freeBlock->second.write(newPageIdx, lpns.at(idx), idx, beginAt);
+            freeBlock->write(newPageIdx, lpns.at(idx), idx, beginAt);
 
             // Issue Write
             req.blockIndex = newBlockIdx;
@@ -1100,11 +1266,12 @@ void PageMapping::doGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
               req.ioFlag.set();
             }
 
-            writeRequests.push_back(req);
+            batch.writes.push_back(req);
+            batch.writeSource.push_back(batch.reads.size() - 1);
 
             // set new refresh period
-            uint32_t eraseCount = freeBlock->second.getEraseCount();
-            uint32_t layerNumber = newPageIdx % 64;
+            uint32_t eraseCount = freeBlock->getEraseCount();
+            uint32_t layerNumber = newPageIdx % cfg.layerCount;
 
             //debugprint(LOG_FTL_PAGE_MAPPING, "set refresh period - erasecount, layerNymber, blockIdx, pageIdx: %u, %u, %u, %u",
             //          eraseCount, layerNumber, newBlockIdx, newPageIdx);
@@ -1121,67 +1288,146 @@ void PageMapping::doGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
     }
 
     // Erase block
-    req.blockIndex = block->first;
+    req.blockIndex = block->getBlockIndex();
     req.pageIndex = 0;
     req.ioFlag.set();
 
-    eraseRequests.push_back(req);
+    batch.erases.push_back(req);
+    batch.eraseReadEnd.push_back(batch.reads.size());
   }
 
-  // Do actual I/O here
-  // This handles PAL2 limitation (SIGSEGV, infinite loop, or so-on)
-  
-  for (auto &iter : readRequests) {
+  issueCopies(batch, tick, &PageMapping::eraseInternal);
+
+  tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::DO_GARBAGE_COLLECTION);
+
+  updateGCTime(tick - beginAt);
+}
+
+// Issue reads at tick, each write when its source read finishes, and each
+// erase when all reads of its block finish. Requests are still submitted in
+// collection order; PAL places each one at its begin tick on its die.
+void PageMapping::issueCopies(CopyBatch &batch, uint64_t &tick,
+                              void (PageMapping::*erase)(PAL::Request &,
+                                                         uint64_t &)) {
+  std::vector<uint64_t> readFinishedAt(batch.reads.size());
+  uint64_t finishedAt = tick;
+  uint64_t beginAt;
+
+  for (uint32_t i = 0; i < batch.reads.size(); i++) {
     beginAt = tick;
 
-    pPAL->read(iter, beginAt);
+    // Page moved by copyback never leaves the die
+    if (!batch.onDie[i]) {
+      pPAL->read(batch.reads[i], beginAt);
+    }
 
-    readFinishedAt = MAX(readFinishedAt, beginAt);
+    readFinishedAt[i] = beginAt;
+    finishedAt = MAX(finishedAt, beginAt);
   }
 
-  for (auto &iter : writeRequests) {
-    beginAt = readFinishedAt;
+  for (uint32_t i = 0; i < batch.writes.size(); i++) {
+    uint32_t source = batch.writeSource[i];
+    PAL::Request &req = batch.writes[i];
 
-    pPAL->write(iter, beginAt);
+    beginAt = readFinishedAt[source];
 
-    writeFinishedAt = MAX(writeFinishedAt, beginAt);
+    if (batch.onDie[source]) {
+      PAL::Request src = batch.reads[source];
+
+      src.ioFlag = req.ioFlag;
+
+      pPAL->copyback(src, req, beginAt);
+
+      // Source block is erased only after its copybacks
+      readFinishedAt[source] = MAX(readFinishedAt[source], beginAt);
+
+      uint8_t &count = copybackCount[(uint64_t)req.blockIndex *
+                                         param.pagesInBlock +
+                                     req.pageIndex];
+      uint8_t srcCount = copybackCount[(uint64_t)src.blockIndex *
+                                           param.pagesInBlock +
+                                       src.pageIndex];
+
+      count = MAX(count, srcCount + 1);
+    }
+    else {
+      pPAL->write(req, beginAt);
+    }
+
+    finishedAt = MAX(finishedAt, beginAt);
   }
 
-  for (auto &iter : eraseRequests) {
-    beginAt = readFinishedAt;
+  uint32_t readBegin = 0;
+
+  for (uint32_t i = 0; i < batch.erases.size(); i++) {
+    beginAt = tick;
+
+    for (; readBegin < batch.eraseReadEnd[i]; readBegin++) {
+      beginAt = MAX(beginAt, readFinishedAt[readBegin]);
+    }
 
-    eraseInternal(iter, beginAt);
+    (this->*erase)(batch.erases[i], beginAt);
 
-    eraseFinishedAt = MAX(eraseFinishedAt, beginAt);
+    finishedAt = MAX(finishedAt, beginAt);
   }
-  
 
+  tick = finishedAt;
+}
 
-  tick = MAX(writeFinishedAt, eraseFinishedAt);
-  tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::DO_GARBAGE_COLLECTION);
+// Copy a page on-die when the destination block is in the same plane, and
+// the page has not exhausted its ECC budget: errors accumulate uncorrected
+// over consecutive copybacks, so estimated RBER times number of copies must
+// stay within MaxRBER
+bool PageMapping::useCopyback(Block *block, uint32_t pageIndex,
+                              uint32_t newBlockIdx, uint64_t tick) {
+  uint32_t blockIndex = block->getBlockIndex();
+
+  if (cfg.copybackLimit == 0 || blockIndex % param.pageCountToMaxPerf !=
+                                    newBlockIdx % param.pageCountToMaxPerf) {
+    return false;
+  }
+
+  uint32_t count =
+      copybackCount[(uint64_t)blockIndex * param.pagesInBlock + pageIndex];
+
+  if (count >= cfg.copybackLimit) {
+    return false;
+  }
+
+  uint64_t lastWritten = block->getLastWrittenTime();
+  float rber =
+      errorModel.getRBER(tick > lastWritten ? tick - lastWritten : 0,
+                         block->getEraseCount(), blockIndex,
+                         pageIndex % cfg.layerCount);
+
+  return rber * (count + 1) <= cfg.refreshMaxRBER;
+}
+
+void PageMapping::updateGCTime(uint64_t time) {
+  stat.gcRuns++;
+  stat.gcTime += time;
+  stat.gcMaxTime = MAX(stat.gcMaxTime, time);
 }
 
 
-void PageMapping::refreshPage(uint32_t queueNum, uint64_t &tick) {
+// Refresh up to maxRefreshLayer layers in checked list of queue, and return
+// the number of layers taken from the list
+uint32_t PageMapping::refreshPage(uint32_t queueNum, uint32_t maxRefreshLayer,
+                                  uint64_t &tick) {
   //debugprint(LOG_FTL_PAGE_MAPPING, "Refresh page start");
   PAL::Request req(param.ioUnitInPage);
-  std::vector<PAL::Request> readRequests;
-  std::vector<PAL::Request> writeRequests;
-  std::vector<PAL::Request> eraseRequests;
+  CopyBatch batch;
   std::vector<uint64_t> lpns;
   Bitset bit(param.ioUnitInPage);
   uint64_t beginAt = tick;
-  uint64_t readFinishedAt = tick;
-  uint64_t writeFinishedAt = tick;
-  //uint64_t eraseFinishedAt = tick;
 
   std::vector<uint64_t> tempLpns;
   Bitset tempBit(param.ioUnitInPage);
-  static float gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
+  const float gcThreshold = cfg.gcThreshold;
 
   // GC before refresh
-  uint32_t hotColdSeparation = conf.readUint(CONFIG_FTL, FTL_HOT_COLD_SEPERATION);
-  if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
+
+  if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
     if (freeBlockRatio() < gcThreshold) {
 
       std::vector<uint32_t> list;
@@ -1218,106 +1464,93 @@ void PageMapping::refreshPage(uint32_t queueNum, uint64_t &tick) {
   
   // For all blocks to reclaim, collecting request structure only
   // # of layer can be refreshed for each refresh interval (not check interval)
-  uint32_t maxRefreshLayer = conf.readUint(CONFIG_FTL, FTL_REFRESH_MAX_LAYER_NUM);  
-
-  for (uint32_t i = 0; i < maxRefreshLayer; i++) {
-    if (checkedQueues[queueNum].empty()){
-      break;
-    }
-    
-    uint32_t layerID = checkedQueues[queueNum].front();
-    checkedQueues[queueNum].pop_front();
+  uint32_t layers = 0;
 
-    uint32_t blockIndex = layerID / 64;
-    uint32_t layerIndex = layerID % 64;
+  for (; layers < maxRefreshLayer; layers++) {
+    uint32_t layerID;
 
-    if (queueNum != layerQueueNum[layerID]) {
-      // This shouldn't be happened but it does and I don't know why
-      //insertedLayerCheck.set(layerID, false);
-      stat.doubleInsertionCount++;
-      continue;
-      //panic("Inserted to wrong queue, refresh failed. 
-      //      Layer ID: %u, refreshing queue: %u, layerQueueNum[layerID]: %u", 
-      //      layerID, queueNum, layerQueueNum[layerID]);
+    // Popping unlinks the layer, so it can be inserted again
+    if (!refreshQueue.popChecked(queueNum, layerID)) {
+      break;
     }
-    
 
-    if (!insertedLayerCheck.test(layerID)) {
-      // This shouldn't be happened. Layer check bitmap should be reset only after it is refreshed
-      panic("Corrupted layer check bitmap, refresh failed. Layer ID : %u", layerID);
-    }  
+    uint32_t blockIndex = layerID / cfg.layerCount;
+    uint32_t layerIndex = layerID % cfg.layerCount;
 
-    // Reset refresh check bitmap
-    insertedLayerCheck.set(layerID,false);
-    
-    auto block = blocks.find(blockIndex);
-    if (block == blocks.end()) {
+    auto block = findBlock(blockIndex);
+    if (!block) {
       //panic("Invalid block, refresh failed");
       // This can be happen if the block is GCed at the beginning of refresh
       continue;
     }
 
     // Copy valid pages to free block
-    blockPoolType blockType = block->second.getBlockType();
+    blockPoolType blockType = block->getBlockType();
 
-    for (uint32_t pageIndex = layerIndex; pageIndex < param.pagesInBlock; pageIndex += 64) {
+    for (uint32_t pageIndex = layerIndex; pageIndex < param.pagesInBlock; pageIndex += cfg.layerCount) {
 
-      //if (block->second.getValidPageCount()) {  // Valid?
-      if (block->second.getPageInfo(pageIndex, lpns, bit)) {  //Modified!!!
+      //if (block->getValidPageCount()) {  // Valid?
+      if (block->getPageInfo(pageIndex, lpns, bit)) {  //Modified!!!
         if (!bRandomTweak) {
           bit.set();
         }
         
         // Retrive free block
-        auto freeBlock = blocks.begin();
-        if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
-          freeBlock = blocks.find(getLastFreeBlock(bit));
+        Block *freeBlock = nullptr;
+        if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
+          freeBlock = findBlock(
+              cfg.copybackLimit > 0
+                  ? getLastFreeBlock(bit, block->getBlockIndex() %
+                                              param.pageCountToMaxPerf)
+                  : getLastFreeBlock(bit));
         }
         else {    /* hot/cold seperation enabled */
           if (blockType == COLD) {
-            freeBlock = blocks.find(getLastColdFreeBlock(bit));
+            freeBlock = findBlock(getLastColdFreeBlock(bit));
           }
           else {
-            freeBlock = blocks.find(getLastCoolFreeBlock(bit));
+            freeBlock = findBlock(getLastCoolFreeBlock(bit));
           }
         }
 
 
         // Issue Read
-        req.blockIndex = block->first;
+        req.blockIndex = block->getBlockIndex();
         req.pageIndex = pageIndex;
         req.ioFlag = bit;
 
-        readRequests.push_back(req);
+        batch.reads.push_back(req);
+        batch.onDie.push_back(
+            useCopyback(block, pageIndex, freeBlock->getBlockIndex(), tick));
 
         // Update mapping table
-        uint32_t newBlockIdx = freeBlock->first;
+        uint32_t newBlockIdx = freeBlock->getBlockIndex();
 
         for (uint32_t idx = 0; idx < bitsetSize; idx++) {
           if (bit.test(idx)) {    
             // Invalidate
-            block->second.invalidate(pageIndex, idx); // 여기서 out of range error 났었음 (왜났었는지는 기억이 안남)
-            uint32_t refreshedPageCount = block->second.getRefreshedPageCount() + 1;
-            block->second.setRefreshedPageCount(refreshedPageCount);
+            block->invalidate(pageIndex, idx); // 여기서 out of range error 났었음 (왜났었는지는 기억이 안남)
+            uint32_t refreshedPageCount = block->getRefreshedPageCount() + 1;
+            block->setRefreshedPageCount(refreshedPageCount);
 
             auto mappingList = table.find(lpns.at(idx));
 
-            if (mappingList == table.end()) {     //Modified!!!
+            if (!mappingList) {     //Modified!!!
               panic("Invalid mapping table entry, refresh failed");
               // This shouldn't be happened. For all valid page, there should be valid mapping
               //continue;
             }
 
-            pDRAM->read(&(*mappingList), 8 * param.ioUnitInPage, tick);
+            pDRAM->read(mappingList, 8 * param.ioUnitInPage, tick);
 
-            auto &mapping = mappingList->second.at(idx);
+            auto &mapping = mappingList[idx];
 
-            uint32_t newPageIdx = freeBlock->second.getNextWritePageIndex(idx);
+            uint32_t newPageIdx = freeBlock->getNextWritePageIndex(idx);
 
             mapping.first = newBlockIdx;
             mapping.second = newPageIdx;
 
-            freeBlock->second.write(newPageIdx, lpns.at(idx), idx, beginAt);
+            freeBlock->write(newPageIdx, lpns.at(idx), idx, beginAt);
 
             // Issue Write
             req.blockIndex = newBlockIdx;
@@ -1331,10 +1564,11 @@ void PageMapping::refreshPage(uint32_t queueNum, uint64_t &tick) {
               req.ioFlag.set();
             }
 
-            writeRequests.push_back(req);
+            batch.writes.push_back(req);
+            batch.writeSource.push_back(batch.reads.size() - 1);
             
-            uint32_t eraseCount = freeBlock->second.getEraseCount();
-            uint32_t layerNumber = newPageIdx % 64;
+            uint32_t eraseCount = freeBlock->getEraseCount();
+            uint32_t layerNumber = newPageIdx % cfg.layerCount;
             //int32_t globalLayerNum = (newBlockIdx * 64) + layerNumber;
 
             setRefreshPeriod(eraseCount, newBlockIdx, layerNumber);
@@ -1359,29 +1593,13 @@ void PageMapping::refreshPage(uint32_t queueNum, uint64_t &tick) {
 
   //debugprint(LOG_FTL_PAGE_MAPPING, "Do actual I/O");
   // Do actual I/O here
-  // This handles PAL2 limitation (SIGSEGV, infinite loop, or so-on)
-  for (auto &iter : readRequests) {
-    beginAt = tick;
-
-    pPAL->read(iter, beginAt);
-
-    readFinishedAt = MAX(readFinishedAt, beginAt);
-  }
-
-  for (auto &iter : writeRequests) {
-    beginAt = readFinishedAt;
+  issueCopies(batch, tick, nullptr);
 
-    pPAL->write(iter, beginAt);
-
-    writeFinishedAt = MAX(writeFinishedAt, beginAt);
-  }
-  
   //debugprint(LOG_FTL_PAGE_MAPPING, "page refresh done. remaining free blocks: %u", nFreeBlocks);
-  tick = MAX(writeFinishedAt, readFinishedAt);
   tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::DO_GARBAGE_COLLECTION);
 
   // GC after refresh (gc because of refresh)
-  if (hotColdSeparation == 0) { /* hot/cold seperation disabled */
+  if (!cfg.hotColdSeparation) { /* hot/cold seperation disabled */
     if (freeBlockRatio() < gcThreshold) {
 
       std::vector<uint32_t> list;
@@ -1415,6 +1633,8 @@ void PageMapping::refreshPage(uint32_t queueNum, uint64_t &tick) {
       stat.reclaimedColdBlocks += list.size();
     }
   }
+
+  return layers;
 }
 
 
@@ -1425,17 +1645,17 @@ void PageMapping::readInternal(Request &req, uint64_t &tick) {
 
   auto mappingList = table.find(req.lpn);
 
-  if (mappingList != table.end()) {
+  if (mappingList) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(mappingList, 8 * req.ioFlag.count(), tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
+      pDRAM->read(mappingList, 8, tick);
     }
 
     for (uint32_t idx = 0; idx < bitsetSize; idx++) {
       if (req.ioFlag.test(idx) || !bRandomTweak) {
-        auto &mapping = mappingList->second.at(idx);
+        auto &mapping = mappingList[idx];
 
         if (mapping.first < param.totalPhysicalBlocks &&
             mapping.second < param.pagesInBlock) {
@@ -1450,33 +1670,33 @@ void PageMapping::readInternal(Request &req, uint64_t &tick) {
             palRequest.ioFlag.set();
           }
 
-          auto block = blocks.find(palRequest.blockIndex);
+          auto block = findBlock(palRequest.blockIndex);
 
-          if (block == blocks.end()) {
+          if (!block) {
             panic("Block is not in use");
           }
 
           beginAt = tick;
 
-          block->second.read(palRequest.pageIndex, idx, beginAt);
+          block->read(palRequest.pageIndex, idx, beginAt);
           pPAL->read(palRequest, beginAt);
 
           /*
-          uint64_t lastWritten = block->second.getLastWrittenTime();
-          uint32_t eraseCount = block->second.getEraseCount();
-          uint64_t curErrorCount = block->second.getMaxErrorCount();
+          uint64_t lastWritten = block->getLastWrittenTime();
+          uint32_t eraseCount = block->getEraseCount();
+          uint64_t curErrorCount = block->getMaxErrorCount();
 
           debugprint(LOG_FTL_PAGE_MAPPING, "Erase count %u", eraseCount);
 
           //TODO: Get layer number
-          uint32_t layerNumber = mapping.second % 64;
+          uint32_t layerNumber = mapping.second % cfg.layerCount;
           uint64_t newErrorCount = errorModel.getRandError(tick - lastWritten, eraseCount, layerNumber);
 
           debugprint(LOG_FTL_PAGE_MAPPING, "new rber: %f", errorModel.getRBER(tick - lastWritten, eraseCount, 0));
           debugprint(LOG_FTL_PAGE_MAPPING, "new randerror: %u", newErrorCount);
 
 
-          block->second.setMaxErrorCount(max(curErrorCount, newErrorCount));
+          block->setMaxErrorCount(max(curErrorCount, newErrorCount));
           */
 
           finishedAt = MAX(finishedAt, beginAt);
@@ -1494,57 +1714,48 @@ void PageMapping::readInternal(Request &req, uint64_t &tick) {
 void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
   //debugprint(LOG_FTL_PAGE_MAPPING, "Write internal start");
   PAL::Request palRequest(req);
-  std::unordered_map<uint32_t, Block>::iterator block;
+  Block *block = nullptr;
   auto mappingList = table.find(req.lpn);
   uint64_t beginAt;
   uint64_t finishedAt = tick;
   bool readBeforeWrite = false;
 
 
-  if (mappingList != table.end()) {
+  if (mappingList) {
     for (uint32_t idx = 0; idx < bitsetSize; idx++) {
       if (req.ioFlag.test(idx) || !bRandomTweak) {
-        auto &mapping = mappingList->second.at(idx);
+        auto &mapping = mappingList[idx];
 
         if (mapping.first < param.totalPhysicalBlocks &&
             mapping.second < param.pagesInBlock) {
-          block = blocks.find(mapping.first);
+          block = findBlock(mapping.first);
 
           // Invalidate current page
-          block->second.invalidate(mapping.second, idx);
+          block->invalidate(mapping.second, idx);
         }
       }
     }
   }
   else {
     // Create empty mapping
-    auto ret = table.emplace(
-        req.lpn,
-        std::vector<std::pair<uint32_t, uint32_t>>(
-            bitsetSize, {param.totalPhysicalBlocks, param.pagesInBlock}));
-
-    if (!ret.second) {
-      panic("Failed to insert new mapping");
-    }
-
-    mappingList = ret.first;
+    mappingList = table.insert(req.lpn);
   }
 
   // Write data to free block
-  block = blocks.find(getLastFreeBlock(req.ioFlag));
+  block = findBlock(getLastFreeBlock(req.ioFlag));
 
-  if (block == blocks.end()) {
+  if (!block) {
     panic("No such block");
   }
 
   if (sendToPAL) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
-      pDRAM->write(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(mappingList, 8 * req.ioFlag.count(), tick);
+      pDRAM->write(mappingList, 8 * req.ioFlag.count(), tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
-      pDRAM->write(&(*mappingList), 8, tick);
+      pDRAM->read(mappingList, 8, tick);
+      pDRAM->write(mappingList, 8, tick);
     }
   }
 
@@ -1555,12 +1766,12 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
 
   for (uint32_t idx = 0; idx < bitsetSize; idx++) {
     if (req.ioFlag.test(idx) || !bRandomTweak) {
-      uint32_t pageIndex = block->second.getNextWritePageIndex(idx);
-      auto &mapping = mappingList->second.at(idx);
+      uint32_t pageIndex = block->getNextWritePageIndex(idx);
+      auto &mapping = mappingList[idx];
 
       beginAt = tick;
 
-      block->second.write(pageIndex, req.lpn, idx, beginAt);
+      block->write(pageIndex, req.lpn, idx, beginAt);
 
       // Read old data if needed (Only executed when bRandomTweak = false)
       // Maybe some other init procedures want to perform 'partial-write'
@@ -1577,11 +1788,11 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
       }
 
       // update mapping to table
-      mapping.first = block->first;
+      mapping.first = block->getBlockIndex();
       mapping.second = pageIndex;
 
       if (sendToPAL) {
-        palRequest.blockIndex = block->first;
+        palRequest.blockIndex = block->getBlockIndex();
         palRequest.pageIndex = pageIndex;
 
         if (bRandomTweak) {
@@ -1599,13 +1810,13 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
 
       //if (sendToPAL){
       // Predict error
-      uint32_t eraseCount = block->second.getEraseCount();
-      uint32_t layerNumber = mapping.second % 64;
+      uint32_t eraseCount = block->getEraseCount();
+      uint32_t layerNumber = mapping.second % cfg.layerCount;
       
-      //uint32_t globalLayerNum = (block->first * 64) + layerNumber;
+      //uint32_t globalLayerNum = (block->getBlockIndex() * 64) + layerNumber;
       //debugprint(LOG_FTL_PAGE_MAPPING, "set refresh period - erasecount, globalLayerNum, blockIdx, pageIdx: %u, %u, %u, %u",
-      //  eraseCount, globalLayerNum, block->first, mapping.second);
-      setRefreshPeriod(eraseCount, block->first, layerNumber);
+      //  eraseCount, globalLayerNum, block->getBlockIndex(), mapping.second);
+      setRefreshPeriod(eraseCount, block->getBlockIndex(), layerNumber);
       //}
 
       //TODO: Now error count can be used to put layer to bloom filter
@@ -1614,7 +1825,7 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
   }
 
   // TODO: Have to record for each page
-  //block->second.setLastWrittenTime(tick);
+  //block->setLastWrittenTime(tick);
 
   // Exclude CPU operation when initializing
   if (sendToPAL) {
@@ -1624,7 +1835,7 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
 
   // GC if needed
   // I assumed that init procedure never invokes GC
-  static float gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
+  const float gcThreshold = cfg.gcThreshold;
 
   if (freeBlockRatio() < gcThreshold) {
     if (!sendToPAL) {
@@ -1654,81 +1865,68 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
 void PageMapping::trimInternal(Request &req, uint64_t &tick) {
   auto mappingList = table.find(req.lpn);
 
-  if (mappingList != table.end()) {
+  if (mappingList) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(mappingList, 8 * req.ioFlag.count(), tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
+      pDRAM->read(mappingList, 8, tick);
     }
 
     // Do trim
     for (uint32_t idx = 0; idx < bitsetSize; idx++) {
-      auto &mapping = mappingList->second.at(idx);
-      auto block = blocks.find(mapping.first);
+      auto &mapping = mappingList[idx];
+      auto block = findBlock(mapping.first);
 
-      if (block == blocks.end()) {
+      if (!block) {
         panic("Block is not in use");
       }
 
-      block->second.invalidate(mapping.second, idx);
+      block->invalidate(mapping.second, idx);
     }
 
     // Remove mapping
-    table.erase(mappingList);
+    table.erase(req.lpn);
 
     tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::TRIM_INTERNAL);
   }
 }
 
 void PageMapping::eraseInternal(PAL::Request &req, uint64_t &tick) {
-  static uint64_t threshold =
-      conf.readUint(CONFIG_FTL, FTL_BAD_BLOCK_THRESHOLD);
-  auto block = blocks.find(req.blockIndex);
+  const uint64_t threshold = cfg.badBlockThreshold;
+  auto block = findBlock(req.blockIndex);
 
   // Sanity checks
-  if (block == blocks.end()) {
+  if (!block) {
     panic("No such block");
   }
 
-  if (block->second.getValidPageCount() != 0) {
+  if (block->getValidPageCount() != 0) {
     panic("There are valid pages in victim block");
   }
 
   // Erase block
-  block->second.erase();
+  block->erase();
+
+  if (cfg.copybackLimit > 0) {
+    std::fill_n(copybackCount.begin() +
+                    (uint64_t)req.blockIndex * param.pagesInBlock,
+                param.pagesInBlock, 0);
+  }
 
   pPAL->erase(req, tick);
 
   // Check erase count
-  uint32_t erasedCount = block->second.getEraseCount();
+  uint32_t erasedCount = block->getEraseCount();
 
   if (erasedCount < threshold) {
-    // Reverse search
-    auto iter = freeBlocks.end();
-
-    while (true) {
-      iter--;
-
-      if (iter->getEraseCount() <= erasedCount) {
-        // emplace: insert before pos
-        iter++;
-
-        break;
-      }
-
-      if (iter == freeBlocks.begin()) {
-        break;
-      }
-    }
-
     // Insert block to free block list
-    freeBlocks.emplace(iter, std::move(block->second));
+    freeBlocks.push(req.blockIndex, erasedCount);
     nFreeBlocks++;
   }
-
-  // Remove block from block list
-  blocks.erase(block);
+  else {
+    block->setBlockState(BLOCK_BAD);
+  }
 
   tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::ERASE_INTERNAL);
 }
@@ -1737,7 +1935,7 @@ void PageMapping::eraseInternal(PAL::Request &req, uint64_t &tick) {
 void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL) {
   //debugprint(LOG_FTL_PAGE_MAPPING, "Write internal start");
   PAL::Request palRequest(req);
-  std::unordered_map<uint32_t, Block>::iterator block;
+  Block *block = nullptr;
   auto mappingList = table.find(req.lpn);
   uint64_t beginAt;
   uint64_t finishedAt = tick;
@@ -1746,61 +1944,52 @@ void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL)
   blockPoolType curBlockType;
 
 
-  if (mappingList != table.end()) {
+  if (mappingList) {
     for (uint32_t idx = 0; idx < bitsetSize; idx++) {
       if (req.ioFlag.test(idx) || !bRandomTweak) {
-        auto &mapping = mappingList->second.at(idx);
+        auto &mapping = mappingList[idx];
 
         if (mapping.first < param.totalPhysicalBlocks &&
             mapping.second < param.pagesInBlock) {
-          block = blocks.find(mapping.first);
+          block = findBlock(mapping.first);
 
           // Invalidate current page
-          block->second.invalidate(mapping.second, idx);
+          block->invalidate(mapping.second, idx);
         }
       }
     }
-    curBlockType = block->second.getBlockType();
+    curBlockType = block->getBlockType();
   }
   else {
     // Create empty mapping
-    auto ret = table.emplace(
-        req.lpn,
-        std::vector<std::pair<uint32_t, uint32_t>>(
-            bitsetSize, {param.totalPhysicalBlocks, param.pagesInBlock}));
-
-    if (!ret.second) {
-      panic("Failed to insert new mapping");
-    }
-
-    mappingList = ret.first;
+    mappingList = table.insert(req.lpn);
     curBlockType = COLD;
   }
 
   // Write data to free block
   if (curBlockType == HOT || curBlockType == COOL) {
-    block = blocks.find(getLastHotFreeBlock(req.ioFlag));
+    block = findBlock(getLastHotFreeBlock(req.ioFlag));
     curBlockType = HOT;
   }
 
   else {   // curblockType == COLD
-    block = blocks.find(getLastCoolFreeBlock(req.ioFlag));
+    block = findBlock(getLastCoolFreeBlock(req.ioFlag));
     curBlockType = COOL;
   }
 
 
-  if (block == blocks.end()) {
+  if (!block) {
     panic("No such block");
   }
 
   if (sendToPAL) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
-      pDRAM->write(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(mappingList, 8 * req.ioFlag.count(), tick);
+      pDRAM->write(mappingList, 8 * req.ioFlag.count(), tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
-      pDRAM->write(&(*mappingList), 8, tick);
+      pDRAM->read(mappingList, 8, tick);
+      pDRAM->write(mappingList, 8, tick);
     }
   }
 
@@ -1811,12 +2000,12 @@ void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL)
 
   for (uint32_t idx = 0; idx < bitsetSize; idx++) {
     if (req.ioFlag.test(idx) || !bRandomTweak) {
-      uint32_t pageIndex = block->second.getNextWritePageIndex(idx);
-      auto &mapping = mappingList->second.at(idx);
+      uint32_t pageIndex = block->getNextWritePageIndex(idx);
+      auto &mapping = mappingList[idx];
 
       beginAt = tick;
 
-      block->second.write(pageIndex, req.lpn, idx, beginAt);
+      block->write(pageIndex, req.lpn, idx, beginAt);
 
       // Read old data if needed (Only executed when bRandomTweak = false)
       // Maybe some other init procedures want to perform 'partial-write'
@@ -1833,11 +2022,11 @@ void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL)
       }
 
       // update mapping to table
-      mapping.first = block->first;
+      mapping.first = block->getBlockIndex();
       mapping.second = pageIndex;
 
       if (sendToPAL) {
-        palRequest.blockIndex = block->first;
+        palRequest.blockIndex = block->getBlockIndex();
         palRequest.pageIndex = pageIndex;
 
         if (bRandomTweak) {
@@ -1854,11 +2043,11 @@ void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL)
       finishedAt = MAX(finishedAt, beginAt);
 
       // Predict error
-      uint32_t eraseCount = block->second.getEraseCount();
-      uint32_t layerNumber = mapping.second % 64;
+      uint32_t eraseCount = block->getEraseCount();
+      uint32_t layerNumber = mapping.second % cfg.layerCount;
 
       // Insert to refresh queue
-      setRefreshPeriod(eraseCount, block->first, layerNumber);
+      setRefreshPeriod(eraseCount, block->getBlockIndex(), layerNumber);
     }
   }
 
@@ -1870,7 +2059,7 @@ void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL)
 
   // GC if needed
   // I assumed that init procedure never invokes GC
-  static float gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
+  const float gcThreshold = cfg.gcThreshold;
 
   if (coldFreeBlockRatio() < gcThreshold) {
     if (!sendToPAL) {
@@ -1906,7 +2095,7 @@ void PageMapping::sepWriteInternal(Request &req, uint64_t &tick, bool sendToPAL)
 
 void PageMapping::sepHotWriteInternal(Request &req, uint64_t &tick, bool sendToPAL) {    // Only for filling
   PAL::Request palRequest(req);
-  std::unordered_map<uint32_t, Block>::iterator block;
+  Block *block = nullptr;
   auto mappingList = table.find(req.lpn);
   uint64_t beginAt;
   uint64_t finishedAt = tick;
@@ -1914,41 +2103,32 @@ void PageMapping::sepHotWriteInternal(Request &req, uint64_t &tick, bool sendToP
 
   blockPoolType curBlockType;
 
-  if (mappingList != table.end()) {
+  if (mappingList) {
     for (uint32_t idx = 0; idx < bitsetSize; idx++) {
       if (req.ioFlag.test(idx) || !bRandomTweak) {
-        auto &mapping = mappingList->second.at(idx);
+        auto &mapping = mappingList[idx];
 
         if (mapping.first < param.totalPhysicalBlocks &&
             mapping.second < param.pagesInBlock) {
-          block = blocks.find(mapping.first);
+          block = findBlock(mapping.first);
 
           // Invalidate current page
-          block->second.invalidate(mapping.second, idx);
+          block->invalidate(mapping.second, idx);
         }
       }
     }
-    curBlockType = block->second.getBlockType();    
+    curBlockType = block->getBlockType();    
   }
   else {
     // Create empty mapping
-    auto ret = table.emplace(
-        req.lpn,
-        std::vector<std::pair<uint32_t, uint32_t>>(
-            bitsetSize, {param.totalPhysicalBlocks, param.pagesInBlock}));
-
-    if (!ret.second) {
-      panic("Failed to insert new mapping");
-    }
-
-    mappingList = ret.first;
+    mappingList = table.insert(req.lpn);
     curBlockType = HOT;
   }
 
   // Write data to free block
 
   if (curBlockType == HOT) {
-    block = blocks.find(getLastHotFreeBlock(req.ioFlag));
+    block = findBlock(getLastHotFreeBlock(req.ioFlag));
     curBlockType = HOT;
   }
 
@@ -1956,7 +2136,7 @@ void PageMapping::sepHotWriteInternal(Request &req, uint64_t &tick, bool sendToP
     panic("It cannot be cool or cold block");
   }
 
-  if (block == blocks.end()) {
+  if (!block) {
     panic("No such block");
   }
 
@@ -1967,12 +2147,12 @@ void PageMapping::sepHotWriteInternal(Request &req, uint64_t &tick, bool sendToP
 
   for (uint32_t idx = 0; idx < bitsetSize; idx++) {
     if (req.ioFlag.test(idx) || !bRandomTweak) {
-      uint32_t pageIndex = block->second.getNextWritePageIndex(idx);
-      auto &mapping = mappingList->second.at(idx);
+      uint32_t pageIndex = block->getNextWritePageIndex(idx);
+      auto &mapping = mappingList[idx];
 
       beginAt = tick;
 
-      block->second.write(pageIndex, req.lpn, idx, beginAt);
+      block->write(pageIndex, req.lpn, idx, beginAt);
 
       // Read old data if needed (Only executed when bRandomTweak = false)
       // Maybe some other init procedures want to perform 'partial-write'
@@ -1989,14 +2169,14 @@ void PageMapping::sepHotWriteInternal(Request &req, uint64_t &tick, bool sendToP
       }
 
       // update mapping to table
-      mapping.first = block->first;
+      mapping.first = block->getBlockIndex();
       mapping.second = pageIndex;
 
       finishedAt = MAX(finishedAt, beginAt);
     }
   }
 
-  static float gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
+  const float gcThreshold = cfg.gcThreshold;
 
   if (coldFreeBlockRatio() < gcThreshold) {
       std::cout << "cold free ratio" << coldFreeBlockRatio() << std:: endl;
@@ -2017,69 +2197,41 @@ void PageMapping::sepHotWriteInternal(Request &req, uint64_t &tick, bool sendToP
 }
 
 void PageMapping::sepEraseInternal(PAL::Request &req, uint64_t &tick) {
-  static uint64_t threshold =
-      conf.readUint(CONFIG_FTL, FTL_BAD_BLOCK_THRESHOLD);
-  auto block = blocks.find(req.blockIndex);
-  blockPoolType blockType = block->second.getBlockType();
+  const uint64_t threshold = cfg.badBlockThreshold;
+  auto block = findBlock(req.blockIndex);
 
   // Sanity checks
-  if (block == blocks.end()) {
+  if (!block) {
     panic("No such block");
   }
 
-  if (block->second.getValidPageCount() != 0) {
+  blockPoolType blockType = block->getBlockType();
+
+  if (block->getValidPageCount() != 0) {
     panic("There are valid pages in victim block");
   }
 
   // Erase block
-  block->second.erase();
+  block->erase();
+
+  if (cfg.copybackLimit > 0) {
+    std::fill_n(copybackCount.begin() +
+                    (uint64_t)req.blockIndex * param.pagesInBlock,
+                param.pagesInBlock, 0);
+  }
 
   pPAL->erase(req, tick);
 
   // Check erase count
-  uint32_t erasedCount = block->second.getEraseCount();
+  uint32_t erasedCount = block->getEraseCount();
 
   if (erasedCount < threshold) {
-    // Reverse search
     if (blockType == HOT){
-      auto iter = hotFreeBlocks.end();
-
-      while (true) {
-        iter--;
-
-        if (iter->getEraseCount() <= erasedCount) {
-          // emplace: insert before pos
-          iter++;
-
-          break;
-        }
-
-        if (iter == hotFreeBlocks.begin()) {
-          break;
-        }
-      }
       // Insert block to free block list
-      hotFreeBlocks.emplace(iter, std::move(block->second));
+      hotFreeBlocks.push(req.blockIndex, erasedCount);
       nHotFreeBlocks++;
     }
     else {  //blockType == COOL || blockType == COLD
-      auto iter = coldFreeBlocks.end();
-
-      while (true) {
-        iter--;
-
-        if (iter->getEraseCount() <= erasedCount) {
-          // emplace: insert before pos
-          iter++;
-
-          break;
-        }
-
-        if (iter == coldFreeBlocks.begin()) {
-          break;
-        }
-      }
-      
       // Modified 07/19
       // This can be bug in simplessd. 
       // If a last free block is full the block can be GCed,
@@ -2105,13 +2257,13 @@ void PageMapping::sepEraseInternal(PAL::Request &req, uint64_t &tick) {
       
       
       // Insert block to free block list
-      coldFreeBlocks.emplace(iter, std::move(block->second));
+      coldFreeBlocks.push(req.blockIndex, erasedCount);
       nColdFreeBlocks++;
     }
   }
-
-  // Remove block from block list
-  blocks.erase(block);
+  else {
+    block->setBlockState(BLOCK_BAD);
+  }
 
   tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::ERASE_INTERNAL);
 }
@@ -2132,15 +2284,15 @@ uint32_t PageMapping::getLastHotFreeBlock(Bitset &iomap) {
     lastHotFreeBlockIOMap |= iomap;
   }
 
-  auto freeBlock = blocks.find(lastHotFreeBlock.at(lastHotFreeBlockIndex));
+  auto freeBlock = findBlock(lastHotFreeBlock.at(lastHotFreeBlockIndex));
 
   // Sanity check
-  if (freeBlock == blocks.end()) {
+  if (!freeBlock) {
     panic("Corrupted");
   }
 
   // If current free block is full, get next block
-  if (freeBlock->second.getNextWritePageIndex() == param.pagesInBlock) {
+  if (freeBlock->getBlockState() == BLOCK_FULL) {
     lastHotFreeBlock.at(lastHotFreeBlockIndex) = getHotFreeBlock(lastHotFreeBlockIndex);
 
     bReclaimMore = true;
@@ -2165,15 +2317,15 @@ uint32_t PageMapping::getLastColdFreeBlock(Bitset &iomap) {
     lastColdFreeBlockIOMap |= iomap;
   }
 
-  auto freeBlock = blocks.find(lastColdFreeBlock.at(lastColdFreeBlockIndex));
+  auto freeBlock = findBlock(lastColdFreeBlock.at(lastColdFreeBlockIndex));
 
   // Sanity check
-  if (freeBlock == blocks.end()) {
+  if (!freeBlock) {
     panic("Corrupted");
   }
 
   // If current free block is full, get next block
-  if (freeBlock->second.getNextWritePageIndex() == param.pagesInBlock) {
+  if (freeBlock->getBlockState() == BLOCK_FULL) {
     lastColdFreeBlock.at(lastColdFreeBlockIndex) = getColdFreeBlock(lastColdFreeBlockIndex, false);
 
     bReclaimMore = true;
@@ -2198,15 +2350,15 @@ uint32_t PageMapping::getLastCoolFreeBlock(Bitset &iomap) {
     lastCoolFreeBlockIOMap |= iomap;
   }
 
-  auto freeBlock = blocks.find(lastCoolFreeBlock.at(lastCoolFreeBlockIndex));
+  auto freeBlock = findBlock(lastCoolFreeBlock.at(lastCoolFreeBlockIndex));
 
   // Sanity check
-  if (freeBlock == blocks.end()) {
+  if (!freeBlock) {
     panic("Corrupted");
   }
 
   // If current free block is full, get next block
-  if (freeBlock->second.getNextWritePageIndex() == param.pagesInBlock) {
+  if (freeBlock->getBlockState() == BLOCK_FULL) {
     lastCoolFreeBlock.at(lastCoolFreeBlockIndex) = getColdFreeBlock(lastCoolFreeBlockIndex, true);
 
     bReclaimMore = true;
@@ -2223,44 +2375,26 @@ uint32_t PageMapping::getHotFreeBlock(uint32_t idx) {
   }
 
   if (nHotFreeBlocks > 0) {
-    // Search block which is blockIdx % param.pageCountToMaxPerf == idx
-    auto iter = hotFreeBlocks.begin();
-
-    for (; iter != hotFreeBlocks.end(); iter++) {
-      blockIndex = iter->getBlockIndex();
+    // Least worn block which is blockIdx % param.pageCountToMaxPerf == idx
+    // (or least worn one of any unit when there is no such block)
+    blockIndex = hotFreeBlocks.pop(idx);
 
-      if (blockIndex % param.pageCountToMaxPerf == idx) {
-        break;
-      }
-    }
-
-    // Sanity check
-    if (iter == hotFreeBlocks.end()) {
-      // Just use first one
-      iter = hotFreeBlocks.begin();
-      blockIndex = iter->getBlockIndex();
-    }
+    Block &block = blocks[blockIndex];
 
-    // Insert found block to block list
-    if (blocks.find(blockIndex) != blocks.end()) {
+    if (block.getBlockState() != BLOCK_FREE) {
       panic("Get hot free block - already in block list");
     }
 
-    blocks.emplace(blockIndex, std::move(*iter));
+    block.setBlockState(BLOCK_OPEN);
 
     // Update first write time
-    blocks.find(blockIndex)->second.setLastWrittenTime(getTick());
-    //blocks.find(blockIndex)->second.setInRefreshQueue(false);
-
-
-    // Remove found block from free block list
-    hotFreeBlocks.erase(iter);
+    block.setLastWrittenTime(getTick());
     nHotFreeBlocks--;
 
     // pop head of hot window will be done in hot GC operation
     // push to tail of hot window
     hotWindow.push_back(blockIndex);
-    blocks.find(blockIndex)->second.setBlockType(HOT);
+    block.setBlockType(HOT);
   }
   else {
     std::cout << "nHotFreeBlocks" << nHotFreeBlocks << std::endl;
@@ -2278,58 +2412,40 @@ uint32_t PageMapping::getColdFreeBlock(uint32_t idx, bool queueInsert) {
   }
 
   if (nColdFreeBlocks > 0) {
-    // Search block which is blockIdx % param.pageCountToMaxPerf == idx
-    auto iter = coldFreeBlocks.begin();
-
-    for (; iter != coldFreeBlocks.end(); iter++) {
-      blockIndex = iter->getBlockIndex();
+    // Least worn block which is blockIdx % param.pageCountToMaxPerf == idx
+    // (or least worn one of any unit when there is no such block)
+    blockIndex = coldFreeBlocks.pop(idx);
 
-      if (blockIndex % param.pageCountToMaxPerf == idx) {
-        break;
-      }
-    }
-
-    // Sanity check
-    if (iter == coldFreeBlocks.end()) {
-      // Just use first one
-      iter = coldFreeBlocks.begin();
-      blockIndex = iter->getBlockIndex();
-    }
+    Block &block = blocks[blockIndex];
 
-    // Insert found block to block list
-    if (blocks.find(blockIndex) != blocks.end()) {
+    if (block.getBlockState() != BLOCK_FREE) {
       panic("Get cold free block - already in block list");
     }
 
-    blocks.emplace(blockIndex, std::move(*iter));
+    block.setBlockState(BLOCK_OPEN);
 
     // Update first write time
-    blocks.find(blockIndex)->second.setLastWrittenTime(getTick());
-    //blocks.find(blockIndex)->second.setInRefreshQueue(false);
-
-
-    // Remove found block from free block list
-    coldFreeBlocks.erase(iter);
+    block.setLastWrittenTime(getTick());
     nColdFreeBlocks--;
 
     if (queueInsert) {    // Insert to cool down window (false if cold block refresh)
       if (coolDownWindow.size() >= nCooldownBlocks) {
         // pop head of cool down window, (virtually) inserted to cold window
-        auto prevFront = blocks.find(coolDownWindow.front());
-        if (prevFront == blocks.end()) {
+        auto prevFront = findBlock(coolDownWindow.front());
+        if (!prevFront) {
           panic("Corrupted. cool block lost");
         }
 
-        prevFront->second.setBlockType(COLD);
+        prevFront->setBlockType(COLD);
         
         coolDownWindow.pop_front();       
       }
       // push to tail of cool down window
       coolDownWindow.push_back(blockIndex);
-      blocks.find(blockIndex)->second.setBlockType(COOL);
+      block.setBlockType(COOL);
     }
     else {
-      blocks.find(blockIndex)->second.setBlockType(COLD);
+      block.setBlockType(COLD);
     }
   }
   else {
@@ -2349,9 +2465,9 @@ float PageMapping::coldFreeBlockRatio() {
 }
 
 void PageMapping::selectHotVictimBlock(std::vector<uint32_t> &list, uint64_t &tick) {
-  static const GC_MODE mode = (GC_MODE)conf.readInt(CONFIG_FTL, FTL_GC_MODE);
+  const GC_MODE mode = cfg.gcMode;
   // Evict policy mode : LRU
-  uint64_t nBlocks = conf.readUint(CONFIG_FTL, FTL_GC_RECLAIM_BLOCK);
+  uint64_t nBlocks = cfg.reclaimBlock;
 
   list.clear();
 
@@ -2360,8 +2476,7 @@ void PageMapping::selectHotVictimBlock(std::vector<uint32_t> &list, uint64_t &ti
     // DO NOTHING
   }
   else if (mode == GC_MODE_1) {
-    static const float t = conf.readFloat(CONFIG_FTL, FTL_GC_RECLAIM_THRESHOLD);
-    nBlocks = hotBlocksLimit * t - nHotFreeBlocks;
+    nBlocks = hotBlocksLimit * cfg.reclaimThreshold - nHotFreeBlocks;
   }
   else {
     panic("Invalid GC mode");
@@ -2390,40 +2505,40 @@ void PageMapping::selectHotVictimBlock(std::vector<uint32_t> &list, uint64_t &ti
 
 // calculate weight of each block regarding victim selection policy
 void PageMapping::calculateColdVictimWeight(
-    std::vector<std::pair<uint32_t, float>> &weight, const EVICT_POLICY policy) {
+    std::vector<std::pair<uint32_t, float>> &weight) {
 
   float temp;
 
   weight.reserve(coldBlocksLimit - nColdFreeBlocks);
 
-  switch (policy) {
+  switch (cfg.evictPolicy) {
     case POLICY_GREEDY:
       for (auto &iter : blocks) {
         // Exclude hot blocks
-        if (iter.second.getBlockType() == HOT){
+        if (iter.getBlockType() == HOT){
           continue;
         }
         
-        if (iter.second.getNextWritePageIndex() != param.pagesInBlock) {
+        if (iter.getBlockState() != BLOCK_FULL) {
           continue;
         }
 
-        weight.push_back({iter.first, iter.second.getValidPageCountRaw()});
+        weight.push_back({iter.getBlockIndex(), iter.getValidPageCountRaw()});
       }
 
       break;
     case POLICY_RECO:
       for (auto &iter : blocks) {
-        if (iter.second.getBlockType() == HOT){
+        if (iter.getBlockType() == HOT){
           continue;
         }
-        if (iter.second.getNextWritePageIndex() != param.pagesInBlock) {
+        if (iter.getBlockState() != BLOCK_FULL) {
           continue;
         }
-        float refreshWeight = conf.readFloat(CONFIG_FTL, FTL_GC_RECO_PARAM);
-        temp = iter.second.getValidPageCountRaw() - ( refreshWeight * iter.second.getRefreshedPageCount() );
+        float refreshWeight = cfg.recoParam;
+        temp = iter.getValidPageCountRaw() - ( refreshWeight * iter.getRefreshedPageCount() );
 
-        weight.push_back({iter.first, temp});
+        weight.push_back({iter.getBlockIndex(), temp});
       }
       break;
     default:
@@ -2432,10 +2547,9 @@ void PageMapping::calculateColdVictimWeight(
 }
 
 void PageMapping::selectColdVictimBlock(std::vector<uint32_t> &list, uint64_t &tick) {
-  static const GC_MODE mode = (GC_MODE)conf.readInt(CONFIG_FTL, FTL_GC_MODE);
-  static const EVICT_POLICY policy = (EVICT_POLICY)conf.readInt(CONFIG_FTL, FTL_GC_EVICT_POLICY);
+  const GC_MODE mode = cfg.gcMode;
 
-  uint64_t nBlocks = conf.readUint(CONFIG_FTL, FTL_GC_RECLAIM_BLOCK);
+  uint64_t nBlocks = cfg.reclaimBlock;
   std::vector<std::pair<uint32_t, float>> weight;
 
   list.clear();
@@ -2445,9 +2559,7 @@ void PageMapping::selectColdVictimBlock(std::vector<uint32_t> &list, uint64_t &t
     // DO NOTHING
   }
   else if (mode == GC_MODE_1) {
-    static const float t = conf.readFloat(CONFIG_FTL, FTL_GC_RECLAIM_THRESHOLD);
-
-    nBlocks = coldBlocksLimit * t - nColdFreeBlocks;
+    nBlocks = coldBlocksLimit * cfg.reclaimThreshold - nColdFreeBlocks;
   }
   else {
     panic("Invalid GC mode");
@@ -2460,25 +2572,34 @@ void PageMapping::selectColdVictimBlock(std::vector<uint32_t> &list, uint64_t &t
     bReclaimMore = false;
   }
 
-  // Calculate weights of all blocks
-  calculateColdVictimWeight(weight, policy);
+  if (victimIndex.isEnabled()) {
+    // Exclude hot blocks
+    victimIndex.select(list, nBlocks, [this](uint32_t blockIndex) -> bool {
+      return blocks[blockIndex].getBlockType() == HOT;
+    });
+  }
+  else {
+    // Calculate weights of all blocks
+    calculateColdVictimWeight(weight);
 
-  // Sort weights
-  std::sort(
-      weight.begin(), weight.end(),
-      [](std::pair<uint32_t, float> a, std::pair<uint32_t, float> b) -> bool {
-        return a.second < b.second;
-      });
+    // Select victims from the blocks with the lowest weight
+    nBlocks = MIN(nBlocks, weight.size());
 
-  // Select victims from the blocks with the lowest weight
-  nBlocks = MIN(nBlocks, weight.size());
+    std::partial_sort(
+        weight.begin(), weight.begin() + nBlocks, weight.end(),
+        [](std::pair<uint32_t, float> a, std::pair<uint32_t, float> b) -> bool {
+          return a.second < b.second;
+        });
 
+    for (uint64_t i = 0; i < nBlocks; i++) {
+      list.push_back(weight.at(i).first);
+    }
+  }
 
-  for (uint64_t i = 0; i < nBlocks; i++) {
-    list.push_back(weight.at(i).first);
+  for (auto &victim : list) {
     for (auto iter = coolDownWindow.begin(); iter < coolDownWindow.end(); iter++) {
       // if victim is in cool down window, evict from it
-      if (weight.at(i).first == *iter) {
+      if (victim == *iter) {
         coolDownWindow.erase(iter);
         break;
       }
@@ -2491,15 +2612,10 @@ void PageMapping::selectColdVictimBlock(std::vector<uint32_t> &list, uint64_t &t
 void PageMapping::sepDoGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
                                       uint64_t &tick, bool isRefresh, blockPoolType gcType) {
   PAL::Request req(param.ioUnitInPage);
-  std::vector<PAL::Request> readRequests;
-  std::vector<PAL::Request> writeRequests;
-  std::vector<PAL::Request> eraseRequests;
+  CopyBatch batch;
   std::vector<uint64_t> lpns;
   Bitset bit(param.ioUnitInPage);
-  uint64_t beginAt;
-  uint64_t readFinishedAt = tick;
-  uint64_t writeFinishedAt = tick;
-  uint64_t eraseFinishedAt = tick;
+  uint64_t beginAt = tick;
 
   if (blocksToReclaim.size() == 0) {
     return;
@@ -2507,9 +2623,9 @@ void PageMapping::sepDoGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
 
   // For all blocks to reclaim, collecting request structure only
   for (auto &iter : blocksToReclaim) {
-    auto block = blocks.find(iter);
+    auto block = findBlock(iter);
 
-    if (block == blocks.end()) {
+    if (!block) {
       std::cout << "GC block type: " << gcType << std::endl;
       std::cout << "blocksToReclaim: "; 
       for (auto &tempIter : blocksToReclaim) {
@@ -2522,7 +2638,7 @@ void PageMapping::sepDoGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
     // Copy valid pages to free block
     for (uint32_t pageIndex = 0; pageIndex < param.pagesInBlock; pageIndex++) {
       // Valid?
-      if (block->second.getPageInfo(pageIndex, lpns, bit)) {
+      if (block->getPageInfo(pageIndex, lpns, bit)) {
         if (!bRandomTweak) {
           bit.set();
         }
@@ -2530,40 +2646,42 @@ void PageMapping::sepDoGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
         // Retrive free block
         // The data evicted from hot queue goes to cool down window
         // The data GCed from cool / cold queue also goes to cool window again
-        auto freeBlock = blocks.find(getLastCoolFreeBlock(bit));
-        //auto freeBlock = blocks.find(getLastFreeBlock());
+        auto freeBlock = findBlock(getLastCoolFreeBlock(bit));
+        //auto freeBlock = findBlock(getLastFreeBlock());
 
         // Issue Read
-        req.blockIndex = block->first;
+        req.blockIndex = block->getBlockIndex();
         req.pageIndex = pageIndex;
         req.ioFlag = bit;
 
-        readRequests.push_back(req);
+        batch.reads.push_back(req);
+        batch.onDie.push_back(
+            useCopyback(block, pageIndex, freeBlock->getBlockIndex(), tick));
 
         // Update mapping table
-        uint32_t newBlockIdx = freeBlock->first;
+        uint32_t newBlockIdx = freeBlock->getBlockIndex();
 
         for (uint32_t idx = 0; idx < bitsetSize; idx++) {
           if (bit.test(idx)) {
             // Invalidate
-            block->second.invalidate(pageIndex, idx);
+            block->invalidate(pageIndex, idx);
 
             auto mappingList = table.find(lpns.at(idx));
 
-            if (mappingList == table.end()) {
+            if (!mappingList) {
               panic("Invalid mapping table entry");
             }
 
-            pDRAM->read(&(*mappingList), 8 * param.ioUnitInPage, tick);
+            pDRAM->read(mappingList, 8 * param.ioUnitInPage, tick);
 
-            auto &mapping = mappingList->second.at(idx);
+            auto &mapping = mappingList[idx];
 
-            uint32_t newPageIdx = freeBlock->second.getNextWritePageIndex(idx);
+            uint32_t newPageIdx = freeBlock->getNextWritePageIndex(idx);
 
             mapping.first = newBlockIdx;
             mapping.second = newPageIdx;
 
-            freeBlock->second.write(newPageIdx, lpns.at(idx), idx, beginAt);
+            freeBlock->write(newPageIdx, lpns.at(idx), idx, beginAt);
 
             // Issue Write
             req.blockIndex = newBlockIdx;
@@ -2577,11 +2695,12 @@ void PageMapping::sepDoGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
               req.ioFlag.set();
             }
 
-            writeRequests.push_back(req);
+            batch.writes.push_back(req);
+            batch.writeSource.push_back(batch.reads.size() - 1);
 
             // set new refresh period
-            uint32_t eraseCount = freeBlock->second.getEraseCount();
-            uint32_t layerNumber = newPageIdx % 64;
+            uint32_t eraseCount = freeBlock->getEraseCount();
+            uint32_t layerNumber = newPageIdx % cfg.layerCount;
 
             setRefreshPeriod(eraseCount, newBlockIdx, layerNumber);
 
@@ -2606,44 +2725,19 @@ void PageMapping::sepDoGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
     }
 
     // Erase block
-    req.blockIndex = block->first;
+    req.blockIndex = block->getBlockIndex();
     req.pageIndex = 0;
     req.ioFlag.set();
 
-    eraseRequests.push_back(req);
-  }
-
-  // Do actual I/O here
-  // This handles PAL2 limitation (SIGSEGV, infinite loop, or so-on)
-  
-  for (auto &iter : readRequests) {
-    beginAt = tick;
-
-    pPAL->read(iter, beginAt);
-
-    readFinishedAt = MAX(readFinishedAt, beginAt);
-  }
-
-  for (auto &iter : writeRequests) {
-    beginAt = readFinishedAt;
-
-    pPAL->write(iter, beginAt);
-
-    writeFinishedAt = MAX(writeFinishedAt, beginAt);
-  }
-
-  for (auto &iter : eraseRequests) {
-    beginAt = readFinishedAt;
-
-    sepEraseInternal(iter, beginAt);
-
-    eraseFinishedAt = MAX(eraseFinishedAt, beginAt);
+    batch.erases.push_back(req);
+    batch.eraseReadEnd.push_back(batch.reads.size());
   }
-  
 
+  issueCopies(batch, tick, &PageMapping::sepEraseInternal);
 
-  tick = MAX(writeFinishedAt, eraseFinishedAt);
   tick += applyLatency(CPU::FTL__PAGE_MAPPING, CPU::DO_GARBAGE_COLLECTION);
+
+  updateGCTime(tick - beginAt);
 }
 
 
@@ -2655,24 +2749,20 @@ float PageMapping::calculateWearLeveling() {
   uint64_t eraseCnt;
 
   for (auto &iter : blocks) {
-    eraseCnt = iter.second.getEraseCount();
-    totalEraseCnt += eraseCnt;
-    sumOfSquaredEraseCnt += eraseCnt * eraseCnt;
-  }
-
-  // freeBlocks is sorted
-  // Calculate from backward, stop when eraseCnt is zero
-  for (auto riter = freeBlocks.rbegin(); riter != freeBlocks.rend(); riter++) {
-    eraseCnt = riter->getEraseCount();
-
-    if (eraseCnt == 0) {
-      break;
+    if (iter.getBlockState() != BLOCK_OPEN &&
+        iter.getBlockState() != BLOCK_FULL) {
+      continue;
     }
 
+    eraseCnt = iter.getEraseCount();
     totalEraseCnt += eraseCnt;
     sumOfSquaredEraseCnt += eraseCnt * eraseCnt;
   }
 
+  // Free blocks with zero erase count add nothing
+  totalEraseCnt += freeBlocks.getEraseCountSum();
+  sumOfSquaredEraseCnt += freeBlocks.getEraseCountSquareSum();
+
   if (sumOfSquaredEraseCnt == 0) {
     return -1;  // no meaning of wear-leveling
   }
@@ -2686,8 +2776,13 @@ void PageMapping::calculateTotalPages(uint64_t &valid, uint64_t &invalid) {
   invalid = 0;
 
   for (auto &iter : blocks) {
-    valid += iter.second.getValidPageCount();
-    invalid += iter.second.getDirtyPageCount();
+    if (iter.getBlockState() != BLOCK_OPEN &&
+        iter.getBlockState() != BLOCK_FULL) {
+      continue;
+    }
+
+    valid += iter.getValidPageCount();
+    invalid += iter.getDirtyPageCount();
   }
 }
 
@@ -2696,7 +2791,12 @@ float PageMapping::calculateAverageError(){
   float validBlockCount = 0;
 
   for (auto &iter : blocks) {
-    totalError = totalError + iter.second.getMaxErrorCount();  
+    if (iter.getBlockState() != BLOCK_OPEN &&
+        iter.getBlockState() != BLOCK_FULL) {
+      continue;
+    }
+
+    totalError = totalError + iter.getMaxErrorCount();  
     validBlockCount = validBlockCount + 1;
   }
 
@@ -2729,6 +2829,18 @@ void PageMapping::getStatList(std::vector<Stats> &list, std::string prefix) {
   temp.desc = "Total copied valid pages during GC due to refresh";
   list.push_back(temp);
 
+  temp.name = prefix + "page_mapping.gc.time";
+  temp.desc = "Total simulated GC time (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.gc.avg_time";
+  temp.desc = "Average simulated time of GC invocation (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.gc.max_time";
+  temp.desc = "Maximum simulated time of GC invocation (ps)";
+  list.push_back(temp);
+
   temp.name = prefix + "page_mapping.refresh.count";
   temp.desc = "Total Refresh count";
   list.push_back(temp);
@@ -2749,6 +2861,34 @@ void PageMapping::getStatList(std::vector<Stats> &list, std::string prefix) {
   temp.desc = "The number of refresh call";
   list.push_back(temp);
 
+  temp.name = prefix + "page_mapping.refresh.chunks";
+  temp.desc = "The number of refresh chunks done";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.refresh.deferred_chunks";
+  temp.desc = "The number of refresh chunks deferred by host I/O";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.refresh.pending_layers";
+  temp.desc = "Layers waiting for background refresh";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.refresh.busy_time";
+  temp.desc = "Total simulated time of refresh I/O (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.refresh.bandwidth";
+  temp.desc = "Refresh copy bandwidth while refreshing (MB/s)";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.refresh.overlapped_host_io";
+  temp.desc = "Host I/O started while refresh I/O in progress";
+  list.push_back(temp);
+
+  temp.name = prefix + "page_mapping.refresh.overlapped_host_time";
+  temp.desc = "Host I/O time overlapped with refresh I/O (ps)";
+  list.push_back(temp);
+
 
 
   temp.name = prefix + "page_mapping.hot_gc.count";
@@ -2837,12 +2977,32 @@ void PageMapping::getStatValues(std::vector<double> &values) {
   values.push_back(stat.validSuperPageCopies);
   values.push_back(stat.validPageCopies);
   values.push_back(stat.refreshGcPageCopies);
+  values.push_back(stat.gcTime);
+  values.push_back(stat.gcRuns > 0 ? (double)stat.gcTime / stat.gcRuns : 0.0);
+  values.push_back(stat.gcMaxTime);
  
   values.push_back(stat.refreshCount);
   values.push_back(stat.refreshedBlocks);
   values.push_back(stat.refreshSuperPageCopies);
   values.push_back(stat.refreshPageCopies);
   values.push_back(stat.refreshCallCount);
+
+  uint64_t pendingLayers = 0;
+
+  for (auto &iter : refreshJobs) {
+    pendingLayers += iter.budget;
+  }
+
+  values.push_back(stat.refreshChunks);
+  values.push_back(stat.refreshDeferredChunks);
+  values.push_back(pendingLayers);
+  values.push_back(stat.refreshBusyTime);
+  values.push_back(stat.refreshBusyTime > 0
+                       ? stat.refreshPageCopies * param.pageSize /
+                             bitsetSize / (stat.refreshBusyTime / 1000000.0)
+                       : 0.0);
+  values.push_back(stat.refreshOverlappedHostIO);
+  values.push_back(stat.refreshOverlappedHostTime);
   //values.push_back(stat.layerCheckCount);
   values.push_back(stat.hotGcCount);
   values.push_back(stat.reclaimedHotBlocks);
@@ -2896,7 +3056,7 @@ void PageMapping::doRefresh(std::vector<uint32_t> &blocksToRefresh,
 
   std::vector<uint64_t> tempLpns;
   Bitset tempBit(param.ioUnitInPage);
-  static float gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
+  float gcThreshold = conf.readFloat(CONFIG_FTL, FTL_GC_THRESHOLD_RATIO);
 
   if (blocksToRefresh.size() == 0) {
     return;
@@ -2985,13 +3145,13 @@ void PageMapping::doRefresh(std::vector<uint32_t> &blocksToRefresh,
             auto mappingList = table.find(lpns.at(idx));
             //debugprint(LOG_FTL_PAGE_MAPPING, "Found mapping list");
 
-            if (mappingList == table.end()) {
+            if (!mappingList) {
               panic("Invalid mapping table entry, refresh failed");
             }
 
-            pDRAM->read(&(*mappingList), 8 * param.ioUnitInPage, tick);
+            pDRAM->read(mappingList, 8 * param.ioUnitInPage, tick);
 
-            auto &mapping = mappingList->second.at(idx);
+            auto &mapping = mappingList[idx];
             //debugprint(LOG_FTL_PAGE_MAPPING, "Found mapping");
 
             uint32_t newPageIdx = freeBlock->second.getNextWritePageIndex(idx);
@@ -3060,8 +3220,7 @@ void PageMapping::calculateRefreshWeight(
     std::vector<std::pair<uint32_t, float>> &weight, const REFRESH_POLICY policy,
     uint64_t tick) {
 
-  static uint64_t refreshThreshold =
-      conf.readUint(CONFIG_FTL, FTL_REFRESH_THRESHOLD);
+  uint64_t refreshThreshold = conf.readUint(CONFIG_FTL, FTL_REFRESH_THRESHOLD);
 
   weight.reserve(blocks.size());
 
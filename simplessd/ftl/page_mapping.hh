@@ -21,43 +21,81 @@
 #define __FTL_PAGE_MAPPING__
 
 #include <cinttypes>
-#include <unordered_map>
 #include <vector>
 #include <fstream>
 #include <deque>
 
 #include "ftl/abstract_ftl.hh"
 #include "ftl/common/block.hh"
+#include "ftl/common/free_block_pool.hh"
+#include "ftl/common/refresh_queue.hh"
+#include "ftl/common/mapping_table.hh"
+#include "ftl/common/victim_index.hh"
 #include "ftl/ftl.hh"
 #include "pal/pal.hh"
 
 #include "ftl/error_modeling.hh"
 
 #include "ftl/bloom_filter.hh" // for bloom filter
-#include "sim/engine.hh"
-
-extern Engine engine;
 
 namespace SimpleSSD {
 
 namespace FTL {
 
+// FTL options used by page mapping, resolved once at construction so hot paths
+// do not go through ConfigReader
+typedef struct {
+  uint32_t initialEraseCount;
+  bool randomIOTweak;
+
+  // Garbage collection
+  GC_MODE gcMode;
+  EVICT_POLICY evictPolicy;
+  float gcThreshold;
+  uint64_t reclaimBlock;
+  float reclaimThreshold;
+  uint32_t dChoiceParam;
+  float recoParam;
+  uint64_t badBlockThreshold;
+  uint32_t copybackLimit;  // 0: copyback disabled
+
+  // Refresh
+  uint32_t refreshFilterNum;
+  float refreshMaxRBER;
+  uint32_t refreshMode;
+  uint32_t refreshGroupingSize;
+  uint32_t refreshMaxLayerNum;
+  uint32_t refreshChunkLayerNum;  // 0: refresh all layers at refresh event
+  uint64_t refreshIdleTime;
+
+  // Layers per block, page i is in layer (i % layerCount)
+  uint32_t layerCount;
+
+  // Hot cold seperation
+  bool hotColdSeparation;
+  float hotBlockRatio;
+  uint32_t coolDownWindowSize;
+} PageMappingConfig;
+
 class PageMapping : public AbstractFTL {
  private:
   PAL::PAL *pPAL;
 
   ConfigReader &conf;
+  const PageMappingConfig cfg;
 
-  std::unordered_map<uint64_t, std::vector<std::pair<uint32_t, uint32_t>>>
-      table;
-  std::unordered_map<uint32_t, Block> blocks;
-  std::list<Block> freeBlocks;
-  uint32_t nFreeBlocks;  // For some libraries which std::list::size() is O(n)
+  MappingTable table;
+  std::vector<Block> blocks;  // All physical blocks, indexed by block index
+  FreeBlockPool freeBlocks;
+  VictimIndex victimIndex;
+  uint32_t nFreeBlocks;
   std::vector<uint32_t> lastFreeBlock;
   Bitset lastFreeBlockIOMap;
   uint32_t lastFreeBlockIndex;
 
-  std::vector<uint32_t> layerQueueNum;
+  // On-die copies of each page since it last passed controller ECC, indexed
+  // by block * pagesInBlock + page. Empty when copyback is disabled.
+  std::vector<uint8_t> copybackCount;
 
   bool bReclaimMore;
   bool bRandomTweak;
@@ -69,6 +107,9 @@ class PageMapping : public AbstractFTL {
     uint64_t validSuperPageCopies;
     uint64_t validPageCopies;
     uint64_t refreshGcPageCopies;
+    uint64_t gcTime;
+    uint64_t gcMaxTime;
+    uint64_t gcRuns;
 
     // Refresh stat
     uint64_t refreshCount;
@@ -78,8 +119,16 @@ class PageMapping : public AbstractFTL {
     uint64_t refreshCallCount;
     uint64_t layerCheckCount;
 
+    // Refresh queue never holds a layer twice, kept for stat layout
     uint64_t doubleInsertionCount;
 
+    // Background refresh
+    uint64_t refreshChunks;
+    uint64_t refreshDeferredChunks;
+    uint64_t refreshBusyTime;
+    uint64_t refreshOverlappedHostIO;
+    uint64_t refreshOverlappedHostTime;
+
     // Hot cold seperation
     uint64_t hotGcCount;
     uint64_t reclaimedHotBlocks;
@@ -100,20 +149,34 @@ class PageMapping : public AbstractFTL {
   uint64_t refresh_period;
   uint32_t background_ratio;
 
-  Bitset insertedLayerCheck;
   Bitset insertedGroupCheck;
-  std::vector< std::deque<uint32_t> > refreshQueues;
-  std::vector< std::deque<uint32_t> > checkedQueues;
+  RefreshQueue refreshQueue;
+
+  // Background refresh: checked layers of queue are refreshed in chunks of
+  // refreshChunkLayerNum layers, spread over refresh period. A chunk waits
+  // for host idle time, but not past its deadline (one interval later).
+  typedef struct {
+    uint32_t queue;
+    uint32_t budget;  // Layers left to refresh in this turn
+  } RefreshJob;
+
+  std::deque<RefreshJob> refreshJobs;
+  SimpleSSD::Event refreshEvent;
+  SimpleSSD::Event refreshChunkEvent;
+  uint64_t refreshChunkInterval;
+  uint64_t refreshChunkDeadline;
+  uint64_t hostBusyUntil;
+  uint64_t refreshBusyUntil;
+
+  void startBackgroundRefresh(uint32_t, uint64_t);
+  void refreshChunk(uint64_t);
+  void updateHostIO(uint64_t, uint64_t);
   
   std::ofstream refreshStatFile;
 
   // Hot cold seperation
-  std::unordered_map<uint32_t, Block> hotPoolBlocks;
-  std::unordered_map<uint32_t, Block> coldPoolBlocks;
-  std::unordered_map<uint32_t, Block> coolDownBlocks;
-
-  std::list<Block> hotFreeBlocks;
-  std::list<Block> coldFreeBlocks;
+  FreeBlockPool hotFreeBlocks;
+  FreeBlockPool coldFreeBlocks;
   
   uint32_t nHotFreeBlocks;
   uint32_t nColdFreeBlocks;
@@ -139,21 +202,57 @@ class PageMapping : public AbstractFTL {
 
 
 
+  static PageMappingConfig readConfig(ConfigReader &);
+
   // Refresh
   void refresh_event(uint64_t);
   void setRefreshPeriod(uint32_t, uint32_t, uint32_t);
+
+  // Refresh queue insertion of each grouping mode (RefreshMode)
+  template <uint32_t MODE>
+  void setRefreshPeriodMode(uint32_t, uint32_t, uint32_t);
+  void (PageMapping::*pSetRefreshPeriod)(uint32_t, uint32_t, uint32_t);
   void insertToQueue(uint32_t, uint32_t);
-  void removeFromQueue(uint32_t);
+
+  Block *findBlock(uint32_t);
 
   float freeBlockRatio();
   uint32_t convertBlockIdx(uint32_t);
   uint32_t getFreeBlock(uint32_t);
   uint32_t getLastFreeBlock(Bitset &);
+  uint32_t getLastFreeBlock(Bitset &, uint32_t);
   void calculateVictimWeight(std::vector<std::pair<uint32_t, float>> &,
-                             const EVICT_POLICY, uint64_t);
+                             uint64_t);
+
+  // Victim weight of each evict policy (EvictPolicy)
+  template <EVICT_POLICY POLICY>
+  void calculateVictimWeightPolicy(std::vector<std::pair<uint32_t, float>> &,
+                                   uint64_t);
+  void (PageMapping::*pCalculateVictimWeight)(
+      std::vector<std::pair<uint32_t, float>> &, uint64_t);
+
+  void selectPolicy();
   void selectVictimBlock(std::vector<uint32_t> &, uint64_t &, std::vector<uint32_t> &);
   void doGarbageCollection(std::vector<uint32_t> &, uint64_t &, bool);
 
+  // Valid page copies of GC and refresh. Each write waits only for the read
+  // it copies, and each erase only for reads of its own block, so PAL
+  // overlaps them across dies instead of running reads, writes and erases
+  // as three barriers.
+  typedef struct {
+    std::vector<PAL::Request> reads;
+    std::vector<PAL::Request> writes;
+    std::vector<uint32_t> writeSource;   // Index of read copied by write
+    std::vector<PAL::Request> erases;
+    std::vector<uint32_t> eraseReadEnd;  // Reads of erased block end here
+    std::vector<bool> onDie;             // Read is moved by copyback
+  } CopyBatch;
+
+  void issueCopies(CopyBatch &, uint64_t &,
+                   void (PageMapping::*)(PAL::Request &, uint64_t &));
+  bool useCopyback(Block *, uint32_t, uint32_t, uint64_t);
+  void updateGCTime(uint64_t);
+
   float calculateWearLeveling();
   void calculateTotalPages(uint64_t &, uint64_t &);
 
@@ -168,7 +267,7 @@ class PageMapping : public AbstractFTL {
   void calculateRefreshWeight(std::vector<std::pair<uint32_t, float>> &,
                             const REFRESH_POLICY, uint64_t);
 
-  void refreshPage(uint32_t, uint64_t &);
+  uint32_t refreshPage(uint32_t, uint32_t, uint64_t &);
   
   float calculateAverageError();
 
@@ -186,8 +285,7 @@ class PageMapping : public AbstractFTL {
   uint32_t getHotFreeBlock(uint32_t);
   uint32_t getColdFreeBlock(uint32_t, bool);
 
-  void calculateColdVictimWeight(std::vector<std::pair<uint32_t, float>> &,
-                             const EVICT_POLICY);
+  void calculateColdVictimWeight(std::vector<std::pair<uint32_t, float>> &);
   void selectColdVictimBlock(std::vector<uint32_t> &, uint64_t &);
   void selectHotVictimBlock(std::vector<uint32_t> &, uint64_t &);
 
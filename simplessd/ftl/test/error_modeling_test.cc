@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Refresh index from getRefreshIndex must follow distribution of drawing
+// getRBER at each refresh period until it exceeds maxRBER.
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "ftl/error_modeling.hh"
+
+using namespace SimpleSSD::FTL;
+
+// temp25_pe3000.cfg with 2 hour refresh period and 400 refresh queues
+const uint64_t refreshPeriod = 7200000000000000;
+const uint32_t queueCount = 400;
+const uint32_t sampleCount = 20000;
+
+ErrorModeling makeModel(float sigma, uint32_t seed) {
+  ErrorModeling model(25, 1.1, -12.72, 0.00000792, 0.25, 0.0000328, 0, 0, 0,
+                      sigma, 16384, seed);
+
+  // Default layer factors: 1.00, 1.01, ..., 1.20 in each segment
+  model.setLayerModel(64, 1, "", "", "");
+  model.setRefreshSchedule(refreshPeriod, queueCount);
+
+  return model;
+}
+
+// Refresh scheduling before table-driven model
+uint32_t getRefreshIndexLoop(ErrorModeling &model, float peCycle,
+                             uint32_t layer, float maxRBER) {
+  for (uint32_t i = 1; i < queueCount; i++) {
+    if (model.getRBER(refreshPeriod * i, peCycle, 0, layer) > maxRBER) {
+      return i;
+    }
+  }
+
+  return queueCount;
+}
+
+// Histogram of refresh index, index 1 to queueCount
+std::vector<uint32_t> sample(ErrorModeling &model, bool loop, float peCycle,
+                             uint32_t layer, float maxRBER, double &mean) {
+  std::vector<uint32_t> hist(queueCount + 1, 0);
+
+  mean = 0.;
+
+  for (uint32_t i = 0; i < sampleCount; i++) {
+    uint32_t index = loop ? getRefreshIndexLoop(model, peCycle, layer, maxRBER)
+                          : model.getRefreshIndex(peCycle, 0, layer, maxRBER);
+
+    hist[index]++;
+    mean += index;
+  }
+
+  mean /= sampleCount;
+
+  return hist;
+}
+
+// Two-sample Kolmogorov-Smirnov statistic of same-sized histograms
+double getDistance(std::vector<uint32_t> &a, std::vector<uint32_t> &b) {
+  int64_t diff = 0;
+  int64_t maxDiff = 0;
+
+  for (uint32_t i = 0; i < a.size(); i++) {
+    diff += (int64_t)a[i] - (int64_t)b[i];
+    maxDiff = std::max(maxDiff, std::abs(diff));
+  }
+
+  return (double)maxDiff / sampleCount;
+}
+
+int main() {
+  const float peList[] = {3000, 5000};
+  const uint32_t layerList[] = {0, 10, 20};
+  const float maxRBERList[] = {0.00025, 0.00032};
+
+  // KS critical value at 0.1% significance
+  const double limit = 1.95 * sqrt(2. / sampleCount);
+  bool pass = true;
+
+  for (float pe : peList) {
+    for (uint32_t layer : layerList) {
+      for (float maxRBER : maxRBERList) {
+        ErrorModeling loop = makeModel(0.00002, 1);
+        ErrorModeling table = makeModel(0.00002, 2);
+        double loopMean;
+        double tableMean;
+
+        auto a = sample(loop, true, pe, layer, maxRBER, loopMean);
+        auto b = sample(table, false, pe, layer, maxRBER, tableMean);
+        double distance = getDistance(a, b);
+
+        std::cout << "PE " << pe << ", layer " << layer << ", MaxRBER "
+                  << maxRBER << ": mean " << loopMean << " (loop), "
+                  << tableMean << " (table), KS " << distance << std::endl;
+
+        if (distance > limit) {
+          std::cerr << "Refresh index distribution differs (KS " << distance
+                    << " > " << limit << ")" << std::endl;
+
+          pass = false;
+        }
+
+        // Without noise, both give same index
+        ErrorModeling exact = makeModel(0.f, 1);
+
+        if (getRefreshIndexLoop(exact, pe, layer, maxRBER) !=
+            exact.getRefreshIndex(pe, 0, layer, maxRBER)) {
+          std::cerr << "Refresh index differs without noise" << std::endl;
+
+          pass = false;
+        }
+      }
+    }
+  }
+
+  if (!pass) {
+    return 1;
+  }
+
+  std::cout << "Error model refresh index test passed" << std::endl;
+
+  return 0;
+}
@@ -35,6 +35,7 @@ const char NAME_AXI_CLOCK[] = "AXIClock";
 const char NAME_FIFO_UNIT[] = "FIFOTransferUnit";
 const char NAME_WORK_INTERVAL[] = "WorkInterval";
 const char NAME_MAX_REQUEST_COUNT[] = "MaxRequestCount";
+const char NAME_IDLE_FAST_FORWARD[] = "IdleFastForward";
 const char NAME_MAX_IO_CQUEUE[] = "MaxIOCQueue";
 const char NAME_MAX_IO_SQUEUE[] = "MaxIOSQueue";
 const char NAME_WRR_HIGH[] = "WRRHigh";
@@ -54,6 +55,7 @@ Config::Config() {
   fifoUnit = 4096;
   workInterval = 50000;
   maxRequestCount = 4;
+  idleFastForward = true;
   maxIOCQueue = 16;
   maxIOSQueue = 16;
   wrrHigh = 2;
@@ -124,6 +126,9 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_MAX_REQUEST_COUNT)) {
     maxRequestCount = strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_IDLE_FAST_FORWARD)) {
+    idleFastForward = convertBool(value);
+  }
   else if (MATCH_NAME(NAME_MAX_IO_CQUEUE)) {
     maxIOCQueue = (uint16_t)strtoul(value, nullptr, 10);
   }
@@ -263,6 +268,9 @@ bool Config::readBoolean(uint32_t idx) {
   bool ret = false;
 
   switch (idx) {
+    case NVME_IDLE_FAST_FORWARD:
+      ret = idleFastForward;
+      break;
     case NVME_ENABLE_DISK_IMAGE:
       ret = enableDiskImage;
       break;
@@ -41,6 +41,7 @@ typedef enum {
   NVME_FIFO_UNIT,
   NVME_WORK_INTERVAL,
   NVME_MAX_REQUEST_COUNT,
+  NVME_IDLE_FAST_FORWARD,
   NVME_MAX_IO_CQUEUE,
   NVME_MAX_IO_SQUEUE,
   NVME_WRR_HIGH,
@@ -62,6 +63,7 @@ class Config : public BaseConfig {
   uint64_t fifoUnit;             //!< Default: 4096
   uint64_t workInterval;         //!< Default: 50000 (50ns)
   uint64_t maxRequestCount;      //!< Default: 4
+  bool idleFastForward;          //!< Default: True
   uint16_t maxIOCQueue;          //!< Default: 16
   uint16_t maxIOSQueue;          //!< Default: 16
   uint16_t wrrHigh;              //!< Default: 2
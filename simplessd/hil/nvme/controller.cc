@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "hil/nvme/interface.hh"
 #include "hil/nvme/ocssd.hh"
@@ -59,6 +60,8 @@ Controller::Controller(Interface *intrface, ConfigReader &c)
   // Allocate array for Command Queues
   cqsize = conf.readUint(CONFIG_NVME, NVME_MAX_IO_CQUEUE) + 1;
   sqsize = conf.readUint(CONFIG_NVME, NVME_MAX_IO_SQUEUE) + 1;
+  wrrHigh = conf.readUint(CONFIG_NVME, NVME_WRR_HIGH);
+  wrrMedium = conf.readUint(CONFIG_NVME, NVME_WRR_MEDIUM);
 
   ppCQueue = (CQueue **)calloc(cqsize, sizeof(CQueue *));
   ppSQueue = (SQueue **)calloc(sqsize, sizeof(SQueue *));
@@ -116,6 +119,9 @@ Controller::Controller(Interface *intrface, ConfigReader &c)
   maxRequest = conf.readUint(CONFIG_NVME, NVME_MAX_REQUEST_COUNT);
   workInterval = conf.readUint(CONFIG_NVME, NVME_WORK_INTERVAL);
   requestInterval = workInterval / maxRequest;
+  idleFastForward = conf.readBoolean(CONFIG_NVME, NVME_IDLE_FAST_FORWARD);
+  sleeping = false;
+  nextWorkAt = 0;
 
   // Which subsystem should we use
   uint16_t vid, ssvid;
@@ -297,17 +303,21 @@ void Controller::writeRegister(uint64_t offset, uint64_t size, uint8_t *buffer,
           registers.status |= 0x00000005;  // Shutdown processing occurring
 
           shutdownReserved = true;
+
+          wakeup();
         }
         // If EN = 1, Set CSTS.RDY = 1
         else if (registers.configuration & 0x00000001) {
           registers.status |= 0x00000001;
 
+          sleeping = false;
           schedule(workEvent, getTick() + workInterval);
         }
         // If EN = 0, Set CSTS.RDY = 0
         else {
           registers.status &= 0xFFFFFFFE;
 
+          sleeping = false;
           deschedule(workEvent);
         }
 
@@ -456,6 +466,8 @@ void Controller::ringSQTailDoorbell(uint16_t qid, uint16_t tail, uint64_t &) {
                "%d -> %d | head %d | tail %d -> %d",
                qid, oldcount, pQueue->getItemCount(), pQueue->getHead(),
                oldtail, pQueue->getTail());
+
+    wakeup();
   }
 }
 
@@ -1374,8 +1386,6 @@ bool Controller::getCoalescing(uint16_t iv) {
 }
 
 void Controller::collectSQueue(DMAFunction &func, void *context) {
-  static uint16_t wrrHigh = conf.readUint(CONFIG_NVME, NVME_WRR_HIGH);
-  static uint16_t wrrMedium = conf.readUint(CONFIG_NVME, NVME_WRR_MEDIUM);
   DMAContext *pContext = new DMAContext(func, context);
 
   static DMAFunction doQueue = [](uint64_t now, void *context) {
@@ -1611,10 +1621,51 @@ void Controller::handleRequest(uint64_t now) {
     schedule(requestEvent, now + requestInterval);
   }
   else {
-    schedule(workEvent, MAX(now + requestInterval, lastWorkAt + workInterval));
+    uint64_t tick = MAX(now + requestInterval, lastWorkAt + workInterval);
+
+    if (idleFastForward && isIdle()) {
+      // Stop polling until SQ tail doorbell rings
+      sleeping = true;
+      nextWorkAt = tick;
+    }
+    else {
+      schedule(workEvent, tick);
+    }
   }
 }
 
+bool Controller::isIdle() {
+  if (lSQFIFO.size() > 0 || shutdownReserved) {
+    return false;
+  }
+
+  for (uint16_t i = 0; i < sqsize; i++) {
+    if (ppSQueue[i] && ppSQueue[i]->getItemCount() > 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Controller::wakeup() {
+  uint64_t now = getTick();
+
+  if (!sleeping) {
+    return;
+  }
+
+  sleeping = false;
+
+  // Resume on the tick that periodic polling would have reached. Idle loop
+  // takes exactly one workInterval when HIL has no dedicated core.
+  if (now > nextWorkAt) {
+    nextWorkAt += DIVCEIL(now - nextWorkAt, workInterval) * workInterval;
+  }
+
+  schedule(workEvent, nextWorkAt);
+}
+
 bool Controller::checkQueue(SQueue *pQueue, DMAFunction &func, void *context) {
   struct QueueContext {
     SQEntry entry;
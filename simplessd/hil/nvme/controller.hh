@@ -84,6 +84,8 @@ class Controller : public StatObject {
   uint64_t cqstride;         //!< Calculated CQ stride
   uint8_t adminQueueInited;  //!< Flag for initialization of Admin CQ/SQ
   uint16_t arbitration;      //!< Selected Arbitration Mechanism
+  uint16_t wrrHigh;          //!< Weight of high priority SQs
+  uint16_t wrrMedium;        //!< Weight of medium priority SQs
   uint32_t interruptMask;    //!< Variable to store current interrupt mask
 
   uint32_t cqsize;
@@ -112,7 +114,13 @@ class Controller : public StatObject {
   uint64_t workInterval;
   uint64_t lastWorkAt;
 
+  bool idleFastForward;
+  bool sleeping;        //!< Main loop stopped because all SQs are empty
+  uint64_t nextWorkAt;  //!< Next poll of main loop if it was not stopped
+
   bool checkQueue(SQueue *, DMAFunction &, void *);
+  bool isIdle();
+  void wakeup();
 
  public:
   Controller(Interface *, ConfigReader &);
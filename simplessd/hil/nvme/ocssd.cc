@@ -310,8 +310,7 @@ bool OpenChannelSSD12::parsePPA(uint64_t ppa, ::CPDPBP &addr) {
 }
 
 void OpenChannelSSD12::convertUnit(::CPDPBP &addr) {
-  static bool useMP =
-      conf.readBoolean(CONFIG_PAL, PAL::NAND_USE_MULTI_PLANE_OP);
+  bool useMP = conf.readBoolean(CONFIG_PAL, PAL::NAND_USE_MULTI_PLANE_OP);
 
   addr.Die = addr.Package % param.die;
   addr.Package = addr.Package / param.die;
@@ -1430,8 +1429,7 @@ void OpenChannelSSD20::convertUnit(std::vector<uint64_t> &lbaList,
                                    std::vector<::CPDPBP> &list,
                                    std::vector<ChunkUpdateEntry> &chunk,
                                    bool block, bool mode) {
-  static bool useMP =
-      conf.readBoolean(CONFIG_PAL, PAL::NAND_USE_MULTI_PLANE_OP);
+  bool useMP = conf.readBoolean(CONFIG_PAL, PAL::NAND_USE_MULTI_PLANE_OP);
 
   list.clear();
   chunk.clear();
@@ -839,8 +839,8 @@ bool Subsystem::abort(SQEntryWrapper &req, RequestFunction &func) {
 
 bool Subsystem::setFeatures(SQEntryWrapper &req, RequestFunction &func) {
   bool err = false;
-  static uint32_t cqsize = conf.readUint(CONFIG_NVME, NVME_MAX_IO_CQUEUE);
-  static uint32_t sqsize = conf.readUint(CONFIG_NVME, NVME_MAX_IO_SQUEUE);
+  uint32_t cqsize = conf.readUint(CONFIG_NVME, NVME_MAX_IO_CQUEUE);
+  uint32_t sqsize = conf.readUint(CONFIG_NVME, NVME_MAX_IO_SQUEUE);
 
   CQEntryWrapper resp(req);
   uint16_t fid = req.entry.dword10 & 0x00FF;
@@ -950,10 +950,12 @@ bool Subsystem::asyncEventReq(SQEntryWrapper &, RequestFunction &) {
 bool Subsystem::namespaceManagement(SQEntryWrapper &req,
                                     RequestFunction &func) {
   struct NamespaceManagementContext : public RequestContext {
+    Subsystem *subsystem;
     uint32_t nsid;
 
-    NamespaceManagementContext(RequestFunction &f, CQEntryWrapper &r)
-        : RequestContext(f, r), nsid(NSID_NONE) {}
+    NamespaceManagementContext(RequestFunction &f, CQEntryWrapper &r,
+                               Subsystem *s)
+        : RequestContext(f, r), subsystem(s), nsid(NSID_NONE) {}
   };
 
   bool err = false;
@@ -964,7 +966,7 @@ bool Subsystem::namespaceManagement(SQEntryWrapper &req,
   debugprint(LOG_HIL_NVME, "ADMIN   | Namespace Management | OP %d | NSID %d",
              sel, req.entry.namespaceID);
 
-  static DMAFunction dmaDone = [this](uint64_t, void *context) {
+  static DMAFunction dmaDone = [](uint64_t, void *context) {
     Namespace::Information info;
     NamespaceManagementContext *pContext =
         (NamespaceManagementContext *)context;
@@ -991,7 +993,7 @@ bool Subsystem::namespaceManagement(SQEntryWrapper &req,
 
     info.lbaSize = lbaSize[info.lbaFormatIndex];
 
-    bool ret = createNamespace(pContext->nsid, &info);
+    bool ret = pContext->subsystem->createNamespace(pContext->nsid, &info);
 
     if (ret) {
       pContext->resp.entry.dword0 = pContext->nsid;
@@ -1044,7 +1046,7 @@ bool Subsystem::namespaceManagement(SQEntryWrapper &req,
         err = true;
 
         NamespaceManagementContext *pContext =
-            new NamespaceManagementContext(func, resp);
+            new NamespaceManagementContext(func, resp, this);
 
         pContext->buffer = (uint8_t *)calloc(0x1000, sizeof(uint8_t));
         pContext->nsid = nsid;
@@ -1079,6 +1081,14 @@ bool Subsystem::namespaceManagement(SQEntryWrapper &req,
 
 bool Subsystem::namespaceAttachment(SQEntryWrapper &req,
                                     RequestFunction &func) {
+  struct NamespaceAttachmentContext : public IOContext {
+    Subsystem *subsystem;
+
+    NamespaceAttachmentContext(RequestFunction &f, CQEntryWrapper &r,
+                               Subsystem *s)
+        : IOContext(f, r), subsystem(s) {}
+  };
+
   CQEntryWrapper resp(req);
 
   uint8_t sel = req.entry.dword10 & 0x0F;
@@ -1087,9 +1097,11 @@ bool Subsystem::namespaceAttachment(SQEntryWrapper &req,
   debugprint(LOG_HIL_NVME, "ADMIN   | Namespace Attachment | OP %d | NSID %d",
              req.entry.dword10 & 0x0F, req.entry.namespaceID);
 
-  static DMAFunction dmaDone = [this](uint64_t, void *context) {
+  static DMAFunction dmaDone = [](uint64_t, void *context) {
     bool err = false;
-    IOContext *pContext = (IOContext *)context;
+    NamespaceAttachmentContext *pContext =
+        (NamespaceAttachmentContext *)context;
+    auto &lNamespaces = pContext->subsystem->lNamespaces;
     uint16_t *ctrlList = (uint16_t *)pContext->buffer;
     std::vector<uint16_t> list;
 
@@ -1176,7 +1188,8 @@ bool Subsystem::namespaceAttachment(SQEntryWrapper &req,
     pContext->dma->read(0, 0x1000, pContext->buffer, dmaDone, context);
   };
 
-  IOContext *pContext = new IOContext(func, resp);
+  NamespaceAttachmentContext *pContext =
+      new NamespaceAttachmentContext(func, resp, this);
 
   pContext->buffer = (uint8_t *)calloc(0x1000, 1);
   pContext->slba = sel;
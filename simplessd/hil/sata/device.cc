@@ -396,7 +396,7 @@ void Device::_readDMADone(uint64_t tick, void *context) {
 }
 
 void Device::identifyDevice(CommandContext *cmd) {
-  static uint16_t data[256];
+  uint16_t *data = identifyData;
   uint64_t sectors = totalLogicalPages / lbaSize * logicalPageSize;
 
   debugprint(LOG_HIL_SATA, "ATA     | IDENTIFY DEVICE");
@@ -104,6 +104,8 @@ class Device : public StatObject {
   uint32_t logicalPageSize;
   uint32_t lbaSize;
 
+  uint16_t identifyData[256];  //!< DMA source of IDENTIFY DEVICE
+
   ConfigReader &conf;
 
   // Handlers
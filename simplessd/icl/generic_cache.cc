@@ -44,7 +44,10 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
       gen(rd()),
       dist(std::uniform_int_distribution<uint32_t>(0, waySize - 1)) {
   uint64_t cacheSize = conf.readUint(CONFIG_ICL, ICL_CACHE_SIZE);
+  uint64_t core = conf.readUint(CONFIG_CPU, CPU::CPU_CORE_ICL);
 
+  cacheLatency =
+      (core == 0) ? 0 : conf.readUint(CONFIG_ICL, ICL_CACHE_LATENCY) / core;
   lineSize = superPageSize / lineCountInSuperPage;
 
   if (lineSize != superPageSize) {
@@ -213,10 +216,7 @@ GenericCache::~GenericCache() {
 }
 
 uint64_t GenericCache::getCacheLatency() {
-  static uint64_t latency = conf.readUint(CONFIG_ICL, ICL_CACHE_LATENCY);
-  static uint64_t core = conf.readUint(CONFIG_CPU, CPU::CPU_CORE_ICL);
-
-  return (core == 0) ? 0 : latency / core;
+  return cacheLatency;
 }
 
 uint32_t GenericCache::calcSetIndex(uint64_t lca) {
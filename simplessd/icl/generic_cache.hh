@@ -75,6 +75,8 @@ class GenericCache : public AbstractCache {
   std::vector<Line *> cacheData;
   std::vector<Line **> evictData;
 
+  uint64_t cacheLatency;  //!< Metadata access latency per ICL core
+
   uint64_t getCacheLatency();
 
   uint32_t calcSetIndex(uint64_t);
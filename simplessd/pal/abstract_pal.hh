@@ -40,6 +40,7 @@ class AbstractPAL : public StatObject {
   virtual void read(Request &, uint64_t &) = 0;
   virtual void write(Request &, uint64_t &) = 0;
   virtual void erase(Request &, uint64_t &) = 0;
+  virtual void copyback(Request &, Request &, uint64_t &) = 0;
 };
 
 }  // namespace PAL
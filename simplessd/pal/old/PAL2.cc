@@ -395,129 +395,7 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
         InsertFreeSlot(ChFreeSlots[reqCh], latANTI * 2, DMA0tickFrom, tickDMA0,
                        ChStartPoint[reqCh], 1);
         //******************************************************************//
-#if 1
-      // Manage MergedTimeSlots
-      if (MergedTimeSlots.size() == 0) {
-        MergedTimeSlots.push_back(
-            TimeSlot(tsMEM.StartTick, tsMEM.EndTick - tsMEM.StartTick + 1));
-      }
-      else {
-        uint64_t s = tsMEM.StartTick;
-        uint64_t e = tsMEM.EndTick;
-        int spnt = 0, epnt = 0;  // inside(0), rightside(1)
-        std::list<TimeSlot>::iterator cur;
-        std::list<TimeSlot>::iterator spos = MergedTimeSlots.end();
-        std::list<TimeSlot>::iterator epos = MergedTimeSlots.end();
-
-        // find s position
-        cur = MergedTimeSlots.begin();
-
-        while (cur != MergedTimeSlots.end()) {
-          if (cur->StartTick <= s && s <= cur->EndTick) {
-            spos = cur;
-            spnt = 0;  // inside
-            break;
-          }
-
-          auto next = cur;
-
-          next++;
-
-          if ((next == MergedTimeSlots.end()) ||
-              (next != MergedTimeSlots.end() && (s < next->StartTick))) {
-            spos = cur;
-            spnt = 1;  // rightside
-            break;
-          }
-
-          cur = next;
-        }
-
-        // find e position
-        cur = MergedTimeSlots.begin();
-
-        while (cur != MergedTimeSlots.end()) {
-          if (cur->StartTick <= e && e <= cur->EndTick) {
-            epos = cur;
-            epnt = 0;  // inside
-            break;
-          }
-
-          auto next = cur;
-
-          next++;
-
-          if ((next == MergedTimeSlots.end()) ||
-              (next != MergedTimeSlots.end() && (e < next->StartTick))) {
-            epos = cur;
-            epnt = 1;  // rightside
-            break;
-          }
-
-          cur = next;
-        }
-
-        // merge
-        // if both side is in a merged slot, skip
-        if (!(spos != MergedTimeSlots.end() && epos != MergedTimeSlots.end() &&
-              (spos == epos && spnt == 0 && epnt == 0))) {
-          if (spos != MergedTimeSlots.end() &&
-              spnt == 1) {  // right side of spos
-            bool update = false;
-
-            if (spos == epos) {
-              update = true;
-            }
-
-            // duration will be updated later
-            // Insert tmp after spos
-            auto tmp = MergedTimeSlots.insert(
-                ++spos,
-                TimeSlot(tsMEM.StartTick, tsMEM.EndTick - tsMEM.StartTick + 1));
-
-            if (update) {
-              epos = tmp;
-            }
-
-            spos = --tmp;  // update spos
-          }
-          else {
-            if (epos == MergedTimeSlots.end())  // both new
-            {
-              auto tmp =
-                  TimeSlot(tsMEM.StartTick,
-                           tsMEM.EndTick - tsMEM.StartTick + 1);  // copy one
-
-              MergedTimeSlots.insert(MergedTimeSlots.begin(), tmp);
-            }
-            else {
-              auto tmp = TimeSlot(tsMEM.StartTick,
-                                  999);  // duration will be updated later
-              spos = MergedTimeSlots.insert(MergedTimeSlots.begin(), tmp);
-            }
-          }
-
-          if (epos != MergedTimeSlots.end()) {
-            if (epnt == 0) {
-              spos->EndTick = epos->EndTick;
-            }
-            else if (epnt == 1) {
-              spos->EndTick = tsMEM.EndTick;
-            }
-
-            // remove [ spos->Next ~ epos ]
-            auto iter = spos;
-
-            for (iter++; iter != epos;) {
-              iter = MergedTimeSlots.erase(iter);
-            }
-
-            // We need to erase epos
-            MergedTimeSlots.erase(epos);
-          }
-        }
-      }
-#endif  // END MERGE TIMESLOT
+      MergeBusyTime(tsMEM);
     }
 
     // print Log
@@ -587,10 +465,199 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
   }
 }
 
+// Merge die busy period into MergedTimeSlots for gathering busy time
+void PAL2::MergeBusyTime(TimeSlot &tsMEM) {
+  if (MergedTimeSlots.size() == 0) {
+    MergedTimeSlots.push_back(
+        TimeSlot(tsMEM.StartTick, tsMEM.EndTick - tsMEM.StartTick + 1));
+  }
+  else {
+    uint64_t s = tsMEM.StartTick;
+    uint64_t e = tsMEM.EndTick;
+    int spnt = 0, epnt = 0;  // inside(0), rightside(1)
+    std::list<TimeSlot>::iterator cur;
+    std::list<TimeSlot>::iterator spos = MergedTimeSlots.end();
+    std::list<TimeSlot>::iterator epos = MergedTimeSlots.end();
+
+    // find s position
+    cur = MergedTimeSlots.begin();
+
+    while (cur != MergedTimeSlots.end()) {
+      if (cur->StartTick <= s && s <= cur->EndTick) {
+        spos = cur;
+        spnt = 0;  // inside
+        break;
+      }
+
+      auto next = cur;
+
+      next++;
+
+      if ((next == MergedTimeSlots.end()) ||
+          (next != MergedTimeSlots.end() && (s < next->StartTick))) {
+        spos = cur;
+        spnt = 1;  // rightside
+        break;
+      }
+
+      cur = next;
+    }
+
+    // find e position
+    cur = MergedTimeSlots.begin();
+
+    while (cur != MergedTimeSlots.end()) {
+      if (cur->StartTick <= e && e <= cur->EndTick) {
+        epos = cur;
+        epnt = 0;  // inside
+        break;
+      }
+
+      auto next = cur;
+
+      next++;
+
+      if ((next == MergedTimeSlots.end()) ||
+          (next != MergedTimeSlots.end() && (e < next->StartTick))) {
+        epos = cur;
+        epnt = 1;  // rightside
+        break;
+      }
+
+      cur = next;
+    }
+
+    // merge
+    // if both side is in a merged slot, skip
+    if (!(spos != MergedTimeSlots.end() && epos != MergedTimeSlots.end() &&
+          (spos == epos && spnt == 0 && epnt == 0))) {
+      if (spos != MergedTimeSlots.end() &&
+          spnt == 1) {  // right side of spos
+        bool update = false;
+
+        if (spos == epos) {
+          update = true;
+        }
+
+        // duration will be updated later
+        // Insert tmp after spos
+        auto tmp = MergedTimeSlots.insert(
+            ++spos,
+            TimeSlot(tsMEM.StartTick, tsMEM.EndTick - tsMEM.StartTick + 1));
+
+        if (update) {
+          epos = tmp;
+        }
+
+        spos = --tmp;  // update spos
+      }
+      else {
+        if (epos == MergedTimeSlots.end())  // both new
+        {
+          auto tmp =
+              TimeSlot(tsMEM.StartTick,
+                       tsMEM.EndTick - tsMEM.StartTick + 1);  // copy one
+
+          MergedTimeSlots.insert(MergedTimeSlots.begin(), tmp);
+        }
+        else {
+          auto tmp = TimeSlot(tsMEM.StartTick,
+                              999);  // duration will be updated later
+          spos = MergedTimeSlots.insert(MergedTimeSlots.begin(), tmp);
+        }
+      }
+
+      if (epos != MergedTimeSlots.end()) {
+        if (epnt == 0) {
+          spos->EndTick = epos->EndTick;
+        }
+        else if (epnt == 1) {
+          spos->EndTick = tsMEM.EndTick;
+        }
+
+        // remove [ spos->Next ~ epos ]
+        auto iter = spos;
+
+        for (iter++; iter != epos;) {
+          iter = MergedTimeSlots.erase(iter);
+        }
+
+        // We need to erase epos
+        MergedTimeSlots.erase(epos);
+      }
+    }
+  }
+}
+
 void PAL2::submit(Command &cmd, CPDPBP &addr) {
   TimelineScheduling(cmd, addr);
 }
 
+// Copyback moves a page inside its plane through the page register, so the
+// channel only carries the command/address cycles of the read and program
+// commands. Both are charged to the channel up front and the die is held for
+// tR + tPROG without DMA.
+void PAL2::CopybackScheduling(Command &req, CPDPBP &src, CPDPBP &dst) {
+  uint32_t reqCh = dst.Channel;
+  uint32_t reqDieIdx = CPDPBPtoDieIdx(&dst);
+  uint64_t tickCMD = 0, tickMEM = 0;  // start tick of the free slot
+  uint64_t CMDtickFrom, MEMtickFrom;  // starting point
+  uint64_t latCMD, totalLat;
+  bool conflicts;
+
+  latCMD = lat->GetLatency(src.Page, OPER_READ, BUSY_DMA0) * 2;
+  totalLat = latCMD + lat->GetLatency(src.Page, OPER_READ, BUSY_MEM) +
+             lat->GetLatency(dst.Page, OPER_WRITE, BUSY_MEM);
+
+  // Find a point where both channel and die are free
+  CMDtickFrom = req.arrived;
+
+  while (1) {
+    if (!FindFreeTime(ChFreeSlots[reqCh], latCMD, CMDtickFrom, tickCMD,
+                      conflicts)) {
+      if (CMDtickFrom < ChStartPoint[reqCh]) {
+        CMDtickFrom = ChStartPoint[reqCh];
+      }
+      tickCMD = ChStartPoint[reqCh];
+    }
+    else if (conflicts) {
+      CMDtickFrom = tickCMD;
+    }
+
+    MEMtickFrom = CMDtickFrom;
+    if (!FindFreeTime(DieFreeSlots[reqDieIdx], totalLat, MEMtickFrom, tickMEM,
+                      conflicts)) {
+      if (MEMtickFrom < DieStartPoint[reqDieIdx]) {
+        MEMtickFrom = DieStartPoint[reqDieIdx];
+      }
+      tickMEM = DieStartPoint[reqDieIdx];
+    }
+    else if (conflicts) {
+      MEMtickFrom = tickMEM;
+    }
+
+    if (MEMtickFrom == CMDtickFrom) {
+      break;
+    }
+
+    CMDtickFrom = MEMtickFrom;
+  }
+
+  InsertFreeSlot(ChFreeSlots[reqCh], latCMD, CMDtickFrom, tickCMD,
+                 ChStartPoint[reqCh], 0);
+  InsertFreeSlot(DieFreeSlots[reqDieIdx], totalLat, CMDtickFrom, tickMEM,
+                 DieStartPoint[reqDieIdx], 0);
+
+  TimeSlot tsMEM(CMDtickFrom, totalLat);
+
+  MergeBusyTime(tsMEM);
+
+  req.finished = tsMEM.EndTick;
+
+  stats->UpdateLastTick(tsMEM.EndTick);
+  stats->AddCopyback(&src, &dst, latCMD);
+}
+
 void PAL2::FlushATimeSlotBusyTime(std::list<TimeSlot> &tgtTimeSlot,
                                   uint64_t currentTick, uint64_t *TimeSum) {
   auto cur = tgtTimeSlot.begin();
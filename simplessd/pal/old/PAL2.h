@@ -63,6 +63,8 @@ class PAL2  // let's not inherit PAL1
 
   void submit(Command &cmd, CPDPBP &addr);
   void TimelineScheduling(Command &req, CPDPBP &reqCPD);
+  void CopybackScheduling(Command &req, CPDPBP &src, CPDPBP &dst);
+  void MergeBusyTime(TimeSlot &tsMEM);
   void FlushTimeSlots(uint64_t currentTick);
   void FlushOpTimeStamp();
   void FlushATimeSlotBusyTime(std::list<TimeSlot> &tgtTimeSlot,
@@ -235,7 +235,7 @@ void PALStatistics::getEraseBreakdown(Breakdown &value) {
 }
 
 void PALStatistics::getChannelActiveTime(uint32_t c, ActiveTime &stat) {
-  static uint32_t numOfChannel =
+  uint32_t numOfChannel =
       gconf->readUint(SimpleSSD::CONFIG_PAL, SimpleSSD::PAL::PAL_CHANNEL);
 
   if (c < numOfChannel) {
@@ -254,7 +254,7 @@ void PALStatistics::getDieActiveTime(uint32_t d, ActiveTime &stat) {
 }
 
 void PALStatistics::getChannelActiveTimeAll(ActiveTime &stat) {
-  static uint32_t numOfChannel =
+  uint32_t numOfChannel =
       gconf->readUint(SimpleSSD::CONFIG_PAL, SimpleSSD::PAL::PAL_CHANNEL);
   ActiveTime tmp;
 
@@ -614,6 +614,27 @@ uint64_t PALStatistics::GetLastTick() {
   return LastTick;
 }
 
+// Copyback is charged as a cell read of the source page and a cell program of
+// the destination page, plus command cycles on the channel
+void PALStatistics::AddCopyback(CPDPBP *src, CPDPBP *dst, uint64_t latCMD) {
+  uint64_t latRead = lat->GetLatency(src->Page, OPER_READ, BUSY_MEM);
+  uint64_t latWrite = lat->GetLatency(dst->Page, OPER_WRITE, BUSY_MEM);
+
+  // energy = [nW] * [ps] / [10^9] = [pJ]
+  uint64_t energy_cmd =
+      lat->GetPower(OPER_READ, BUSY_DMA0) * latCMD / 1000000000;
+  uint64_t energy_read =
+      lat->GetPower(OPER_READ, BUSY_MEM) * latRead / 1000000000;
+  uint64_t energy_write =
+      lat->GetPower(OPER_WRITE, BUSY_MEM) * latWrite / 1000000000;
+
+  Energy_DMA0.add(OPER_READ, energy_cmd);
+  Energy_MEM.add(OPER_READ, energy_read);
+  Energy_MEM.add(OPER_WRITE, energy_write);
+  Energy_Total.add(OPER_READ, energy_cmd + energy_read);
+  Energy_Total.add(OPER_WRITE, energy_write);
+}
+
 void PALStatistics::MergeSnapshot() {
   if (Ticks_Total_snapshot.size() != 0) {
     std::map<uint64_t, ValueOper *>::iterator e = Ticks_Total_snapshot.end();
@@ -179,6 +179,7 @@ class PALStatistics {
   void AddLatency(Command &CMD, CPDPBP *CPD, uint32_t dieIdx, TimeSlot &DMA0,
                   TimeSlot &MEM, TimeSlot &DMA1);
 #endif
+  void AddCopyback(CPDPBP *src, CPDPBP *dst, uint64_t latCMD);
   void MergeSnapshot();
   uint64_t ExactBusyTime, SampledExactBusyTime;
   uint64_t OpBusyTime[3], LastOpBusyTime[3];  // 0: Read, 1: Write, 2: Erase;
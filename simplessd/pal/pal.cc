@@ -129,8 +129,8 @@ void PAL::erase(Request &req, uint64_t &tick) {
   pPAL->erase(req, tick);
 }
 
-void PAL::copyback(uint32_t, uint32_t, uint32_t, uint64_t &) {
-  panic("Copyback not implemented");
+void PAL::copyback(Request &src, Request &dst, uint64_t &tick) {
+  pPAL->copyback(src, dst, tick);
 }
 
 Parameter *PAL::getInfo() {
@@ -56,7 +56,7 @@ class PAL : public StatObject {
   void read(Request &, uint64_t &);
   void write(Request &, uint64_t &);
   void erase(Request &, uint64_t &);
-  void copyback(uint32_t, uint32_t, uint32_t, uint64_t &);
+  void copyback(Request &, Request &, uint64_t &);
 
   Parameter *getInfo();
 
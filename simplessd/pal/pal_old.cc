@@ -43,6 +43,11 @@ PALOLD::PALOLD(Parameter &p, ConfigReader &c)
 
   memset(&stat, 0, sizeof(stat));
 
+  pageAllocation = conf.getPageAllocationConfig();
+  superblock = conf.getSuperblockConfig();
+  useMultiplaneOP = conf.readBoolean(CONFIG_PAL, NAND_USE_MULTI_PLANE_OP);
+  bRandomTweak = conf.readBoolean(CONFIG_FTL, FTL::FTL_USE_RANDOM_IO_TWEAK);
+
   switch (conf.readInt(CONFIG_PAL, NAND_FLASH_TYPE)) {
     case NAND_SLC:
       lat = new LatencySLC(*pTiming, *pPower);
@@ -73,6 +78,10 @@ PALOLD::PALOLD(Parameter &p, ConfigReader &c)
              " | %10" PRIu64,
              pTiming->erase, pTiming->dma0.erase, pTiming->dma1.erase);
 
+  // Copyback still issues the command cycles of read and program
+  copybackSavedTime = pTiming->dma1.read + pTiming->dma0.write +
+                      pTiming->dma1.write - pTiming->dma0.read;
+
   stats = new PALStatistics(&conf, lat);
   pal = new PAL2(stats, &param, &conf, lat);
 
@@ -156,15 +165,48 @@ void PALOLD::erase(Request &req, uint64_t &tick) {
   tick = finishedAt;
 }
 
+// Move pages on-die without channel transfer. Each page of dst must be in
+// the same plane as the page of src at the same position.
+void PALOLD::copyback(Request &src, Request &dst, uint64_t &tick) {
+  uint64_t finishedAt = tick;
+  ::Command cmd(tick, 0, OPER_WRITE, param.superPageSize);
+  std::vector<::CPDPBP> srcList;
+  std::vector<::CPDPBP> dstList;
+
+  printPPN(src, "CPBK");
+  printPPN(dst, "CPBK");
+
+  convertCPDPBP(src, srcList);
+  convertCPDPBP(dst, dstList);
+
+  if (srcList.size() != dstList.size()) {
+    panic("Copyback source and destination size mismatch");
+  }
+
+  for (uint32_t i = 0; i < srcList.size(); i++) {
+    auto &from = srcList[i];
+    auto &to = dstList[i];
+
+    if (from.Channel != to.Channel || from.Package != to.Package ||
+        from.Die != to.Die || from.Plane != to.Plane) {
+      panic("Copyback across planes");
+    }
+
+    printCPDPBP(from, "CPBK");
+    printCPDPBP(to, "CPBK");
+
+    pal->CopybackScheduling(cmd, from, to);
+    stat.copybackCount++;
+
+    finishedAt = MAX(finishedAt, cmd.finished);
+  }
+
+  tick = finishedAt;
+}
+
 void PALOLD::convertCPDPBP(Request &req, std::vector<::CPDPBP> &list) {
   ::CPDPBP addr;
-  static uint32_t pageAllocation = conf.getPageAllocationConfig();
-  static uint8_t superblock = conf.getSuperblockConfig();
-  static bool useMultiplaneOP =
-      conf.readBoolean(CONFIG_PAL, NAND_USE_MULTI_PLANE_OP);
-  static uint32_t pageInSuperPage = param.pageInSuperPage;
-  static bool bRandomTweak =
-      conf.readBoolean(CONFIG_FTL, FTL::FTL_USE_RANDOM_IO_TWEAK);
+  uint32_t pageInSuperPage = param.pageInSuperPage;
   uint32_t value[4];
   uint32_t *ptr[4];
   uint64_t tmp = req.blockIndex;
@@ -377,6 +419,22 @@ void PALOLD::getStatList(std::vector<Stats> &list, std::string prefix) {
   temp.desc = "Total erase operation bytes";
   list.push_back(temp);
 
+  temp.name = prefix + "copyback.count";
+  temp.desc = "Total copyback operation count";
+  list.push_back(temp);
+
+  temp.name = prefix + "copyback.bytes";
+  temp.desc = "Total copyback operation bytes";
+  list.push_back(temp);
+
+  temp.name = prefix + "channel.saved.bytes";
+  temp.desc = "Channel transfer bytes saved by copyback";
+  list.push_back(temp);
+
+  temp.name = prefix + "channel.saved.time";
+  temp.desc = "Channel busy time saved by copyback (ps)";
+  list.push_back(temp);
+
   /*
   temp.name = prefix + "read.time.dma0.wait";
   temp.desc = "Average dma0 wait time of read";
@@ -495,6 +553,12 @@ void PALOLD::getStatValues(std::vector<double> &values) {
   values.push_back(stat.writeCount * param.pageSize);
   values.push_back(stat.eraseCount * param.pageSize * param.page);
 
+  // Copyback skips data out of read and data in of program
+  values.push_back(stat.copybackCount);
+  values.push_back(stat.copybackCount * param.pageSize);
+  values.push_back(stat.copybackCount * param.pageSize * 2);
+  values.push_back(stat.copybackCount * copybackSavedTime);
+
   //stats->getReadBreakdown(breakdown);
   //values.push_back(breakdown.dma0wait);
   //values.push_back(breakdown.dma0);
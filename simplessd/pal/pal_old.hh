@@ -49,8 +49,17 @@ class PALOLD : public AbstractPAL {
     uint64_t readCount;
     uint64_t writeCount;
     uint64_t eraseCount;
+    uint64_t copybackCount;
   } stat;
 
+  uint64_t copybackSavedTime;  // Channel time of one page not transferred
+
+  // Address conversion
+  uint32_t pageAllocation;
+  uint8_t superblock;
+  bool useMultiplaneOP;
+  bool bRandomTweak;
+
   void convertCPDPBP(Request &, std::vector<::CPDPBP> &);
   void printCPDPBP(::CPDPBP &, const char *);
   void printPPN(Request &, const char *);
@@ -62,6 +71,7 @@ class PALOLD : public AbstractPAL {
   void read(Request &, uint64_t &) override;
   void write(Request &, uint64_t &) override;
   void erase(Request &, uint64_t &) override;
+  void copyback(Request &, Request &, uint64_t &) override;
 
   void getStatList(std::vector<Stats> &, std::string) override;
   void getStatValues(std::vector<double> &) override;
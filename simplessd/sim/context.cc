@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sim/context.hh"
+
+#include "cpu/cpu.hh"
+
+namespace SimpleSSD {
+
+// Context of simulation running on this thread
+thread_local SimulationContext *context = nullptr;
+
+SimulationContext::SimulationContext(Simulator *s, std::ostream *o,
+                                     std::ostream *e)
+    : sim(s), cpu(nullptr), outfile(o), errfile(e) {}
+
+SimulationContext::~SimulationContext() {
+  releaseCPU();
+
+  if (context == this) {
+    context = nullptr;
+  }
+}
+
+void SimulationContext::initCPU(ConfigReader &conf) {
+  releaseCPU();
+
+  cpu = new CPU::CPU(conf);
+}
+
+void SimulationContext::releaseCPU() {
+  delete cpu;
+  cpu = nullptr;
+}
+
+void setContext(SimulationContext *p) {
+  context = p;
+}
+
+SimulationContext *getContext() {
+  return context;
+}
+
+}  // namespace SimpleSSD
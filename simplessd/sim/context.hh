@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __SIM_CONTEXT__
+#define __SIM_CONTEXT__
+
+#include <iostream>
+
+#include "sim/config_reader.hh"
+#include "sim/simulator.hh"
+
+namespace SimpleSSD {
+
+namespace CPU {
+
+class CPU;
+
+}
+
+/**
+ * \brief Per-SSD simulation context
+ *
+ * Holds everything which was process-wide before: simulator (event engine)
+ * interface, CPU model and log streams. Each thread running a simulation
+ * binds its own context with setContext, so several SSDs can be simulated
+ * in one process. Simulator and log streams are not owned.
+ */
+class SimulationContext {
+ private:
+  Simulator *sim;
+  CPU::CPU *cpu;
+  std::ostream *outfile;
+  std::ostream *errfile;
+
+ public:
+  SimulationContext(Simulator *, std::ostream *, std::ostream *);
+  ~SimulationContext();
+
+  void initCPU(ConfigReader &);
+  void releaseCPU();
+
+  Simulator *getSimulator() { return sim; }
+  CPU::CPU *getCPU() { return cpu; }
+  std::ostream *getOutFile() { return outfile; }
+  std::ostream *getErrFile() { return errfile; }
+};
+
+void setContext(SimulationContext *);
+SimulationContext *getContext();
+
+}  // namespace SimpleSSD
+
+#endif
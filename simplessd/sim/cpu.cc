@@ -19,12 +19,19 @@
 
 #include "sim/cpu.hh"
 
+#include "sim/context.hh"
+
 namespace SimpleSSD {
 
 // Defined in sim/cpu.hh
-CPU::CPU *cpu = nullptr;
 DMAFunction cpuHandler = commonCPUHandler;
 
+inline CPU::CPU *getCPU() {
+  SimulationContext *context = getContext();
+
+  return context ? context->getCPU() : nullptr;
+}
+
 CPUContext::_CPUContext(DMAFunction &f, void *c) : func(f), context(c) {}
 
 CPUContext::_CPUContext(DMAFunction &f, void *c, CPU::NAMESPACE n,
@@ -36,37 +43,48 @@ CPUContext::_CPUContext(DMAFunction &f, void *c, CPU::NAMESPACE n,
     : func(f), context(c), ns(n), fct(fc), delay(d) {}
 
 void initCPU(ConfigReader &conf) {
-  if (cpu) {
-    delete cpu;
-  }
+  SimulationContext *context = getContext();
 
-  cpu = new CPU::CPU(conf);
+  if (context) {
+    context->initCPU(conf);
+  }
 }
 
 void deInitCPU() {
-  delete cpu;
-  cpu = nullptr;
+  SimulationContext *context = getContext();
+
+  if (context) {
+    context->releaseCPU();
+  }
 }
 
 void getCPUStatList(std::vector<Stats> &list, std::string prefix) {
+  CPU::CPU *cpu = getCPU();
+
   if (cpu) {
     cpu->getStatList(list, prefix);
   }
 }
 
 void getCPUStatValues(std::vector<double> &values) {
+  CPU::CPU *cpu = getCPU();
+
   if (cpu) {
     cpu->getStatValues(values);
   }
 }
 
 void resetCPUStatValues() {
+  CPU::CPU *cpu = getCPU();
+
   if (cpu) {
     cpu->resetStatValues();
   }
 }
 
 void printCPULastStat() {
+  CPU::CPU *cpu = getCPU();
+
   if (cpu) {
     cpu->printLastStat();
   }
@@ -74,6 +92,8 @@ void printCPULastStat() {
 
 void execute(CPU::NAMESPACE ns, CPU::FUNCTION fct, DMAFunction &func,
              void *context, uint64_t delay) {
+  CPU::CPU *cpu = getCPU();
+
   if (cpu) {
     cpu->execute(ns, fct, func, context, delay);
   }
@@ -89,6 +109,8 @@ void commonCPUHandler(uint64_t, void *context) {
 }
 
 uint64_t applyLatency(CPU::NAMESPACE ns, CPU::FUNCTION fct) {
+  CPU::CPU *cpu = getCPU();
+
   if (cpu) {
     return cpu->applyLatency(ns, fct);
   }
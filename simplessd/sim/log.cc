@@ -17,7 +17,6 @@
  * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "sim/log.hh"
 #include "sim/trace.hh"
 
 #include <cstdarg>
@@ -26,44 +25,40 @@
 #include <string>
 #include <vector>
 
+#include "sim/context.hh"
 #include "util/simplessd.hh"
 
 namespace SimpleSSD {
 
-struct Logger {
-  std::ostream *outfile;
-  std::ostream *errfile;
-
-  Logger(std::ostream *o, std::ostream *e) : outfile(o), errfile(e) {}
-};
-
-Logger *logger = nullptr;
-
 void panic(const char *format, ...) {
-  if (logger) {
-    va_list args, copied;
-    std::vector<char> str;
-
-    va_start(args, format);
-    va_copy(copied, args);
-    str.resize(vsnprintf(nullptr, 0, format, args) + 1);
-    va_end(args);
-    vsnprintf(str.data(), str.size(), format, copied);
-    va_end(copied);
-
-    if (logger->errfile) {
-      *(logger->errfile) << getTick() << ": panic: " << str.data() << std::endl;
-    }
-    else {
-      std::cerr << getTick() << ": panic: " << str.data() << std::endl;
-    }
+  SimulationContext *context = getContext();
+  std::ostream *errfile = context ? context->getErrFile() : nullptr;
+  va_list args, copied;
+  std::vector<char> str;
+
+  va_start(args, format);
+  va_copy(copied, args);
+  str.resize(vsnprintf(nullptr, 0, format, args) + 1);
+  va_end(args);
+  vsnprintf(str.data(), str.size(), format, copied);
+  va_end(copied);
+
+  // Thread without context (ex. trace reader) still reports why it stopped
+  if (errfile) {
+    *errfile << getTick() << ": panic: " << str.data() << std::endl;
+  }
+  else {
+    std::cerr << getTick() << ": panic: " << str.data() << std::endl;
   }
 
   std::terminate();
 }
 
 void warn(const char *format, ...) {
-  if (logger && logger->errfile) {
+  SimulationContext *context = getContext();
+  std::ostream *errfile = context ? context->getErrFile() : &std::cerr;
+
+  if (errfile) {
     va_list args, copied;
     std::vector<char> str;
 
@@ -74,12 +69,14 @@ void warn(const char *format, ...) {
     vsnprintf(str.data(), str.size(), format, copied);
     va_end(copied);
 
-    *(logger->errfile) << getTick() << ": warn: " << str.data() << std::endl;
+    *errfile << getTick() << ": warn: " << str.data() << std::endl;
   }
 }
 
 void info(const char *format, ...) {
-  if (logger && logger->errfile) {
+  SimulationContext *context = getContext();
+
+  if (context && context->getErrFile()) {
     va_list args, copied;
     std::vector<char> str;
 
@@ -90,7 +87,8 @@ void info(const char *format, ...) {
     vsnprintf(str.data(), str.size(), format, copied);
     va_end(copied);
 
-    *(logger->errfile) << getTick() << ": info: " << str.data() << std::endl;
+    *(context->getErrFile())
+        << getTick() << ": info: " << str.data() << std::endl;
   }
 }
 
@@ -110,7 +108,9 @@ const std::string logName[LOG_NUM] = {
 };
 
 void debugprint(LOG_ID id, const char *format, ...) {
-  if (logger && logger->outfile && id < LOG_NUM) {
+  SimulationContext *context = getContext();
+
+  if (context && context->getOutFile() && id < LOG_NUM) {
     va_list args, copied;
     std::vector<char> str;
 
@@ -121,30 +121,23 @@ void debugprint(LOG_ID id, const char *format, ...) {
     vsnprintf(str.data(), str.size(), format, copied);
     va_end(copied);
 
-    *(logger->outfile) << getTick() << ": " << logName[id] << ": " << str.data()
-                       << std::endl;
+    *(context->getOutFile())
+        << getTick() << ": " << logName[id] << ": " << str.data() << std::endl;
   }
 }
 
 void debugprint(LOG_ID id, const uint8_t *buffer, uint64_t size) {
-  if (logger && logger->outfile && id < LOG_NUM) {
+  SimulationContext *context = getContext();
+
+  if (context && context->getOutFile() && id < LOG_NUM) {
+    std::ostream *outfile = context->getOutFile();
     uint32_t temp;
 
     temp = id;
-    logger->outfile->write((char *)&temp, 4);
-    logger->outfile->write((char *)&size, 8);
-    logger->outfile->write((const char *)buffer, size);
+    outfile->write((char *)&temp, 4);
+    outfile->write((char *)&size, 8);
+    outfile->write((const char *)buffer, size);
   }
 }
 
-void initLogSystem(std::ostream *out, std::ostream *err) {
-  destroyLogSystem();
-
-  logger = new Logger(out, err);
-}
-
-void destroyLogSystem() {
-  delete logger;
-}
-
 }  // namespace SimpleSSD
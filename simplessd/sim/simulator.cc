@@ -19,16 +19,19 @@
 
 #include "sim/simulator.hh"
 
+#include "sim/context.hh"
+
 namespace SimpleSSD {
 
-// Defined in sim/simulator.hh
-Simulator *sim = nullptr;
+inline Simulator *getSimulator() {
+  SimulationContext *context = getContext();
 
-void setSimulator(Simulator *p) {
-  sim = p;
+  return context ? context->getSimulator() : nullptr;
 }
 
 uint64_t getTick() {
+  Simulator *sim = getSimulator();
+
   if (sim) {
     return sim->getCurrentTick();
   }
@@ -37,6 +40,8 @@ uint64_t getTick() {
 }
 
 Event allocate(EventFunction f) {
+  Simulator *sim = getSimulator();
+
   if (sim) {
     return sim->allocateEvent(f);
   }
@@ -45,18 +50,24 @@ Event allocate(EventFunction f) {
 }
 
 void schedule(Event e, uint64_t t) {
+  Simulator *sim = getSimulator();
+
   if (sim) {
     sim->scheduleEvent(e, t);
   }
 }
 
 void deschedule(Event e) {
+  Simulator *sim = getSimulator();
+
   if (sim) {
     sim->descheduleEvent(e);
   }
 }
 
 bool scheduled(Event e, uint64_t *p) {
+  Simulator *sim = getSimulator();
+
   if (sim) {
     return sim->isScheduled(e, p);
   }
@@ -65,6 +76,8 @@ bool scheduled(Event e, uint64_t *p) {
 }
 
 void deallocate(Event e) {
+  Simulator *sim = getSimulator();
+
   if (sim) {
     sim->deallocateEvent(e);
   }
@@ -46,7 +46,6 @@ class Simulator {
   virtual void deallocateEvent(Event) = 0;
 };
 
-void setSimulator(Simulator *p);
 uint64_t getTick();
 Event allocate(EventFunction f);
 void schedule(Event e, uint64_t t);
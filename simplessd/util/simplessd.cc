@@ -19,16 +19,14 @@
 
 #include "util/simplessd.hh"
 
-#include "sim/log.hh"
-
 using namespace SimpleSSD;
 
 ConfigReader initSimpleSSDEngine(Simulator *sim, std::ostream *info,
                                  std::ostream *err, std::string config) {
   ConfigReader conf;
 
-  setSimulator(sim);
-  initLogSystem(info, err);
+  // Context of this thread, owned until releaseSimpleSSDEngine
+  setContext(new SimulationContext(sim, info, err));
 
   if (!conf.init(config)) {
     panic("Failed to open configuration file %s", config.c_str());
@@ -42,5 +40,5 @@ ConfigReader initSimpleSSDEngine(Simulator *sim, std::ostream *info,
 void releaseSimpleSSDEngine() {
   printCPULastStat();
 
-  deInitCPU();
+  delete getContext();
 }
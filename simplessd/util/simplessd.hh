@@ -23,6 +23,7 @@
 #define __UTIL_SIMPLESSD__
 
 #include "sim/config_reader.hh"
+#include "sim/context.hh"
 #include "sim/cpu.hh"
 #include "sim/simulator.hh"
 #include "sim/statistics.hh"
@@ -19,10 +19,17 @@
 
 #include "util/convert.hh"
 
+#include <cstring>
 #include <regex>
 
 #include "simplessd/sim/trace.hh"
 
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h>
+#endif
+
 const std::regex regexInteger("(\\d+)([kKmMgGtTpP]?)",
                               std::regex_constants::ECMAScript);
 const std::regex regexTime("(\\d+)([munp]?s?)",
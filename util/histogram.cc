@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "util/histogram.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#define HISTOGRAM_MAGIC "SSDHIST"
+#define HISTOGRAM_VERSION 1
+
+Histogram::Histogram() : bucket(HISTOGRAM_BUCKETS, 0) {
+  reset();
+}
+
+uint64_t Histogram::getValue(uint32_t index) {
+  if (index < (HISTOGRAM_HALF_BUCKET << 1)) {
+    return index;
+  }
+
+  uint64_t shift = index / HISTOGRAM_HALF_BUCKET - 1;
+  uint64_t base = index - shift * HISTOGRAM_HALF_BUCKET;
+
+  // Highest value which falls into this bucket
+  return ((base + 1) << shift) - 1;
+}
+
+void Histogram::merge(const Histogram &rhs) {
+  if (rhs.count == 0) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    bucket[i] += rhs.bucket[i];
+  }
+
+  count += rhs.count;
+  sum += rhs.sum;
+
+  if (minValue > rhs.minValue) {
+    minValue = rhs.minValue;
+  }
+  if (maxValue < rhs.maxValue) {
+    maxValue = rhs.maxValue;
+  }
+}
+
+void Histogram::reset() {
+  if (count > 0) {
+    std::fill(bucket.begin(), bucket.end(), 0);
+  }
+
+  count = 0;
+  minValue = std::numeric_limits<uint64_t>::max();
+  maxValue = 0;
+  sum = 0.0;
+}
+
+uint64_t Histogram::getCount() const {
+  return count;
+}
+
+uint64_t Histogram::getMin() const {
+  return count > 0 ? minValue : 0;
+}
+
+uint64_t Histogram::getMax() const {
+  return maxValue;
+}
+
+double Histogram::getMean() const {
+  return count > 0 ? sum / count : 0.0;
+}
+
+uint64_t Histogram::getPercentile(double percentile) const {
+  uint64_t target = (uint64_t)ceil(percentile / 100.0 * count);
+  uint64_t acc = 0;
+
+  if (count == 0) {
+    return 0;
+  }
+  if (target == 0) {
+    target = 1;
+  }
+
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    acc += bucket[i];
+
+    if (acc >= target) {
+      uint64_t value = getValue(i);
+
+      return value < maxValue ? value : maxValue;
+    }
+  }
+
+  return maxValue;
+}
+
+void Histogram::save(std::ostream &out) const {
+  uint32_t nonzero = 0;
+
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    if (bucket[i] > 0) {
+      nonzero++;
+    }
+  }
+
+  out.write((const char *)&count, sizeof(count));
+  out.write((const char *)&minValue, sizeof(minValue));
+  out.write((const char *)&maxValue, sizeof(maxValue));
+  out.write((const char *)&sum, sizeof(sum));
+  out.write((const char *)&nonzero, sizeof(nonzero));
+
+  // Only non-empty buckets are stored
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    if (bucket[i] > 0) {
+      out.write((const char *)&i, sizeof(i));
+      out.write((const char *)&bucket[i], sizeof(bucket[i]));
+    }
+  }
+}
+
+bool Histogram::load(std::istream &in) {
+  uint32_t nonzero = 0;
+  uint32_t index;
+  uint64_t value;
+
+  count = 1;  // Force clear of bucket
+  reset();
+
+  in.read((char *)&count, sizeof(count));
+  in.read((char *)&minValue, sizeof(minValue));
+  in.read((char *)&maxValue, sizeof(maxValue));
+  in.read((char *)&sum, sizeof(sum));
+  in.read((char *)&nonzero, sizeof(nonzero));
+
+  for (uint32_t i = 0; i < nonzero && in.good(); i++) {
+    in.read((char *)&index, sizeof(index));
+    in.read((char *)&value, sizeof(value));
+
+    if (index >= HISTOGRAM_BUCKETS) {
+      return false;
+    }
+
+    bucket[index] = value;
+  }
+
+  return in.good();
+}
+
+bool saveHistograms(std::ostream &out, const std::vector<std::string> &names,
+                    const std::vector<const Histogram *> &list) {
+  char magic[8];
+  uint32_t value;
+
+  if (names.size() != list.size()) {
+    return false;
+  }
+
+  memset(magic, 0, 8);
+  memcpy(magic, HISTOGRAM_MAGIC, strlen(HISTOGRAM_MAGIC));
+
+  out.write(magic, 8);
+
+  value = HISTOGRAM_VERSION;
+  out.write((const char *)&value, sizeof(value));
+
+  value = HISTOGRAM_SUB_BUCKET_BITS;
+  out.write((const char *)&value, sizeof(value));
+
+  value = (uint32_t)list.size();
+  out.write((const char *)&value, sizeof(value));
+
+  for (uint32_t i = 0; i < list.size(); i++) {
+    value = (uint32_t)names[i].length();
+
+    out.write((const char *)&value, sizeof(value));
+    out.write(names[i].c_str(), value);
+
+    list[i]->save(out);
+  }
+
+  return out.good();
+}
+
+bool loadHistograms(std::istream &in, std::vector<std::string> &names,
+                    std::vector<Histogram> &list) {
+  char magic[8];
+  uint32_t version = 0;
+  uint32_t bits = 0;
+  uint32_t number = 0;
+
+  in.read(magic, 8);
+  in.read((char *)&version, sizeof(version));
+  in.read((char *)&bits, sizeof(bits));
+  in.read((char *)&number, sizeof(number));
+
+  if (!in.good() || memcmp(magic, HISTOGRAM_MAGIC, 8) != 0 ||
+      version != HISTOGRAM_VERSION || bits != HISTOGRAM_SUB_BUCKET_BITS) {
+    return false;
+  }
+
+  names.resize(number);
+  list.resize(number);
+
+  for (uint32_t i = 0; i < number; i++) {
+    uint32_t length = 0;
+
+    in.read((char *)&length, sizeof(length));
+
+    if (!in.good()) {
+      return false;
+    }
+
+    names[i].resize(length);
+    in.read(&names[i][0], length);
+
+    if (!list[i].load(in)) {
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __UTIL_HISTOGRAM__
+#define __UTIL_HISTOGRAM__
+
+#include <cinttypes>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Log-linear histogram, similar to HdrHistogram
+// Values below 2^SUB_BUCKET_BITS are recorded exactly. Above that, each power
+// of two is divided into 2^(SUB_BUCKET_BITS - 1) linear buckets, so relative
+// error of reported value is below 2^-(SUB_BUCKET_BITS - 1).
+#define HISTOGRAM_SUB_BUCKET_BITS 8
+#define HISTOGRAM_HALF_BUCKET (1ull << (HISTOGRAM_SUB_BUCKET_BITS - 1))
+#define HISTOGRAM_BUCKETS \
+  ((65 - HISTOGRAM_SUB_BUCKET_BITS) * HISTOGRAM_HALF_BUCKET + \
+   HISTOGRAM_HALF_BUCKET)
+
+class Histogram {
+ private:
+  std::vector<uint64_t> bucket;
+
+  uint64_t count;
+  uint64_t minValue;
+  uint64_t maxValue;
+  double sum;
+
+  static inline uint32_t getIndex(uint64_t value) {
+    if (value < (HISTOGRAM_HALF_BUCKET << 1)) {
+      return (uint32_t)value;
+    }
+
+#ifdef _MSC_VER
+    unsigned long msb;
+
+    _BitScanReverse64(&msb, value);
+#else
+    uint32_t msb = 63 - __builtin_clzll(value);
+#endif
+    uint32_t shift = msb - (HISTOGRAM_SUB_BUCKET_BITS - 1);
+
+    return (uint32_t)(shift * HISTOGRAM_HALF_BUCKET + (value >> shift));
+  }
+
+  static uint64_t getValue(uint32_t);
+
+ public:
+  Histogram();
+
+  inline void record(uint64_t value) {
+    bucket[getIndex(value)]++;
+    count++;
+    sum += value;
+
+    if (minValue > value) {
+      minValue = value;
+    }
+    if (maxValue < value) {
+      maxValue = value;
+    }
+  }
+
+  void merge(const Histogram &);
+  void reset();
+
+  uint64_t getCount() const;
+  uint64_t getMin() const;
+  uint64_t getMax() const;
+  double getMean() const;
+  uint64_t getPercentile(double) const;
+
+  void save(std::ostream &) const;
+  bool load(std::istream &);
+};
+
+// Binary histogram file, which contains named histograms
+bool saveHistograms(std::ostream &, const std::vector<std::string> &,
+                    const std::vector<const Histogram *> &);
+bool loadHistograms(std::istream &, std::vector<std::string> &,
+                    std::vector<Histogram> &);
+
+#endif